@@ -0,0 +1,125 @@
+//
+// CameraFrameSource - 实现
+//
+
+#include "camera_frame_source.h"
+#include <QCameraInfo>
+#include <QCameraViewfinderSettings>
+#include <QDebug>
+#include <utility>
+
+// ==================== CaptureSurface ====================
+
+CaptureSurface::CaptureSurface(CameraFrameSource* owner)
+    : QAbstractVideoSurface(owner),
+    source(owner) {
+}
+
+QList<QVideoFrame::PixelFormat> CaptureSurface::supportedPixelFormats(
+    QAbstractVideoBuffer::HandleType type) const {
+    if (type != QAbstractVideoBuffer::NoHandle) {
+        return QList<QVideoFrame::PixelFormat>();
+    }
+    // 优先能直接包成 QImage 的格式
+    return QList<QVideoFrame::PixelFormat>()
+           << QVideoFrame::Format_RGB32
+           << QVideoFrame::Format_ARGB32
+           << QVideoFrame::Format_RGB24
+           << QVideoFrame::Format_RGB565;
+}
+
+bool CaptureSurface::present(const QVideoFrame& frame) {
+    source->handleFrame(frame);
+    return true;
+}
+
+// ==================== CameraFrameSource ====================
+
+CameraFrameSource::CameraFrameSource(bool front, QObject* parent)
+    : FrameSource(parent),
+    frontFacing(front),
+    camera(nullptr) {
+
+    // 按朝向选相机，没有对应朝向时用默认相机
+    QCameraInfo chosen = QCameraInfo::defaultCamera();
+    QCamera::Position wanted = front ? QCamera::FrontFace : QCamera::BackFace;
+    for (const QCameraInfo& info : QCameraInfo::availableCameras()) {
+        if (info.position() == wanted) {
+            chosen = info;
+            break;
+        }
+    }
+
+    surface = new CaptureSurface(this);
+    if (!chosen.isNull()) {
+        camera = new QCamera(chosen, this);
+        camera->setCaptureMode(QCamera::CaptureVideo);
+        camera->setViewfinder(surface);
+        connect(camera, QOverload<QCamera::Error>::of(&QCamera::error),
+                this, &CameraFrameSource::onCameraError);
+        qDebug() << "CameraFrameSource using" << chosen.description();
+    }
+}
+
+CameraFrameSource::~CameraFrameSource() {
+    stop();
+}
+
+QString CameraFrameSource::name() const {
+    return frontFacing ? "Front camera" : "Back camera";
+}
+
+bool CameraFrameSource::start(const QSize& size, int framesPerSecond) {
+    if (!camera) {
+        emit error(tr("No camera available"));
+        return false;
+    }
+
+    frameSize = size;
+
+    QCameraViewfinderSettings settings;
+    settings.setResolution(size);
+    settings.setMaximumFrameRate(framesPerSecond);
+    camera->setViewfinderSettings(settings);
+
+    clock.start();
+    camera->start();
+    return true;
+}
+
+void CameraFrameSource::stop() {
+    if (camera) {
+        camera->stop();
+    }
+}
+
+void CameraFrameSource::handleFrame(const QVideoFrame& frame) {
+    QVideoFrame mapped(frame);
+    if (!mapped.map(QAbstractVideoBuffer::ReadOnly)) return;
+
+    QImage::Format format = QVideoFrame::imageFormatFromPixelFormat(mapped.pixelFormat());
+    if (format == QImage::Format_Invalid) {
+        mapped.unmap();
+        return;
+    }
+
+    // 包装相机缓冲区，转换为 RGB32 时完成唯一一次拷贝
+    QImage wrapped(mapped.bits(), mapped.width(), mapped.height(), mapped.bytesPerLine(), format);
+    QImage image = wrapped.convertToFormat(QImage::Format_RGB32);
+    if (image.constBits() == wrapped.constBits()) {
+        image = wrapped.copy();
+    }
+    mapped.unmap();
+
+    // 前置相机画面按惯例镜像（右值版本原地翻转，不再分配）
+    if (frontFacing) {
+        image = std::move(image).mirrored(true, false);
+    }
+
+    deliver(std::move(image), clock.nsecsElapsed() / 1000);
+}
+
+void CameraFrameSource::onCameraError(QCamera::Error cameraError) {
+    qDebug() << "Camera error:" << cameraError << camera->errorString();
+    emit error(camera->errorString());
+}
@@ -0,0 +1,57 @@
+//
+// CameraFrameSource - 相机帧来源
+// Iteration 4: QCamera 的取景帧通过自定义视频表面取出，转换为 RGB32 的 QImage；
+//              相机缓冲区只在 present() 期间有效，这里是唯一一次拷贝
+//
+
+#ifndef CAMERA_FRAME_SOURCE_H
+#define CAMERA_FRAME_SOURCE_H
+
+#include "frame_source.h"
+#include <QAbstractVideoSurface>
+#include <QCamera>
+#include <QElapsedTimer>
+
+class CameraFrameSource;
+
+// 接收相机帧的视频表面
+class CaptureSurface : public QAbstractVideoSurface {
+    Q_OBJECT
+
+private:
+    CameraFrameSource* source;
+
+public:
+    explicit CaptureSurface(CameraFrameSource* source);
+
+    QList<QVideoFrame::PixelFormat> supportedPixelFormats(
+        QAbstractVideoBuffer::HandleType type = QAbstractVideoBuffer::NoHandle) const override;
+    bool present(const QVideoFrame& frame) override;
+};
+
+class CameraFrameSource : public FrameSource {
+    Q_OBJECT
+
+private:
+    bool frontFacing;
+    QCamera* camera;
+    CaptureSurface* surface;
+    QSize frameSize;
+    QElapsedTimer clock;
+
+    friend class CaptureSurface;
+    void handleFrame(const QVideoFrame& frame);
+
+private slots:
+    void onCameraError(QCamera::Error error);
+
+public:
+    explicit CameraFrameSource(bool frontFacing, QObject* parent = nullptr);
+    ~CameraFrameSource();
+
+    QString name() const override;
+    bool start(const QSize& size, int framesPerSecond) override;
+    void stop() override;
+};
+
+#endif // CAMERA_FRAME_SOURCE_H
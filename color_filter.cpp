@@ -0,0 +1,621 @@
+//
+// ColorFilter - 实现
+//
+
+#include "color_filter.h"
+#include "color_filter_kernels.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QPair>
+#include <QSettings>
+#include <QTextStream>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLOR_FILTER_SSE2
+#include <emmintrin.h>
+#endif
+
+// AVX2 内核由 tomeo.pro 的 AVX2_SOURCES 单独编译，编译器支持时 Qt 会定义这个宏
+#if defined(QT_COMPILER_SUPPORTS_AVX2)
+#define COLOR_FILTER_AVX2
+#if defined(Q_CC_MSVC)
+#include <intrin.h>
+#endif
+#endif
+
+static const char* BenchmarkFlag = "--benchmark-filters";
+
+static const char* PresetKeys[] = { "original", "warm", "cool", "mono", "vivid", "fade", "custom" };
+static const int PresetKeyCount = 7;
+
+ColorFilter::ColorFilter()
+    : preset(Original),
+    exposure(0.0f),
+    contrast(1.0f),
+    gainQ9(512),
+    offset(0),
+    lutSize(0),
+    lutSeparable(false),
+    kernel(bestKernel()) {
+}
+
+ColorFilter ColorFilter::load() {
+    QSettings settings("Tomeo", "RecordSettings");
+    ColorFilter filter;
+    filter.setExposure(settings.value("filterExposure", 0.0).toFloat());
+    filter.setContrast(settings.value("filterContrast", 1.0).toFloat());
+
+    QString key = settings.value("filterPreset", "original").toString();
+    QString cubePath = settings.value("customLut").toString();
+    if (key == "custom") {
+        if (!filter.loadCubeFile(cubePath)) {
+            filter.setPreset(Original);
+        }
+    } else {
+        for (int i = 0; i < PresetKeyCount; i++) {
+            if (key == PresetKeys[i] && Preset(i) != Custom) {
+                filter.setPreset(Preset(i));
+            }
+        }
+        filter.customLutPath = cubePath;
+    }
+    return filter;
+}
+
+void ColorFilter::save() const {
+    QSettings settings("Tomeo", "RecordSettings");
+    settings.setValue("filterPreset", PresetKeys[preset]);
+    settings.setValue("filterExposure", exposure);
+    settings.setValue("filterContrast", contrast);
+    if (!customLutPath.isEmpty()) {
+        settings.setValue("customLut", customLutPath);
+    }
+}
+
+QString ColorFilter::presetName(Preset preset) {
+    switch (preset) {
+    case Original: return QCoreApplication::translate("ColorFilter", "Original");
+    case Warm: return QCoreApplication::translate("ColorFilter", "Warm");
+    case Cool: return QCoreApplication::translate("ColorFilter", "Cool");
+    case Mono: return QCoreApplication::translate("ColorFilter", "Mono");
+    case Vivid: return QCoreApplication::translate("ColorFilter", "Vivid");
+    case Fade: return QCoreApplication::translate("ColorFilter", "Fade");
+    case Custom: return QCoreApplication::translate("ColorFilter", "Custom LUT");
+    }
+    return QString();
+}
+
+QString ColorFilter::kernelName(Kernel kernel) {
+    switch (kernel) {
+    case Scalar: return "scalar";
+    case Sse2: return "SSE2";
+    case Avx2: return "AVX2";
+    }
+    return QString();
+}
+
+#ifdef COLOR_FILTER_AVX2
+static bool cpuHasAvx2() {
+#if defined(Q_CC_GNU)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(Q_CC_MSVC)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5));
+#else
+    return false;
+#endif
+}
+#endif
+
+QList<ColorFilter::Kernel> ColorFilter::availableKernels() {
+    QList<Kernel> kernels;
+    kernels << Scalar;
+#ifdef COLOR_FILTER_SSE2
+    kernels << Sse2;
+#endif
+#ifdef COLOR_FILTER_AVX2
+    static const bool avx2 = cpuHasAvx2();
+    if (avx2) kernels << Avx2;
+#endif
+    return kernels;
+}
+
+ColorFilter::Kernel ColorFilter::bestKernel() {
+    return availableKernels().last();
+}
+
+void ColorFilter::setExposure(float stops) {
+    exposure = qBound(-2.0f, stops, 2.0f);
+    updateAffine();
+}
+
+void ColorFilter::setContrast(float value) {
+    contrast = qBound(0.5f, value, 1.5f);
+    updateAffine();
+}
+
+// (in * 2^exposure - 128) * contrast + 128，合并成一次乘加
+void ColorFilter::updateAffine() {
+    float gain = std::pow(2.0f, exposure) * contrast;
+    gainQ9 = int(std::lround(gain * 512.0f));
+    offset = int(std::lround(128.0f * (1.0f - contrast)));
+    updateCurves();
+}
+
+bool ColorFilter::isSeparable(const QVector<quint32>& table, int size) {
+    const int strideG = size;
+    const int strideB = size * size;
+    int i = 0;
+    for (int bi = 0; bi < size; bi++) {
+        for (int gi = 0; gi < size; gi++) {
+            for (int ri = 0; ri < size; ri++, i++) {
+                QRgb p = table.at(i);
+                if (qRed(p) != qRed(table.at(ri)) || qGreen(p) != qGreen(table.at(gi * strideG)) ||
+                    qBlue(p) != qBlue(table.at(bi * strideB))) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// 可分离的 LUT 沿另外两个轴插值时两端相等，三线性插值退化为单轴插值；
+// 按同样的取整算出每个输入值的结果，与 3D 内核逐位一致
+void ColorFilter::updateCurves() {
+    curves.clear();
+    if (lut.isEmpty() || !lutSeparable) return;
+
+    curves.resize(3 * 256);
+    quint8* red = curves.data();
+    quint8* green = red + 256;
+    quint8* blue = green + 256;
+    const int strideG = lutSize;
+    const int strideB = lutSize * lutSize;
+
+    for (int v = 0; v < 256; v++) {
+        int index, fraction;
+        colorLutPosition(colorAffineValue(v, gainQ9, offset), lutSize, index, fraction);
+        int inverse = 256 - fraction;
+        red[v] = quint8((qRed(lut.at(index)) * inverse + qRed(lut.at(index + 1)) * fraction) >> 8);
+        green[v] = quint8((qGreen(lut.at(index * strideG)) * inverse +
+                           qGreen(lut.at((index + 1) * strideG)) * fraction) >> 8);
+        blue[v] = quint8((qBlue(lut.at(index * strideB)) * inverse +
+                          qBlue(lut.at((index + 1) * strideB)) * fraction) >> 8);
+    }
+}
+
+bool ColorFilter::isIdentity() const {
+    return lut.isEmpty() && gainQ9 == 512 && offset == 0;
+}
+
+void ColorFilter::setPreset(Preset newPreset) {
+    if (newPreset == Custom) {
+        loadCubeFile(customLutPath);
+        return;
+    }
+    preset = newPreset;
+    buildPresetLut();
+}
+
+static inline float clamp01(float value) {
+    return value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+}
+
+// 预设在 17^3 网格上采样生成，三线性插值后与逐像素计算的差异不到 1 级
+void ColorFilter::buildPresetLut() {
+    if (preset == Original) {
+        lut.clear();
+        lutSize = 0;
+        lutSeparable = false;
+        updateCurves();
+        return;
+    }
+
+    lutSize = PresetLutSize;
+    lut.resize(lutSize * lutSize * lutSize);
+    float step = 1.0f / (lutSize - 1);
+
+    int i = 0;
+    for (int bi = 0; bi < lutSize; bi++) {
+        for (int gi = 0; gi < lutSize; gi++) {
+            for (int ri = 0; ri < lutSize; ri++, i++) {
+                float r = ri * step, g = gi * step, b = bi * step;
+                float luma = 0.299f * r + 0.587f * g + 0.114f * b;
+
+                switch (preset) {
+                case Warm:
+                    r = r * 1.06f + 0.03f;
+                    g = g * 1.01f + 0.01f;
+                    b = b * 0.88f;
+                    break;
+                case Cool:
+                    r = r * 0.90f;
+                    g = g * 1.00f + 0.01f;
+                    b = b * 1.06f + 0.04f;
+                    break;
+                case Mono:
+                    r = g = b = luma;
+                    break;
+                case Vivid: {
+                    // 提高饱和度，再混入一半 S 曲线
+                    float channels[3] = { r, g, b };
+                    for (float& c : channels) {
+                        c = clamp01(luma + (c - luma) * 1.4f);
+                        c = 0.5f * c + 0.5f * c * c * (3.0f - 2.0f * c);
+                    }
+                    r = channels[0]; g = channels[1]; b = channels[2];
+                    break;
+                }
+                case Fade:
+                    // 降饱和、抬黑位、压白位
+                    r = 0.08f + (luma + (r - luma) * 0.75f) * 0.84f;
+                    g = 0.08f + (luma + (g - luma) * 0.75f) * 0.84f;
+                    b = 0.08f + (luma + (b - luma) * 0.75f) * 0.84f;
+                    break;
+                default:
+                    break;
+                }
+
+                lut[i] = qRgb(int(clamp01(r) * 255.0f + 0.5f),
+                              int(clamp01(g) * 255.0f + 0.5f),
+                              int(clamp01(b) * 255.0f + 0.5f));
+            }
+        }
+    }
+
+    lutSeparable = isSeparable(lut, lutSize);
+    updateCurves();
+}
+
+// Adobe/Resolve .cube 格式：LUT_3D_SIZE N 后跟 N^3 行 "r g b"，r 变化最快
+bool ColorFilter::loadCubeFile(const QString& path) {
+    QFile file(path);
+    if (path.isEmpty() || !file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    int size = 0;
+    float domainMin[3] = { 0.0f, 0.0f, 0.0f };
+    float domainMax[3] = { 1.0f, 1.0f, 1.0f };
+    QVector<quint32> table;
+
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        QString line = in.readLine().simplified();
+        if (line.isEmpty() || line.startsWith('#') || line.startsWith("TITLE")) continue;
+
+        QStringList parts = line.split(' ');
+        if (parts[0] == "LUT_3D_SIZE" && parts.size() == 2) {
+            size = parts[1].toInt();
+            if (size < 2 || size > 65) break;
+            table.reserve(size * size * size);
+        } else if ((parts[0] == "DOMAIN_MIN" || parts[0] == "DOMAIN_MAX") && parts.size() == 4) {
+            float* target = parts[0] == "DOMAIN_MIN" ? domainMin : domainMax;
+            for (int c = 0; c < 3; c++) target[c] = parts[c + 1].toFloat();
+        } else if (parts.size() == 3 && size > 0) {
+            int rgb[3];
+            for (int c = 0; c < 3; c++) {
+                float range = qMax(1e-6f, domainMax[c] - domainMin[c]);
+                float value = (parts[c].toFloat() - domainMin[c]) / range;
+                rgb[c] = int(clamp01(value) * 255.0f + 0.5f);
+            }
+            table.append(qRgb(rgb[0], rgb[1], rgb[2]));
+        }
+    }
+
+    if (size < 2 || size > 65 || table.size() != size * size * size) {
+        qDebug() << "ColorFilter: invalid .cube file" << path;
+        return false;
+    }
+
+    lut = table;
+    lutSize = size;
+    lutSeparable = isSeparable(lut, lutSize);
+    preset = Custom;
+    customLutPath = path;
+    updateCurves();
+    qDebug() << "ColorFilter: loaded" << size << "^3 LUT from" << path
+             << (lutSeparable ? "(separable, using 1D curves)" : "");
+    return true;
+}
+
+// ==================== 内核 ====================
+
+void colorAffineScalar(quint32* pixels, int count, int gainQ9, int offset) {
+    // 每次调用先建 256 项的表，和 SIMD 版本的取整方式完全一致
+    quint8 table[256];
+    for (int v = 0; v < 256; v++) {
+        table[v] = quint8(colorAffineValue(v, gainQ9, offset));
+    }
+    for (int x = 0; x < count; x++) {
+        quint32 p = pixels[x];
+        pixels[x] = 0xFF000000u |
+                    (quint32(table[(p >> 16) & 0xFF]) << 16) |
+                    (quint32(table[(p >> 8) & 0xFF]) << 8) |
+                    table[p & 0xFF];
+    }
+}
+
+void colorCurvesScalar(quint32* pixels, int count, const quint8* curves) {
+    const quint8* red = curves;
+    const quint8* green = curves + 256;
+    const quint8* blue = curves + 512;
+    for (int x = 0; x < count; x++) {
+        quint32 p = pixels[x];
+        pixels[x] = 0xFF000000u |
+                    (quint32(red[(p >> 16) & 0xFF]) << 16) |
+                    (quint32(green[(p >> 8) & 0xFF]) << 8) |
+                    blue[p & 0xFF];
+    }
+}
+
+void colorLutScalar(quint32* pixels, int count, const quint32* lut, int size) {
+    const int strideG = size;
+    const int strideB = size * size;
+
+    for (int x = 0; x < count; x++) {
+        quint32 p = pixels[x];
+        int ri, gi, bi, fr, fg, fb;
+        colorLutPosition((p >> 16) & 0xFF, size, ri, fr);
+        colorLutPosition((p >> 8) & 0xFF, size, gi, fg);
+        colorLutPosition(p & 0xFF, size, bi, fb);
+
+        const quint32* cell = lut + bi * strideB + gi * strideG + ri;
+        quint32 c00 = colorLerp(cell[0], cell[1], fr);
+        quint32 c10 = colorLerp(cell[strideG], cell[strideG + 1], fr);
+        quint32 c01 = colorLerp(cell[strideB], cell[strideB + 1], fr);
+        quint32 c11 = colorLerp(cell[strideB + strideG], cell[strideB + strideG + 1], fr);
+        quint32 c0 = colorLerp(c00, c10, fg);
+        quint32 c1 = colorLerp(c01, c11, fg);
+        pixels[x] = colorLerp(c0, c1, fb) | 0xFF000000u;
+    }
+}
+
+#ifdef COLOR_FILTER_SSE2
+void colorAffineSse2(quint32* pixels, int count, int gainQ9, int offset) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i gain = _mm_set1_epi16(qint16(gainQ9));
+    const __m128i bias = _mm_set1_epi16(qint16(offset));
+    const __m128i alpha = _mm_set1_epi32(int(0xFF000000u));
+
+    // (v << 7) * gain >> 16 == v * gain / 512，v << 7 仍在有符号 16 位范围内
+    int x = 0;
+    for (; x + 4 <= count; x += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(pixels + x);
+        __m128i v = _mm_loadu_si128(p);
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+        lo = _mm_add_epi16(_mm_mulhi_epi16(_mm_slli_epi16(lo, 7), gain), bias);
+        hi = _mm_add_epi16(_mm_mulhi_epi16(_mm_slli_epi16(hi, 7), gain), bias);
+        _mm_storeu_si128(p, _mm_or_si128(_mm_packus_epi16(lo, hi), alpha));
+    }
+    colorAffineScalar(pixels + x, count - x, gainQ9, offset);
+}
+
+// 与 colorLerp 相同的两通道技巧，4 个像素一起算
+static inline __m128i lerpSse2(__m128i a, __m128i b, __m128i weight, __m128i inverse) {
+    const __m128i mask = _mm_set1_epi32(0x00FF00FF);
+    __m128i rb = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(a, mask), inverse),
+                                              _mm_mullo_epi16(_mm_and_si128(b, mask), weight)), 8);
+    __m128i ag = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(a, 8), inverse),
+                               _mm_mullo_epi16(_mm_srli_epi16(b, 8), weight));
+    return _mm_or_si128(rb, _mm_andnot_si128(mask, ag));
+}
+
+// SSE2 没有 gather：网格下标和 8 个角点用标量取，插值全部向量化
+void colorLutSse2(quint32* pixels, int count, const quint32* lut, int size) {
+    const int strideG = size;
+    const int strideB = size * size;
+    const __m128i full = _mm_set1_epi16(256);
+    const __m128i alpha = _mm_set1_epi32(int(0xFF000000u));
+
+    int x = 0;
+    for (; x + 4 <= count; x += 4) {
+        const quint32* cells[4];
+        int fr[4], fg[4], fb[4];
+        for (int k = 0; k < 4; k++) {
+            quint32 p = pixels[x + k];
+            int ri, gi, bi;
+            colorLutPosition((p >> 16) & 0xFF, size, ri, fr[k]);
+            colorLutPosition((p >> 8) & 0xFF, size, gi, fg[k]);
+            colorLutPosition(p & 0xFF, size, bi, fb[k]);
+            cells[k] = lut + bi * strideB + gi * strideG + ri;
+            // 权重复制到两个 16 位通道
+            fr[k] *= 0x10001;
+            fg[k] *= 0x10001;
+            fb[k] *= 0x10001;
+        }
+
+#define CORNER(offset) _mm_set_epi32(int(cells[3][offset]), int(cells[2][offset]), \
+                                     int(cells[1][offset]), int(cells[0][offset]))
+        __m128i wr = _mm_set_epi32(fr[3], fr[2], fr[1], fr[0]);
+        __m128i wg = _mm_set_epi32(fg[3], fg[2], fg[1], fg[0]);
+        __m128i wb = _mm_set_epi32(fb[3], fb[2], fb[1], fb[0]);
+        __m128i ir = _mm_sub_epi16(full, wr);
+        __m128i ig = _mm_sub_epi16(full, wg);
+        __m128i ib = _mm_sub_epi16(full, wb);
+
+        __m128i c00 = lerpSse2(CORNER(0), CORNER(1), wr, ir);
+        __m128i c10 = lerpSse2(CORNER(strideG), CORNER(strideG + 1), wr, ir);
+        __m128i c01 = lerpSse2(CORNER(strideB), CORNER(strideB + 1), wr, ir);
+        __m128i c11 = lerpSse2(CORNER(strideB + strideG), CORNER(strideB + strideG + 1), wr, ir);
+#undef CORNER
+        __m128i c0 = lerpSse2(c00, c10, wg, ig);
+        __m128i c1 = lerpSse2(c01, c11, wg, ig);
+        __m128i result = _mm_or_si128(lerpSse2(c0, c1, wb, ib), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + x), result);
+    }
+    colorLutScalar(pixels + x, count - x, lut, size);
+}
+#endif
+
+// ==================== 应用 ====================
+
+void ColorFilter::apply(QImage& frame) const {
+    if (isIdentity() || frame.isNull()) return;
+
+    if (frame.format() != QImage::Format_RGB32) {
+        frame = frame.convertToFormat(QImage::Format_RGB32);
+    }
+
+    // 行之间没有填充时整帧当作一行处理
+    int width = frame.width();
+    int rows = frame.height();
+    if (frame.bytesPerLine() == width * 4) {
+        width *= rows;
+        rows = 1;
+    }
+
+    bool affine = gainQ9 != 512 || offset != 0;
+    for (int y = 0; y < rows; y++) {
+        quint32* pixels = reinterpret_cast<quint32*>(frame.scanLine(y));
+
+        // 曲线已包含曝光和对比度，一次查表完成，与所选内核无关
+        if (!curves.isEmpty()) {
+            colorCurvesScalar(pixels, width, curves.constData());
+            continue;
+        }
+
+        switch (kernel) {
+#ifdef COLOR_FILTER_AVX2
+        case Avx2:
+            if (affine) colorAffineAvx2(pixels, width, gainQ9, offset);
+            if (!lut.isEmpty()) colorLutAvx2(pixels, width, lut.constData(), lutSize);
+            break;
+#endif
+#ifdef COLOR_FILTER_SSE2
+        case Sse2:
+            if (affine) colorAffineSse2(pixels, width, gainQ9, offset);
+            if (!lut.isEmpty()) colorLutSse2(pixels, width, lut.constData(), lutSize);
+            break;
+#endif
+        default:
+            if (affine) colorAffineScalar(pixels, width, gainQ9, offset);
+            if (!lut.isEmpty()) colorLutScalar(pixels, width, lut.constData(), lutSize);
+            break;
+        }
+    }
+}
+
+// ==================== 基准测试 ====================
+
+// 平滑渐变加噪声，覆盖 LUT 的各个网格单元
+static QImage benchmarkFrame(const QSize& size) {
+    QImage frame(size, QImage::Format_RGB32);
+    quint32 seed = 12345;
+    for (int y = 0; y < size.height(); y++) {
+        quint32* line = reinterpret_cast<quint32*>(frame.scanLine(y));
+        for (int x = 0; x < size.width(); x++) {
+            seed = seed * 1664525u + 1013904223u;
+            int noise = int(seed >> 28);
+            int r = (x * 255 / qMax(1, size.width() - 1) + noise) & 0xFF;
+            int g = (y * 255 / qMax(1, size.height() - 1) + noise) & 0xFF;
+            int b = ((x + y) * 255 / qMax(1, size.width() + size.height() - 2)) & 0xFF;
+            line[x] = qRgb(r, g, b);
+        }
+    }
+    return frame;
+}
+
+QVector<ColorFilter::BenchmarkResult> ColorFilter::benchmark(const QSize& size, int frames) {
+    QVector<BenchmarkResult> results;
+    QImage source = benchmarkFrame(size);
+    frames = qMax(1, frames);
+
+    QVector<QPair<QString, ColorFilter> > filters;
+    {
+        ColorFilter filter;
+        filter.setExposure(0.5f);
+        filter.setContrast(1.2f);
+        filters.append(qMakePair(QString("Exposure + contrast"), filter));
+    }
+    for (int p = Warm; p <= Fade; p++) {
+        ColorFilter filter;
+        filter.setPreset(Preset(p));
+        filters.append(qMakePair(QString("LUT %1%2").arg(presetName(Preset(p)))
+                                     .arg(filter.usesCurves() ? " (1D)" : ""), filter));
+    }
+    {
+        ColorFilter filter;
+        filter.setPreset(Vivid);
+        filter.setExposure(0.5f);
+        filter.setContrast(1.2f);
+        filters.append(qMakePair(QString("Vivid + exposure + contrast"), filter));
+    }
+
+    for (int i = 0; i < filters.size(); i++) {
+        for (Kernel kernel : availableKernels()) {
+            ColorFilter filter = filters[i].second;
+            filter.setKernel(kernel);
+
+            QImage work = source.copy();
+            filter.apply(work);      // 预热缓存
+
+            QElapsedTimer timer;
+            timer.start();
+            for (int f = 0; f < frames; f++) {
+                filter.apply(work);
+            }
+
+            BenchmarkResult result;
+            result.filter = filters[i].first;
+            result.kernel = kernel;
+            result.msPerFrame = timer.nsecsElapsed() / 1e6 / frames;
+            results.append(result);
+        }
+    }
+    return results;
+}
+
+bool ColorFilter::isBenchmarkMode(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], BenchmarkFlag, std::strlen(BenchmarkFlag)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int ColorFilter::runBenchmark(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Tomeo");
+
+    // --benchmark-filters[=WxH]，默认 1080p
+    QSize size(1920, 1080);
+    for (int i = 1; i < argc; i++) {
+        QString argument = QString::fromLocal8Bit(argv[i]);
+        QString prefix = QString(BenchmarkFlag) + "=";
+        if (argument.startsWith(prefix)) {
+            QStringList parts = argument.mid(prefix.size()).split('x');
+            if (parts.size() == 2 && parts[0].toInt() > 0 && parts[1].toInt() > 0) {
+                size = QSize(parts[0].toInt(), parts[1].toInt());
+            }
+        }
+    }
+
+    static const int Frames = 60;
+    static const double FrameBudgetMs = 1000.0 / 30;
+
+    qDebug().noquote() << QString("Color filter benchmark: %1x%2, %3 frames per filter, budget %4 ms (30 fps)")
+                              .arg(size.width()).arg(size.height()).arg(Frames)
+                              .arg(FrameBudgetMs, 0, 'f', 1);
+    for (const BenchmarkResult& result : benchmark(size, Frames)) {
+        qDebug().noquote() << QString("  %1 %2 %3 ms/frame %4")
+                                  .arg(result.filter, -28)
+                                  .arg(kernelName(result.kernel), -7)
+                                  .arg(result.msPerFrame, 8, 'f', 3)
+                                  .arg(result.msPerFrame <= FrameBudgetMs ? "" : "(over budget)");
+    }
+    return 0;
+}
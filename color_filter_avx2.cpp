@@ -0,0 +1,97 @@
+//
+// ColorFilter AVX2 内核 - 实现
+// 本文件以 AVX2 指令集编译（tomeo.pro 的 AVX2_SOURCES），只能在 bestKernel() 确认 CPU 支持后调用
+//
+
+#include "color_filter_kernels.h"
+#include <immintrin.h>
+
+void colorAffineAvx2(quint32* pixels, int count, int gainQ9, int offset) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i gain = _mm256_set1_epi16(qint16(gainQ9));
+    const __m256i bias = _mm256_set1_epi16(qint16(offset));
+    const __m256i alpha = _mm256_set1_epi32(int(0xFF000000u));
+
+    // unpack / pack 都按 128 位分道进行，像素顺序保持不变
+    int x = 0;
+    for (; x + 8 <= count; x += 8) {
+        __m256i* p = reinterpret_cast<__m256i*>(pixels + x);
+        __m256i v = _mm256_loadu_si256(p);
+        __m256i lo = _mm256_unpacklo_epi8(v, zero);
+        __m256i hi = _mm256_unpackhi_epi8(v, zero);
+        lo = _mm256_add_epi16(_mm256_mulhi_epi16(_mm256_slli_epi16(lo, 7), gain), bias);
+        hi = _mm256_add_epi16(_mm256_mulhi_epi16(_mm256_slli_epi16(hi, 7), gain), bias);
+        _mm256_storeu_si256(p, _mm256_or_si256(_mm256_packus_epi16(lo, hi), alpha));
+    }
+    colorAffineScalar(pixels + x, count - x, gainQ9, offset);
+}
+
+static inline __m256i lerpAvx2(__m256i a, __m256i b, __m256i weight, __m256i inverse) {
+    const __m256i mask = _mm256_set1_epi32(0x00FF00FF);
+    __m256i rb = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(a, mask), inverse),
+                                                    _mm256_mullo_epi16(_mm256_and_si256(b, mask), weight)), 8);
+    __m256i ag = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_srli_epi16(a, 8), inverse),
+                                  _mm256_mullo_epi16(_mm256_srli_epi16(b, 8), weight));
+    return _mm256_or_si256(rb, _mm256_andnot_si256(mask, ag));
+}
+
+// 与 colorLutPosition 相同的网格定位，8 个像素一起算
+static inline void latticeAvx2(__m256i value, __m256i scale, __m256i last,
+                               __m256i& index, __m256i& weight) {
+    const __m256i round = _mm256_set1_epi32(128);
+    const __m256i low = _mm256_set1_epi32(0xFF);
+    const __m256i full = _mm256_set1_epi32(256);
+
+    __m256i position = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi32(value, scale), round), 8);
+    index = _mm256_srli_epi32(position, 8);
+    __m256i fraction = _mm256_and_si256(position, low);
+
+    __m256i over = _mm256_cmpgt_epi32(index, last);
+    index = _mm256_min_epi32(index, last);
+    fraction = _mm256_blendv_epi8(fraction, full, over);
+
+    // 权重复制到两个 16 位通道
+    weight = _mm256_or_si256(fraction, _mm256_slli_epi32(fraction, 16));
+}
+
+void colorLutAvx2(quint32* pixels, int count, const quint32* lut, int size) {
+    const int strideG = size;
+    const int strideB = size * size;
+    const int* table = reinterpret_cast<const int*>(lut);
+
+    const __m256i low = _mm256_set1_epi32(0xFF);
+    const __m256i scale = _mm256_set1_epi32((size - 1) * 257);
+    const __m256i last = _mm256_set1_epi32(size - 2);
+    const __m256i stepG = _mm256_set1_epi32(strideG);
+    const __m256i stepB = _mm256_set1_epi32(strideB);
+    const __m256i full = _mm256_set1_epi16(256);
+    const __m256i alpha = _mm256_set1_epi32(int(0xFF000000u));
+
+    int x = 0;
+    for (; x + 8 <= count; x += 8) {
+        __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + x));
+
+        __m256i ri, gi, bi, wr, wg, wb;
+        latticeAvx2(_mm256_and_si256(_mm256_srli_epi32(p, 16), low), scale, last, ri, wr);
+        latticeAvx2(_mm256_and_si256(_mm256_srli_epi32(p, 8), low), scale, last, gi, wg);
+        latticeAvx2(_mm256_and_si256(p, low), scale, last, bi, wb);
+
+        __m256i cell = _mm256_add_epi32(_mm256_add_epi32(ri, _mm256_mullo_epi32(gi, stepG)),
+                                        _mm256_mullo_epi32(bi, stepB));
+        __m256i ir = _mm256_sub_epi16(full, wr);
+        __m256i ig = _mm256_sub_epi16(full, wg);
+        __m256i ib = _mm256_sub_epi16(full, wb);
+
+#define CORNER(offset) _mm256_i32gather_epi32(table, _mm256_add_epi32(cell, _mm256_set1_epi32(offset)), 4)
+        __m256i c00 = lerpAvx2(CORNER(0), CORNER(1), wr, ir);
+        __m256i c10 = lerpAvx2(CORNER(strideG), CORNER(strideG + 1), wr, ir);
+        __m256i c01 = lerpAvx2(CORNER(strideB), CORNER(strideB + 1), wr, ir);
+        __m256i c11 = lerpAvx2(CORNER(strideB + strideG), CORNER(strideB + strideG + 1), wr, ir);
+#undef CORNER
+        __m256i c0 = lerpAvx2(c00, c10, wg, ig);
+        __m256i c1 = lerpAvx2(c01, c11, wg, ig);
+        __m256i result = _mm256_or_si256(lerpAvx2(c0, c1, wb, ib), alpha);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + x), result);
+    }
+    colorLutScalar(pixels + x, count - x, lut, size);
+}
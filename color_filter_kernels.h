@@ -0,0 +1,49 @@
+//
+// ColorFilter 内核 - 仅供 color_filter.cpp 与 color_filter_avx2.cpp 使用
+// Iteration 4: 所有内核都在 RGB32 像素上原地处理 count 个像素，alpha 保持 0xFF。
+//              AVX2 版本单独编译（tomeo.pro 的 AVX2_SOURCES），只在 CPU 支持时调用
+//
+
+#ifndef COLOR_FILTER_KERNELS_H
+#define COLOR_FILTER_KERNELS_H
+
+#include <QtGlobal>
+
+// out = clamp(in * gainQ9 / 512 + offset)，三个颜色通道相同
+void colorAffineScalar(quint32* pixels, int count, int gainQ9, int offset);
+void colorAffineSse2(quint32* pixels, int count, int gainQ9, int offset);
+void colorAffineAvx2(quint32* pixels, int count, int gainQ9, int offset);
+
+// size^3 的 3D LUT，三线性插值
+void colorLutScalar(quint32* pixels, int count, const quint32* lut, int size);
+void colorLutSse2(quint32* pixels, int count, const quint32* lut, int size);
+void colorLutAvx2(quint32* pixels, int count, const quint32* lut, int size);
+
+// 三条 256 项曲线（R、G、B 依次排列），用于逐通道可分离的滤镜；查表没有可向量化的部分，只有标量版本
+void colorCurvesScalar(quint32* pixels, int count, const quint8* curves);
+
+// 与 colorAffine* 取整一致的单通道仿射结果
+inline int colorAffineValue(int value, int gainQ9, int offset) {
+    return qBound(0, ((value << 7) * gainQ9 >> 16) + offset, 255);
+}
+
+// 输入值 0..255 在 LUT 网格上的位置：下标 0..size-2，权重 0..256
+inline void colorLutPosition(int value, int size, int& index, int& fraction) {
+    int position = (value * (size - 1) * 257 + 128) >> 8;
+    index = position >> 8;
+    fraction = position & 255;
+    if (index >= size - 1) {
+        index = size - 2;
+        fraction = 256;
+    }
+}
+
+// 打包像素的逐通道插值，权重 0..256（每次处理两个通道）
+inline quint32 colorLerp(quint32 a, quint32 b, quint32 weight) {
+    quint32 inverse = 256 - weight;
+    quint32 rb = (((a & 0x00FF00FF) * inverse + (b & 0x00FF00FF) * weight) >> 8) & 0x00FF00FF;
+    quint32 ag = (((a >> 8) & 0x00FF00FF) * inverse + ((b >> 8) & 0x00FF00FF) * weight) & 0xFF00FF00;
+    return rb | ag;
+}
+
+#endif // COLOR_FILTER_KERNELS_H
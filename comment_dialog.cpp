@@ -4,6 +4,7 @@
 
 #include "comment_dialog.h"
 #include "social_manager.h"
+#include "mutation_queue.h"
 #include "design_system.h"
 #include <QHBoxLayout>
 #include <QDateTime>
@@ -345,8 +346,8 @@ void CommentDialog::onSendClicked() {
     comment.likesCount = 0;
     comment.isLiked = false;
 
-    // 添加到帖子
-    SocialManager::getInstance()->addComment(postId, comment);
+    // 添加到帖子（本地立即生效，联网时排队上传）
+    MutationQueue::getInstance()->addComment(postId, comment);
     post.comments.append(comment);
     post.commentsCount++;
 
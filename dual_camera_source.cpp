@@ -0,0 +1,187 @@
+//
+// DualCameraSource - 实现
+//
+
+#include "dual_camera_source.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <utility>
+
+// 连续超预算多少帧后降级、连续宽裕多少帧后恢复
+static const int DegradeAfterFrames = 3;
+static const int RecoverAfterFrames = 90;
+
+DualCameraSource::DualCameraSource(Kind kind, bool front, QObject* parent)
+    : FrameSource(parent),
+    primaryFront(front),
+    secondaryRunning(false),
+    insetDirty(false),
+    slowStreak(0),
+    fastStreak(0),
+    totalComposeUs(0) {
+
+    primary = FrameSource::create(kind, front, this);
+    secondary = FrameSource::create(kind, !front, this);
+
+    thread = new QThread(this);
+    thread->setObjectName("DualCameraCompositor");
+    worker = new QObject();
+    worker->moveToThread(thread);
+
+    // 两路帧都排队到合成线程处理，来源线程不做合成
+    connect(primary, &FrameSource::frameCaptured, worker,
+            [this](const QImage& frame, qint64 timestampUs) { onPrimaryFrame(frame, timestampUs); });
+    connect(secondary, &FrameSource::frameCaptured, worker,
+            [this](const QImage& frame, qint64) { onSecondaryFrame(frame); });
+
+    // 主画面出错才算来源出错；副画面失败时退回单画面
+    connect(primary, &FrameSource::error, this, &FrameSource::error);
+    connect(secondary, &FrameSource::error, this, [](const QString& message) {
+        qDebug() << "DualCameraSource: secondary source error, continuing without inset:" << message;
+    });
+}
+
+DualCameraSource::~DualCameraSource() {
+    stop();
+    delete worker;
+}
+
+QString DualCameraSource::name() const {
+    return QString("Dual: %1 + %2").arg(primary->name(), secondary->name());
+}
+
+bool DualCameraSource::start(const QSize& size, int framesPerSecond) {
+    if (thread->isRunning()) return true;
+
+    // 合成线程还没启动，这里设置合成器是安全的
+    compositor.setOutputSize(size);
+    compositor.setQuality(PipCompositor::Bilinear);
+    slowStreak = 0;
+    fastStreak = 0;
+    insetDirty = false;
+    latestInset = QImage();
+    {
+        QMutexLocker locker(&statsMutex);
+        compositeStats = CompositeStats();
+        // 合成最多占用半个帧间隔，剩下的留给取景器和编码
+        compositeStats.budgetUs = 500000 / qMax(1, framesPerSecond);
+        totalComposeUs = 0;
+    }
+
+    thread->start();
+    if (!primary->start(size, framesPerSecond)) {
+        thread->quit();
+        thread->wait();
+        return false;
+    }
+
+    // 副画面直接按小窗尺寸采集，测试图案不需要再缩放
+    secondaryRunning = secondary->start(compositor.getInsetRect().size(), framesPerSecond);
+    if (!secondaryRunning) {
+        qDebug() << "DualCameraSource: secondary source unavailable, recording single view";
+    }
+
+    qDebug() << "DualCameraSource started:" << name() << size
+             << "inset" << compositor.getInsetRect()
+             << (PipCompositor::usesSimd() ? "SSE2" : "scalar");
+    return true;
+}
+
+void DualCameraSource::stop() {
+    if (!thread->isRunning()) return;
+
+    primary->stop();
+    if (secondaryRunning) {
+        secondary->stop();
+        secondaryRunning = false;
+    }
+
+    // 排在后面的空调用返回时，已入队的帧都处理完了，来源的在途计数不会残留
+    QMetaObject::invokeMethod(worker, []() {}, Qt::BlockingQueuedConnection);
+    thread->quit();
+    thread->wait();
+
+    CompositeStats result = stats();
+    qDebug() << "DualCameraSource stopped:" << result.framesComposed << "frames, avg"
+             << result.averageUs << "us, worst" << result.worstUs << "us, budget"
+             << result.budgetUs << "us," << result.framesOverBudget << "over budget";
+}
+
+int DualCameraSource::droppedCount() const {
+    return FrameSource::droppedCount() + primary->droppedCount();
+}
+
+void DualCameraSource::resetDropped() {
+    FrameSource::resetDropped();
+    primary->resetDropped();
+    secondary->resetDropped();
+}
+
+CompositeStats DualCameraSource::stats() const {
+    CompositeStats result;
+    {
+        QMutexLocker locker(&statsMutex);
+        result = compositeStats;
+    }
+    result.insetDropped = secondary->droppedCount();
+    return result;
+}
+
+void DualCameraSource::onSecondaryFrame(const QImage& frame) {
+    // 只记下最新一帧，缩放推迟到下一次合成，副画面帧率更高时不做无用功
+    latestInset = frame;
+    insetDirty = true;
+    secondary->frameConsumed();
+}
+
+void DualCameraSource::onPrimaryFrame(const QImage& frame, qint64 timestampUs) {
+    QElapsedTimer timer;
+    timer.start();
+
+    if (insetDirty) {
+        compositor.updateInset(latestInset);
+        latestInset = QImage();
+        insetDirty = false;
+    }
+    QImage composed = compositor.compose(frame);
+
+    recordTiming(timer.nsecsElapsed() / 1000);
+    primary->frameConsumed();
+    deliver(std::move(composed), timestampUs);
+}
+
+void DualCameraSource::recordTiming(qint64 elapsedUs) {
+    qint64 budgetUs;
+    {
+        QMutexLocker locker(&statsMutex);
+        compositeStats.framesComposed++;
+        totalComposeUs += elapsedUs;
+        compositeStats.averageUs = totalComposeUs / compositeStats.framesComposed;
+        compositeStats.worstUs = qMax(compositeStats.worstUs, elapsedUs);
+        if (elapsedUs > compositeStats.budgetUs) {
+            compositeStats.framesOverBudget++;
+        }
+        budgetUs = compositeStats.budgetUs;
+    }
+
+    // 连续超预算时改用最近邻缩放，明显宽裕后再恢复双线性
+    if (elapsedUs > budgetUs) {
+        fastStreak = 0;
+        if (++slowStreak >= DegradeAfterFrames && compositor.getQuality() == PipCompositor::Bilinear) {
+            compositor.setQuality(PipCompositor::Nearest);
+            qDebug() << "DualCameraSource: over budget (" << elapsedUs << "us ), switching to nearest scaling";
+        }
+    } else {
+        slowStreak = 0;
+        if (elapsedUs * 2 < budgetUs && ++fastStreak >= RecoverAfterFrames &&
+            compositor.getQuality() == PipCompositor::Nearest) {
+            compositor.setQuality(PipCompositor::Bilinear);
+            fastStreak = 0;
+            qDebug() << "DualCameraSource: back within budget, switching to bilinear scaling";
+        }
+    }
+
+    QMutexLocker locker(&statsMutex);
+    compositeStats.degraded = compositor.getQuality() == PipCompositor::Nearest;
+}
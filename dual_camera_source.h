@@ -0,0 +1,72 @@
+//
+// DualCameraSource - 双摄（BeReal）帧来源
+// Iteration 4: 同时运行前后两路来源，在合成线程中把副画面叠加到主画面上，
+//              合成结果作为一路普通帧交给 RecordingPipeline；两路都可以是测试图案
+//
+
+#ifndef DUAL_CAMERA_SOURCE_H
+#define DUAL_CAMERA_SOURCE_H
+
+#include "frame_source.h"
+#include "pip_compositor.h"
+#include <QMutex>
+#include <QThread>
+
+struct CompositeStats {
+    int framesComposed;
+    int framesOverBudget;
+    qint64 averageUs;
+    qint64 worstUs;
+    qint64 budgetUs;
+    bool degraded;          // 当前使用最近邻缩放
+    int insetDropped;       // 副画面来源丢掉的帧（小窗少更新，不影响输出帧数）
+
+    CompositeStats()
+        : framesComposed(0), framesOverBudget(0), averageUs(0), worstUs(0), budgetUs(0), degraded(false),
+        insetDropped(0) {}
+};
+
+class DualCameraSource : public FrameSource {
+    Q_OBJECT
+
+private:
+    bool primaryFront;
+    FrameSource* primary;       // 全屏画面
+    FrameSource* secondary;     // 左上角小画面
+    bool secondaryRunning;
+
+    QThread* thread;
+    QObject* worker;            // 属于合成线程，两路帧都排队到这里
+
+    // 以下只在合成线程中访问
+    PipCompositor compositor;
+    QImage latestInset;         // 尚未缩放的最新副画面
+    bool insetDirty;
+    int slowStreak;
+    int fastStreak;
+
+    mutable QMutex statsMutex;
+    CompositeStats compositeStats;
+    qint64 totalComposeUs;
+
+    void onPrimaryFrame(const QImage& frame, qint64 timestampUs);
+    void onSecondaryFrame(const QImage& frame);
+    void recordTiming(qint64 elapsedUs);
+
+public:
+    // primaryFront 指定主画面的朝向，副画面用另一侧相机；录制对话框沿用当前选择的相机
+    DualCameraSource(Kind kind, bool primaryFront, QObject* parent = nullptr);
+    ~DualCameraSource();
+
+    QString name() const override;
+    bool start(const QSize& size, int framesPerSecond) override;
+    void stop() override;
+
+    // 包含主画面来源丢掉的帧：它们同样不会出现在输出中
+    int droppedCount() const override;
+    void resetDropped() override;
+
+    CompositeStats stats() const;
+};
+
+#endif // DUAL_CAMERA_SOURCE_H
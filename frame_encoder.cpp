@@ -0,0 +1,250 @@
+//
+// FrameEncoder - 实现
+//
+
+#include "frame_encoder.h"
+#include <QDebug>
+#include <QFile>
+#include <QMutexLocker>
+#include <QProcess>
+#include <QStandardPaths>
+
+// QImage::Format_RGB32 在内存中的字节顺序
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+static const char* RawPixelFormat = "bgra";
+#else
+static const char* RawPixelFormat = "argb";
+#endif
+
+// 时间戳跳变超过这么多秒时不再补帧，改为从当前位置重新对齐
+static const int MaxGapSeconds = 5;
+
+FrameEncoder::FrameEncoder(QObject* parent)
+    : QObject(parent),
+    thread(nullptr),
+    framesPerSecond(30),
+    queueCapacity(8),
+    finishing(false),
+    aborting(false),
+    framesEncoded(0),
+    framesDropped(0),
+    framesDuplicated(0),
+    framesSkipped(0) {
+
+    ffmpegPath = QStandardPaths::findExecutable("ffmpeg");
+    if (ffmpegPath.isEmpty()) {
+        qDebug() << "FrameEncoder: ffmpeg not found, recording disabled";
+    }
+}
+
+FrameEncoder::~FrameEncoder() {
+    abort();
+    if (thread) {
+        thread->wait();
+        delete thread;
+    }
+}
+
+bool FrameEncoder::start(const QString& path, const QSize& size, int fps, int capacity) {
+    if (!isAvailable() || isRunning() || size.isEmpty()) return false;
+
+    if (thread) {
+        delete thread;
+        thread = nullptr;
+    }
+
+    outputPath = path;
+    partialPath = path + ".part";
+    // H.264 4:2:0 要求偶数尺寸
+    frameSize = QSize(size.width() & ~1, size.height() & ~1);
+    framesPerSecond = qMax(1, fps);
+    queueCapacity = qMax(1, capacity);
+
+    queue.clear();
+    finishing = false;
+    aborting = false;
+    framesEncoded.storeRelease(0);
+    framesDropped.storeRelease(0);
+    framesDuplicated.storeRelease(0);
+    framesSkipped.storeRelease(0);
+
+    thread = QThread::create([this]() { run(); });
+    thread->setObjectName("FrameEncoder");
+    thread->start();
+
+    qDebug() << "FrameEncoder: recording" << frameSize << framesPerSecond << "fps to" << outputPath;
+    return true;
+}
+
+bool FrameEncoder::submit(const QImage& frame, qint64 timestampUs) {
+    QMutexLocker locker(&mutex);
+    if (!isRunning() || finishing || aborting) return false;
+
+    if (queue.size() >= queueCapacity) {
+        framesDropped.fetchAndAddRelaxed(1);
+        return false;
+    }
+
+    QueuedFrame queued;
+    queued.image = frame;
+    queued.timestampUs = timestampUs;
+    queue.enqueue(queued);
+    frameAvailable.wakeOne();
+    return true;
+}
+
+void FrameEncoder::finish() {
+    QMutexLocker locker(&mutex);
+    finishing = true;
+    frameAvailable.wakeOne();
+}
+
+void FrameEncoder::abort() {
+    QMutexLocker locker(&mutex);
+    aborting = true;
+    queue.clear();
+    frameAvailable.wakeOne();
+}
+
+// 编码线程：没有事件循环，QProcess 使用阻塞接口
+void FrameEncoder::run() {
+    QStringList arguments;
+    arguments << "-hide_banner" << "-loglevel" << "error" << "-y"
+              << "-f" << "rawvideo"
+              << "-pix_fmt" << RawPixelFormat
+              << "-s" << QString("%1x%2").arg(frameSize.width()).arg(frameSize.height())
+              << "-framerate" << QString::number(framesPerSecond)
+              << "-i" << "-"
+              << "-c:v" << "libx264"
+              << "-preset" << "veryfast"
+              << "-tune" << "zerolatency"
+              << "-pix_fmt" << "yuv420p"
+              << "-movflags" << "+faststart"
+              << "-f" << "mp4"
+              << partialPath;
+
+    QProcess process;
+    process.setProcessChannelMode(QProcess::SeparateChannels);
+    process.start(ffmpegPath, arguments);
+    if (!process.waitForStarted(5000)) {
+        emit finished(false, outputPath, tr("Failed to start ffmpeg"));
+        return;
+    }
+
+    // 写出一帧原始像素，ffmpeg 按到达顺序以恒定帧率计时
+    auto writeFrame = [&process](const QImage& image) {
+        // RGB32 每行正好 width * 4 字节，可以整块写出
+        process.write(reinterpret_cast<const char*>(image.constBits()), image.sizeInBytes());
+        while (process.bytesToWrite() > 0) {
+            if (!process.waitForBytesWritten(1000) && process.state() != QProcess::Running) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    const qint64 maxGapSlots = qint64(MaxGapSeconds) * framesPerSecond;
+    qint64 baseTimestampUs = -1;    // 帧位 0 对应的采集时间
+    qint64 nextSlot = 0;            // 下一个待写的帧位
+    QImage lastFrame;
+
+    bool failed = false;
+    while (true) {
+        QImage frame;
+        qint64 timestampUs;
+        {
+            QMutexLocker locker(&mutex);
+            while (queue.isEmpty() && !finishing && !aborting) {
+                frameAvailable.wait(&mutex);
+            }
+            if (aborting || queue.isEmpty()) break;
+            QueuedFrame queued = queue.dequeue();
+            frame = queued.image;
+            timestampUs = queued.timestampUs;
+        }
+
+        // 按时间戳求帧位（四舍五入）
+        if (baseTimestampUs < 0) {
+            baseTimestampUs = timestampUs;
+        }
+        qint64 slot = ((timestampUs - baseTimestampUs) * framesPerSecond + 500000) / 1000000;
+        if (slot < nextSlot) {
+            // 这一帧位已经写过（来源比标称帧率快），跳过
+            framesSkipped.fetchAndAddRelaxed(1);
+            continue;
+        }
+        if (slot - nextSlot > maxGapSlots) {
+            qDebug() << "FrameEncoder: timestamp jumped" << (slot - nextSlot) << "frames, realigning";
+            baseTimestampUs = timestampUs - nextSlot * 1000000 / framesPerSecond;
+            slot = nextSlot;
+        }
+
+        // 尺寸或格式不符时在这里转换，取景器看到的原帧不受影响
+        if (frame.size() != frameSize) {
+            QImage scaled = frame.scaled(frameSize, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+            frame = scaled.copy((scaled.width() - frameSize.width()) / 2,
+                                (scaled.height() - frameSize.height()) / 2,
+                                frameSize.width(), frameSize.height());
+        }
+        if (frame.format() != QImage::Format_RGB32) {
+            frame = frame.convertToFormat(QImage::Format_RGB32);
+        }
+
+        // 丢帧或相机偏慢留下的空帧位用上一帧补齐，保持输出时长
+        while (nextSlot < slot && !lastFrame.isNull()) {
+            if (!writeFrame(lastFrame)) {
+                failed = true;
+                break;
+            }
+            framesDuplicated.fetchAndAddRelaxed(1);
+            nextSlot++;
+        }
+        if (failed) break;
+
+        if (!writeFrame(frame)) {
+            failed = true;
+            break;
+        }
+        nextSlot = slot + 1;
+        lastFrame = frame;
+        framesEncoded.fetchAndAddRelaxed(1);
+    }
+
+    bool aborted;
+    {
+        QMutexLocker locker(&mutex);
+        aborted = aborting;
+        queue.clear();
+    }
+
+    if (aborted) {
+        process.kill();
+        process.waitForFinished(3000);
+        QFile::remove(partialPath);
+        emit finished(false, outputPath, tr("Recording discarded"));
+        return;
+    }
+
+    process.closeWriteChannel();
+    bool ok = !failed && process.waitForFinished(60000) &&
+              process.exitStatus() == QProcess::NormalExit && process.exitCode() == 0;
+    QString error = QString::fromLocal8Bit(process.readAllStandardError()).trimmed();
+    if (process.state() != QProcess::NotRunning) {
+        process.kill();
+        process.waitForFinished(3000);
+    }
+
+    if (ok) {
+        QFile::remove(outputPath);
+        ok = QFile::rename(partialPath, outputPath);
+    } else {
+        QFile::remove(partialPath);
+    }
+
+    qDebug() << "FrameEncoder:" << (ok ? "finished" : "failed") << outputPath
+             << framesEncoded.loadAcquire() << "frames encoded,"
+             << framesDropped.loadAcquire() << "dropped,"
+             << framesDuplicated.loadAcquire() << "duplicated,"
+             << framesSkipped.loadAcquire() << "skipped" << error;
+    emit finished(ok, outputPath, error);
+}
@@ -0,0 +1,82 @@
+//
+// FrameEncoder - 录制编码器
+// Iteration 4: 帧放入有界队列，由独立线程把原始像素写入 ffmpeg 进程编码为 H.264 MP4；
+//              队列满时丢帧并计数，GUI 线程从不等待编码。
+//              输出为恒定帧率：按采集时间戳把帧放到对应的帧位，缺帧时重复上一帧，
+//              提前到达的多余帧跳过，丢帧或相机偏慢时录像时长仍与实际一致
+//
+
+#ifndef FRAME_ENCODER_H
+#define FRAME_ENCODER_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QImage>
+#include <QMutex>
+#include <QQueue>
+#include <QSize>
+#include <QThread>
+#include <QWaitCondition>
+
+class FrameEncoder : public QObject {
+    Q_OBJECT
+
+private:
+    QString ffmpegPath;
+    QThread* thread;
+
+    // 工作线程参数，start() 中设置后只读
+    QString outputPath;
+    QString partialPath;
+    QSize frameSize;
+    int framesPerSecond;
+    int queueCapacity;
+
+    struct QueuedFrame {
+        QImage image;
+        qint64 timestampUs;
+    };
+
+    // 生产者（GUI 线程）与编码线程共享
+    QMutex mutex;
+    QWaitCondition frameAvailable;
+    QQueue<QueuedFrame> queue;
+    bool finishing;
+    bool aborting;
+
+    QAtomicInt framesEncoded;
+    QAtomicInt framesDropped;
+    QAtomicInt framesDuplicated;   // 为补齐帧位重复写出的帧
+    QAtomicInt framesSkipped;      // 帧位已被占用而跳过的帧
+
+    void run();
+
+public:
+    explicit FrameEncoder(QObject* parent = nullptr);
+    ~FrameEncoder();
+
+    bool isAvailable() const { return !ffmpegPath.isEmpty(); }
+    bool isRunning() const { return thread && thread->isRunning(); }
+
+    // 开始编码到 path；帧尺寸不一致时在编码线程中缩放
+    bool start(const QString& path, const QSize& size, int framesPerSecond, int queueCapacity);
+
+    // 线程安全；队列满时丢弃并返回 false。帧数据共享，不拷贝。
+    // timestampUs 为来源的单调采集时间，决定该帧在输出中的位置
+    bool submit(const QImage& frame, qint64 timestampUs);
+
+    // 编码完队列中剩余的帧后结束，完成时发出 finished
+    void finish();
+    // 丢弃剩余帧并删除未完成的文件
+    void abort();
+
+    int encodedCount() const { return framesEncoded.loadAcquire(); }
+    int droppedCount() const { return framesDropped.loadAcquire(); }
+    int duplicatedCount() const { return framesDuplicated.loadAcquire(); }
+    int skippedCount() const { return framesSkipped.loadAcquire(); }
+
+signals:
+    void finished(bool ok, const QString& path, const QString& error);
+};
+
+#endif // FRAME_ENCODER_H
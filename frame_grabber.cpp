@@ -0,0 +1,203 @@
+//
+// FrameGrabber - 实现
+//
+
+#include "frame_grabber.h"
+#include <QDebug>
+
+// 单帧等待上限，超时则跳过该时间点
+static const int FrameTimeoutMs = 2000;
+
+// 接受的帧时间与目标时间的最大偏差
+static const qint64 SeekToleranceMs = 1000;
+
+FrameGrabSurface::FrameGrabSurface(QObject* parent)
+    : QAbstractVideoSurface(parent),
+    armed(false) {
+}
+
+QList<QVideoFrame::PixelFormat> FrameGrabSurface::supportedPixelFormats(
+    QAbstractVideoBuffer::HandleType type) const {
+    if (type != QAbstractVideoBuffer::NoHandle) {
+        return QList<QVideoFrame::PixelFormat>();
+    }
+
+    return QList<QVideoFrame::PixelFormat>()
+           << QVideoFrame::Format_RGB32
+           << QVideoFrame::Format_ARGB32
+           << QVideoFrame::Format_ARGB32_Premultiplied
+           << QVideoFrame::Format_RGB24
+           << QVideoFrame::Format_BGR32
+           << QVideoFrame::Format_YUV420P
+           << QVideoFrame::Format_YV12
+           << QVideoFrame::Format_NV12
+           << QVideoFrame::Format_UYVY
+           << QVideoFrame::Format_YUYV;
+}
+
+bool FrameGrabSurface::present(const QVideoFrame& frame) {
+    if (!armed || !frame.isValid()) {
+        return true;
+    }
+
+    QVideoFrame copy(frame);
+    QImage image = copy.image();
+    if (image.isNull()) {
+        return true;
+    }
+
+    armed = false;
+    qint64 startTimeMs = frame.startTime() >= 0 ? frame.startTime() / 1000 : -1;
+    emit frameAvailable(image, startTimeMs);
+    return true;
+}
+
+FrameGrabber::FrameGrabber(QObject* parent)
+    : QObject(parent),
+    intervalMs(0),
+    maxFrames(0),
+    currentFrame(0),
+    busy(false) {
+
+    player = new QMediaPlayer(this, QMediaPlayer::VideoSurface);
+    player->setMuted(true);
+
+    surface = new FrameGrabSurface(this);
+    player->setVideoOutput(surface);
+
+    frameTimeout = new QTimer(this);
+    frameTimeout->setSingleShot(true);
+    frameTimeout->setInterval(FrameTimeoutMs);
+
+    connect(player, &QMediaPlayer::mediaStatusChanged,
+            this, &FrameGrabber::onMediaStatusChanged);
+    connect(player, QOverload<QMediaPlayer::Error>::of(&QMediaPlayer::error),
+            this, &FrameGrabber::onError);
+    connect(surface, &FrameGrabSurface::frameAvailable,
+            this, &FrameGrabber::onFrameAvailable);
+    connect(frameTimeout, &QTimer::timeout,
+            this, &FrameGrabber::onFrameTimeout);
+}
+
+void FrameGrabber::start(const QUrl& url, const QSize& size,
+                         qint64 interval, int frames) {
+    if (busy) {
+        cancel();
+    }
+
+    currentUrl = url;
+    frameSize = size;
+    intervalMs = qMax<qint64>(1, interval);
+    maxFrames = qMax(1, frames);
+    positions.clear();
+    currentFrame = 0;
+    busy = true;
+
+    qDebug() << "FrameGrabber: loading" << url.toString();
+    player->setMedia(url);
+}
+
+void FrameGrabber::cancel() {
+    if (!busy) return;
+
+    busy = false;
+    frameTimeout->stop();
+    surface->disarm();
+    player->stop();
+    player->setMedia(QMediaContent());
+    qDebug() << "FrameGrabber: cancelled" << currentUrl.toString();
+}
+
+void FrameGrabber::computePositions(qint64 duration) {
+    positions.clear();
+
+    int count = static_cast<int>(duration / intervalMs);
+    if (count < 1) count = 1;
+    if (count > maxFrames) {
+        count = maxFrames;
+        intervalMs = duration / count;
+    }
+
+    for (int i = 0; i < count; i++) {
+        positions.append(i * intervalMs);
+    }
+}
+
+void FrameGrabber::seekToCurrent() {
+    surface->arm();
+    frameTimeout->start();
+    player->setPosition(positions.at(currentFrame));
+}
+
+void FrameGrabber::advance() {
+    currentFrame++;
+    if (currentFrame >= positions.size()) {
+        finish(true);
+    } else {
+        seekToCurrent();
+    }
+}
+
+void FrameGrabber::finish(bool ok) {
+    busy = false;
+    frameTimeout->stop();
+    surface->disarm();
+    player->stop();
+    player->setMedia(QMediaContent());
+
+    qDebug() << "FrameGrabber: finished" << currentUrl.toString() << "ok:" << ok;
+    emit finished(ok);
+}
+
+void FrameGrabber::onMediaStatusChanged(QMediaPlayer::MediaStatus status) {
+    if (!busy) return;
+
+    if (status == QMediaPlayer::LoadedMedia && positions.isEmpty()) {
+        qint64 duration = player->duration();
+        if (duration <= 0) {
+            qDebug() << "FrameGrabber: unknown duration for" << currentUrl.toString();
+            finish(false);
+            return;
+        }
+
+        computePositions(duration);
+        emit started(duration, intervalMs, positions.size());
+
+        // 暂停态下 seek 会让后端解码并呈现目标帧
+        player->pause();
+        seekToCurrent();
+    } else if (status == QMediaPlayer::InvalidMedia) {
+        finish(false);
+    }
+}
+
+void FrameGrabber::onError(QMediaPlayer::Error error) {
+    if (!busy) return;
+
+    qDebug() << "FrameGrabber error:" << player->errorString() << error;
+    finish(false);
+}
+
+void FrameGrabber::onFrameAvailable(const QImage& image, qint64 startTimeMs) {
+    if (!busy || currentFrame >= positions.size()) return;
+
+    // 丢弃 seek 之前残留的旧帧
+    qint64 target = positions.at(currentFrame);
+    if (startTimeMs >= 0 && qAbs(startTimeMs - target) > SeekToleranceMs) {
+        surface->arm();
+        return;
+    }
+
+    frameTimeout->stop();
+    emit frameReady(currentFrame, image.scaled(frameSize, Qt::KeepAspectRatio,
+                                               Qt::SmoothTransformation));
+    advance();
+}
+
+void FrameGrabber::onFrameTimeout() {
+    if (!busy) return;
+
+    qDebug() << "FrameGrabber: timed out at" << positions.value(currentFrame) << "ms";
+    surface->disarm();
+    advance();
+}
@@ -0,0 +1,84 @@
+//
+// FrameGrabber - 离屏视频抽帧器
+// Iteration 4: 用隐藏的 QMediaPlayer 按时间点抽取缩小后的视频帧
+//
+
+#ifndef FRAME_GRABBER_H
+#define FRAME_GRABBER_H
+
+#include <QObject>
+#include <QAbstractVideoSurface>
+#include <QMediaPlayer>
+#include <QImage>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+
+// 只在"上膛"时转换一帧的视频表面，其余帧直接丢弃
+class FrameGrabSurface : public QAbstractVideoSurface {
+    Q_OBJECT
+
+private:
+    bool armed;
+
+public:
+    explicit FrameGrabSurface(QObject* parent = nullptr);
+
+    void arm() { armed = true; }
+    void disarm() { armed = false; }
+
+    QList<QVideoFrame::PixelFormat> supportedPixelFormats(
+        QAbstractVideoBuffer::HandleType type = QAbstractVideoBuffer::NoHandle) const override;
+    bool present(const QVideoFrame& frame) override;
+
+signals:
+    void frameAvailable(const QImage& image, qint64 startTimeMs);
+};
+
+class FrameGrabber : public QObject {
+    Q_OBJECT
+
+private:
+    QMediaPlayer* player;
+    FrameGrabSurface* surface;
+    QTimer* frameTimeout;
+
+    QUrl currentUrl;
+    QSize frameSize;
+    qint64 intervalMs;
+    int maxFrames;
+
+    QVector<qint64> positions;   // 待抽取的时间点（毫秒）
+    int currentFrame;
+    bool busy;
+
+    void computePositions(qint64 duration);
+    void seekToCurrent();
+    void advance();
+    void finish(bool ok);
+
+public:
+    explicit FrameGrabber(QObject* parent = nullptr);
+
+    // 以固定间隔抽帧；若帧数超过 maxFrames，则拉伸间隔覆盖整段视频
+    void start(const QUrl& url, const QSize& frameSize,
+               qint64 intervalMs, int maxFrames);
+    void cancel();
+
+    bool isBusy() const { return busy; }
+    QUrl getUrl() const { return currentUrl; }
+
+private slots:
+    void onMediaStatusChanged(QMediaPlayer::MediaStatus status);
+    void onError(QMediaPlayer::Error error);
+    void onFrameAvailable(const QImage& image, qint64 startTimeMs);
+    void onFrameTimeout();
+
+signals:
+    // 时长已知后发出：实际间隔和帧数
+    void started(qint64 duration, qint64 intervalMs, int frameCount);
+    void frameReady(int index, const QImage& frame);
+    void finished(bool ok);
+};
+
+#endif // FRAME_GRABBER_H
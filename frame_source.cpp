@@ -0,0 +1,58 @@
+//
+// FrameSource - 实现
+//
+
+#include "frame_source.h"
+#include "camera_frame_source.h"
+#include "test_pattern_source.h"
+#include <QCameraInfo>
+#include <QDebug>
+#include <QSettings>
+
+FrameSource::FrameSource(QObject* parent)
+    : QObject(parent),
+    pendingFrames(0),
+    droppedFrames(0) {
+}
+
+FrameSource::Kind FrameSource::loadKind() {
+    QSettings settings("Tomeo", "RecordSettings");
+    QString kind = settings.value("frameSource", "auto").toString();
+    if (kind == "camera") return Camera;
+    if (kind == "testPattern") return TestPattern;
+    return Automatic;
+}
+
+void FrameSource::saveKind(Kind kind) {
+    QSettings settings("Tomeo", "RecordSettings");
+    settings.setValue("frameSource",
+                      kind == Camera ? "camera" : kind == TestPattern ? "testPattern" : "auto");
+}
+
+FrameSource* FrameSource::create(Kind kind, bool frontCamera, QObject* parent) {
+    if (kind == Automatic) {
+        kind = QCameraInfo::availableCameras().isEmpty() ? TestPattern : Camera;
+    }
+
+    if (kind == Camera) {
+        return new CameraFrameSource(frontCamera, parent);
+    }
+    return new TestPatternSource(frontCamera, parent);
+}
+
+void FrameSource::deliver(QImage frame, qint64 timestampUs) {
+    // 取景器或编码器落后时丢掉最新帧，保证延迟有上限
+    if (pendingFrames.fetchAndAddAcquire(1) >= MaxPendingFrames) {
+        pendingFrames.fetchAndAddRelease(-1);
+        droppedFrames.fetchAndAddRelaxed(1);
+        return;
+    }
+
+    emit frameCaptured(frame, timestampUs);
+}
+
+void FrameSource::frameConsumed() {
+    if (pendingFrames.fetchAndAddRelease(-1) <= 0) {
+        pendingFrames.storeRelease(0);
+    }
+}
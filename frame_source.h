@@ -0,0 +1,60 @@
+//
+// FrameSource - 录制帧来源
+// Iteration 4: 相机和测试图案共用的接口；帧以 QImage 共享给取景器和编码器，
+//              消费方来不及处理时在来源处直接丢帧并计数，不会无限堆积
+//
+
+#ifndef FRAME_SOURCE_H
+#define FRAME_SOURCE_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QImage>
+#include <QSize>
+
+class FrameSource : public QObject {
+    Q_OBJECT
+
+private:
+    QAtomicInt pendingFrames;   // 已发出但还没被消费的帧
+    QAtomicInt droppedFrames;
+
+protected:
+    explicit FrameSource(QObject* parent = nullptr);
+
+    // 子类产生一帧后调用（任意线程）；积压过多时丢弃，否则发出 frameCaptured
+    void deliver(QImage frame, qint64 timestampUs);
+
+public:
+    // 同时在途的帧数上限
+    static const int MaxPendingFrames = 2;
+
+    enum Kind {
+        Automatic,      // 有相机用相机，否则用测试图案
+        Camera,
+        TestPattern
+    };
+
+    virtual ~FrameSource() {}
+
+    // 来源保存在 QSettings("Tomeo", "RecordSettings")
+    static Kind loadKind();
+    static void saveKind(Kind kind);
+    static FrameSource* create(Kind kind, bool frontCamera, QObject* parent = nullptr);
+
+    virtual QString name() const = 0;
+    virtual bool start(const QSize& size, int framesPerSecond) = 0;
+    virtual void stop() = 0;
+
+    // 消费方处理完一帧后调用
+    void frameConsumed();
+    // 组合来源（如双摄）还要计入内部来源丢掉的帧
+    virtual int droppedCount() const { return droppedFrames.loadAcquire(); }
+    virtual void resetDropped() { droppedFrames.storeRelease(0); }
+
+signals:
+    void frameCaptured(const QImage& frame, qint64 timestampUs);
+    void error(const QString& message);
+};
+
+#endif // FRAME_SOURCE_H
@@ -0,0 +1,261 @@
+//
+// GLVideoWidget - 实现
+//
+
+#include "gl_video_widget.h"
+#include <QDebug>
+#include <QMutexLocker>
+
+static const char* VertexShaderSource = R"(
+    attribute highp vec2 position;
+    attribute highp vec2 texCoord;
+    varying highp vec2 vTexCoord;
+    void main() {
+        vTexCoord = texCoord;
+        gl_Position = vec4(position, 0.0, 1.0);
+    }
+)";
+
+// RGB32/ARGB32 在内存中按 BGRA 排列，上传为 RGBA 后在着色器里交换红蓝通道
+static const char* FragmentShaderSource = R"(
+    uniform sampler2D frameTexture;
+    uniform bool swapRedBlue;
+    varying highp vec2 vTexCoord;
+    void main() {
+        lowp vec4 color = texture2D(frameTexture, vTexCoord);
+        gl_FragColor = swapRedBlue ? vec4(color.b, color.g, color.r, 1.0)
+                                   : vec4(color.rgb, 1.0);
+    }
+)";
+
+GLVideoSurface::GLVideoSurface(GLVideoWidget* videoWidget)
+    : QAbstractVideoSurface(videoWidget),
+    widget(videoWidget) {
+}
+
+QList<QVideoFrame::PixelFormat> GLVideoSurface::supportedPixelFormats(
+    QAbstractVideoBuffer::HandleType type) const {
+    // GL 纹理句柄：后端直接在 GPU 上解码时无需经过系统内存
+    if (type == QAbstractVideoBuffer::GLTextureHandle) {
+        return QList<QVideoFrame::PixelFormat>()
+               << QVideoFrame::Format_RGB32
+               << QVideoFrame::Format_BGR32;
+    }
+
+    // 系统内存帧：按 BGRA 字节序上传
+    if (type == QAbstractVideoBuffer::NoHandle) {
+        return QList<QVideoFrame::PixelFormat>()
+               << QVideoFrame::Format_RGB32
+               << QVideoFrame::Format_ARGB32
+               << QVideoFrame::Format_ARGB32_Premultiplied;
+    }
+    return QList<QVideoFrame::PixelFormat>();
+}
+
+bool GLVideoSurface::present(const QVideoFrame& frame) {
+    if (!frame.isValid()) return false;
+
+    widget->queueFrame(frame);
+    return true;
+}
+
+void GLVideoSurface::stop() {
+    widget->clearFrame();
+    QAbstractVideoSurface::stop();
+}
+
+GLVideoWidget::GLVideoWidget(QWidget* parent)
+    : QOpenGLWidget(parent),
+    program(nullptr),
+    uploadTexture(0),
+    framePending(false),
+    currentTexture(0),
+    textureWidthRatio(1.0),
+    swapRedBlue(false) {
+
+    surface = new GLVideoSurface(this);
+    setMinimumHeight(320);
+}
+
+GLVideoWidget::~GLVideoWidget() {
+    makeCurrent();
+    if (uploadTexture) {
+        glDeleteTextures(1, &uploadTexture);
+    }
+    delete program;
+    doneCurrent();
+}
+
+void GLVideoWidget::initializeGL() {
+    initializeOpenGLFunctions();
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+    program = new QOpenGLShaderProgram();
+    program->addShaderFromSourceCode(QOpenGLShader::Vertex, VertexShaderSource);
+    program->addShaderFromSourceCode(QOpenGLShader::Fragment, FragmentShaderSource);
+    program->bindAttributeLocation("position", 0);
+    program->bindAttributeLocation("texCoord", 1);
+    if (!program->link()) {
+        qDebug() << "GLVideoWidget shader link failed:" << program->log();
+    }
+
+    glGenTextures(1, &uploadTexture);
+    glBindTexture(GL_TEXTURE_2D, uploadTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    qDebug() << "GLVideoWidget initialized, GL:"
+             << reinterpret_cast<const char*>(glGetString(GL_VERSION));
+}
+
+void GLVideoWidget::queueFrame(const QVideoFrame& frame) {
+    {
+        QMutexLocker locker(&frameMutex);
+        stats.framesDecoded++;
+
+        // 上一帧还没画出来就被覆盖，计为丢帧
+        if (framePending) {
+            stats.framesDropped++;
+        }
+        pendingFrame = frame;
+        framePending = true;
+    }
+    update();
+}
+
+void GLVideoWidget::clearFrame() {
+    {
+        // 可能从多媒体后端线程调用（GLVideoSurface::stop），与 paintGL 共用同一把锁
+        QMutexLocker locker(&frameMutex);
+        pendingFrame = QVideoFrame();
+        framePending = false;
+        displayedFrame = QVideoFrame();
+        currentTexture = 0;
+    }
+    QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
+}
+
+VideoOutputStats GLVideoWidget::getStats() {
+    QMutexLocker locker(&frameMutex);
+    return stats;
+}
+
+void GLVideoWidget::resetStats() {
+    QMutexLocker locker(&frameMutex);
+    stats = VideoOutputStats();
+}
+
+void GLVideoWidget::uploadFrame(QVideoFrame& frame) {
+    frameSize = frame.size();
+
+    if (frame.handleType() == QAbstractVideoBuffer::GLTextureHandle) {
+        // 零拷贝：直接采样后端的纹理（需要共享 GL 上下文）
+        textureWidthRatio = 1.0;
+        swapRedBlue = false;
+
+        QMutexLocker locker(&frameMutex);
+        currentTexture = frame.handle().toUInt();
+        displayedFrame = frame;
+        stats.zeroCopyFrames++;
+        return;
+    }
+
+    if (!frame.map(QAbstractVideoBuffer::ReadOnly)) {
+        qDebug() << "GLVideoWidget: failed to map frame";
+        return;
+    }
+
+    // 行跨度可能大于宽度，整行上传后用纹理坐标裁掉填充部分
+    int strideWidth = frame.bytesPerLine() / 4;
+    textureWidthRatio = strideWidth > 0 ? static_cast<qreal>(frameSize.width()) / strideWidth : 1.0;
+    swapRedBlue = true;
+
+    glBindTexture(GL_TEXTURE_2D, uploadTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, strideWidth, frameSize.height(), 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, frame.bits());
+
+    frame.unmap();
+
+    QMutexLocker locker(&frameMutex);
+    currentTexture = uploadTexture;
+    displayedFrame = QVideoFrame();
+}
+
+void GLVideoWidget::paintGL() {
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    QVideoFrame frame;
+    bool hasNewFrame = false;
+    {
+        QMutexLocker locker(&frameMutex);
+        if (framePending) {
+            frame = pendingFrame;
+            pendingFrame = QVideoFrame();
+            framePending = false;
+            hasNewFrame = true;
+        }
+    }
+
+    if (hasNewFrame) {
+        uploadFrame(frame);
+    }
+
+    // clearFrame 可能在其他线程清掉纹理，取一次快照再画
+    GLuint texture;
+    {
+        QMutexLocker locker(&frameMutex);
+        texture = currentTexture;
+    }
+    if (texture == 0 || frameSize.isEmpty() || !program || !program->isLinked()) {
+        return;
+    }
+
+    drawTexture(texture);
+
+    if (hasNewFrame) {
+        QMutexLocker locker(&frameMutex);
+        stats.framesPresented++;
+    }
+}
+
+void GLVideoWidget::drawTexture(GLuint texture) {
+    // 保持宽高比居中显示
+    qreal widgetAspect = static_cast<qreal>(width()) / qMax(1, height());
+    qreal frameAspect = static_cast<qreal>(frameSize.width()) / qMax(1, frameSize.height());
+    GLfloat sx = 1.0f;
+    GLfloat sy = 1.0f;
+    if (frameAspect > widgetAspect) {
+        sy = static_cast<GLfloat>(widgetAspect / frameAspect);
+    } else {
+        sx = static_cast<GLfloat>(frameAspect / widgetAspect);
+    }
+
+    GLfloat tx = static_cast<GLfloat>(textureWidthRatio);
+    const GLfloat vertices[] = {
+        -sx, -sy,   sx, -sy,   -sx, sy,   sx, sy
+    };
+    const GLfloat texCoords[] = {
+        0.0f, 1.0f,   tx, 1.0f,   0.0f, 0.0f,   tx, 0.0f
+    };
+
+    program->bind();
+    program->setUniformValue("frameTexture", 0);
+    program->setUniformValue("swapRedBlue", static_cast<GLint>(swapRedBlue));
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    program->enableAttributeArray(0);
+    program->enableAttributeArray(1);
+    program->setAttributeArray(0, GL_FLOAT, vertices, 2);
+    program->setAttributeArray(1, GL_FLOAT, texCoords, 2);
+
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    program->disableAttributeArray(0);
+    program->disableAttributeArray(1);
+    program->release();
+}
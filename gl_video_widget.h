@@ -0,0 +1,105 @@
+//
+// GLVideoWidget - 基于 OpenGL 的视频输出
+// Iteration 4: 可替代 QVideoWidget，后端提供 GL 纹理时零拷贝显示，并统计解码/显示/丢帧
+//
+
+#ifndef GL_VIDEO_WIDGET_H
+#define GL_VIDEO_WIDGET_H
+
+#include <QOpenGLWidget>
+#include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+#include <QAbstractVideoSurface>
+#include <QVideoFrame>
+#include <QMutex>
+#include <QSettings>
+
+// 视频输出方式（可在设置中切换）
+namespace VideoOutput {
+enum Mode {
+    Standard = 0,   // QVideoWidget
+    OpenGL = 1      // GLVideoWidget
+};
+
+inline Mode loadMode() {
+    QSettings settings("Tomeo", "PlaybackSettings");
+    return settings.value("videoOutput", Standard).toInt() == OpenGL ? OpenGL : Standard;
+}
+
+inline void saveMode(Mode mode) {
+    QSettings settings("Tomeo", "PlaybackSettings");
+    settings.setValue("videoOutput", static_cast<int>(mode));
+}
+}
+
+// 输出帧统计
+struct VideoOutputStats {
+    qint64 framesDecoded;     // 后端送达表面的帧
+    qint64 framesPresented;   // 实际绘制到屏幕的帧
+    qint64 framesDropped;     // 被下一帧覆盖、未来得及绘制的帧
+    qint64 zeroCopyFrames;    // 直接使用 GL 纹理、未经系统内存的帧
+
+    VideoOutputStats()
+        : framesDecoded(0), framesPresented(0),
+        framesDropped(0), zeroCopyFrames(0) {}
+};
+
+class GLVideoWidget;
+
+class GLVideoSurface : public QAbstractVideoSurface {
+    Q_OBJECT
+
+private:
+    GLVideoWidget* widget;
+
+public:
+    explicit GLVideoSurface(GLVideoWidget* widget);
+
+    QList<QVideoFrame::PixelFormat> supportedPixelFormats(
+        QAbstractVideoBuffer::HandleType type = QAbstractVideoBuffer::NoHandle) const override;
+    bool present(const QVideoFrame& frame) override;
+    void stop() override;
+};
+
+class GLVideoWidget : public QOpenGLWidget, protected QOpenGLFunctions {
+    Q_OBJECT
+
+private:
+    GLVideoSurface* surface;
+    QOpenGLShaderProgram* program;
+    GLuint uploadTexture;
+
+    QMutex frameMutex;
+    QVideoFrame pendingFrame;   // 等待绘制的最新帧
+    bool framePending;
+    VideoOutputStats stats;
+
+    // 上一次绘制使用的帧与纹理，用于重绘（如窗口缩放）；由 frameMutex 保护
+    QVideoFrame displayedFrame;
+    GLuint currentTexture;
+    QSize frameSize;
+    qreal textureWidthRatio;
+    bool swapRedBlue;
+
+    void uploadFrame(QVideoFrame& frame);
+    void drawTexture(GLuint texture);
+
+protected:
+    void initializeGL() override;
+    void paintGL() override;
+
+public:
+    explicit GLVideoWidget(QWidget* parent = nullptr);
+    ~GLVideoWidget();
+
+    QAbstractVideoSurface* videoSurface() const { return surface; }
+
+    VideoOutputStats getStats();
+    void resetStats();
+
+    // 由 GLVideoSurface 调用
+    void queueFrame(const QVideoFrame& frame);
+    void clearFrame();
+};
+
+#endif // GL_VIDEO_WIDGET_H
@@ -0,0 +1,268 @@
+//
+// HoverPreviewManager - 实现
+//
+
+#include "hover_preview_manager.h"
+#include "frame_grabber.h"
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QPainter>
+#include <QStandardPaths>
+#include <algorithm>
+
+HoverPreviewManager* HoverPreviewManager::instance = nullptr;
+
+// 磁盘格式：魔数 + 版本 + 帧间隔 + 帧尺寸 + JPEG 帧列表
+static const quint32 PreviewMagic = 0x544d4850;   // "TMHP"
+static const quint16 PreviewVersion = 1;
+
+// 首屏和拖动预览图优先，延迟后再开始后台生成
+static const int BackgroundStartDelayMs = 3000;
+
+QImage HoverPreview::frameAt(int index) const {
+    if (!isValid()) return QImage();
+    return QImage::fromData(frames.at(qBound(0, index, frames.size() - 1)), "JPG");
+}
+
+int HoverPreview::byteSize() const {
+    int total = 0;
+    for (const QByteArray& frame : frames) {
+        total += frame.size();
+    }
+    return total;
+}
+
+HoverPreviewManager::HoverPreviewManager(QObject* parent)
+    : QObject(parent),
+    useClock(0) {
+
+    cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/hover_previews";
+    QDir().mkpath(cacheDir);
+
+    grabber = new FrameGrabber(this);
+    connect(grabber, &FrameGrabber::started,
+            this, &HoverPreviewManager::onGrabStarted);
+    connect(grabber, &FrameGrabber::frameReady,
+            this, &HoverPreviewManager::onFrameReady);
+    connect(grabber, &FrameGrabber::finished,
+            this, &HoverPreviewManager::onGrabFinished);
+
+    startDelay = new QTimer(this);
+    startDelay->setSingleShot(true);
+    connect(startDelay, &QTimer::timeout, this, &HoverPreviewManager::startNext);
+    startDelay->start(BackgroundStartDelayMs);
+
+    qDebug() << "HoverPreviewManager initialized, cache:" << cacheDir;
+
+    MemoryBudget::getInstance()->registerConsumer(this);
+}
+
+HoverPreviewManager* HoverPreviewManager::getInstance() {
+    if (instance == nullptr) {
+        instance = new HoverPreviewManager();
+    }
+    return instance;
+}
+
+// 缓存键包含路径、大小和修改时间，文件被替换后自动失效
+QString HoverPreviewManager::cacheKey(const QUrl& url) const {
+    QFileInfo info(url.toLocalFile());
+    QString source = QString("%1|%2|%3")
+                         .arg(info.absoluteFilePath())
+                         .arg(info.size())
+                         .arg(info.lastModified().toMSecsSinceEpoch());
+    return QString::fromLatin1(
+        QCryptographicHash::hash(source.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+QString HoverPreviewManager::cachePath(const QString& key) const {
+    return cacheDir + "/" + key + ".preview";
+}
+
+bool HoverPreviewManager::loadFromDisk(const QString& key) {
+    QFile file(cachePath(key));
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint16 version = 0;
+    qint32 intervalMs = 0;
+    HoverPreview preview;
+    in >> magic >> version >> intervalMs >> preview.frameSize >> preview.frames;
+    preview.frameIntervalMs = intervalMs;
+
+    if (in.status() != QDataStream::Ok || magic != PreviewMagic ||
+        version != PreviewVersion || !preview.isValid()) {
+        qDebug() << "Discarding invalid hover preview cache:" << file.fileName();
+        file.close();
+        QFile::remove(cachePath(key));
+        return false;
+    }
+
+    storePreview(key, preview);
+    return true;
+}
+
+void HoverPreviewManager::saveToDisk(const QString& key, const HoverPreview& preview) {
+    QFile file(cachePath(key));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "Failed to save hover preview:" << file.fileName();
+        return;
+    }
+
+    QDataStream out(&file);
+    out << PreviewMagic << PreviewVersion << qint32(preview.frameIntervalMs)
+        << preview.frameSize << preview.frames;
+}
+
+void HoverPreviewManager::storePreview(const QString& key, const HoverPreview& preview) {
+    previews.insert(key, preview);
+    lastUsed.insert(key, ++useClock);
+    MemoryBudget::getInstance()->notifyGrowth();
+}
+
+void HoverPreviewManager::requestPreview(const QUrl& url, bool urgent) {
+    if (!url.isLocalFile() || hasPreview(url)) return;
+
+    // 预生成只确认磁盘缓存存在，读取推迟到悬停（urgent）时，初始化网格时不逐个读盘
+    QString key = cacheKey(url);
+    if (failed.contains(key)) return;
+    if (QFile::exists(cachePath(key))) {
+        if (!urgent) return;
+        if (loadFromDisk(key)) {
+            emit previewReady(url);
+            return;
+        }
+        // 缓存损坏时 loadFromDisk 已删除文件，下面重新生成
+    }
+
+    if (url == activeUrl) return;
+
+    pending.removeAll(url);
+    if (urgent) {
+        // 用户正在悬停：不再等待启动延迟
+        pending.prepend(url);
+        startDelay->stop();
+    } else {
+        pending.append(url);
+    }
+
+    if (!startDelay->isActive()) {
+        startNext();
+    }
+}
+
+bool HoverPreviewManager::hasPreview(const QUrl& url) const {
+    return url.isLocalFile() && previews.contains(cacheKey(url));
+}
+
+HoverPreview HoverPreviewManager::getPreview(const QUrl& url) const {
+    if (!url.isLocalFile()) return HoverPreview();
+
+    QString key = cacheKey(url);
+    auto it = previews.constFind(key);
+    if (it == previews.constEnd()) return HoverPreview();
+
+    lastUsed.insert(key, ++useClock);
+    return it.value();
+}
+
+qint64 HoverPreviewManager::memoryUsage() const {
+    qint64 total = 0;
+    for (const HoverPreview& preview : previews) {
+        total += preview.byteSize();
+    }
+    return total;
+}
+
+qint64 HoverPreviewManager::releaseMemory(qint64 bytes, EvictionPass pass) {
+    // 最久未用的在前
+    QVector<QPair<quint64, QString>> order;
+    order.reserve(previews.size());
+    for (auto it = previews.constBegin(); it != previews.constEnd(); ++it) {
+        order.append(qMakePair(lastUsed.value(it.key()), it.key()));
+    }
+    std::sort(order.begin(), order.end());
+
+    qint64 released = 0;
+    for (const auto& entry : order) {
+        if (released >= bytes) break;
+
+        // 按钮悬停时持有帧列表的共享副本
+        auto found = previews.find(entry.second);
+        if (pass == Invisible && !found.value().frames.isDetached()) continue;
+
+        released += found.value().byteSize();
+        previews.erase(found);
+        lastUsed.remove(entry.second);
+    }
+    return released;
+}
+
+void HoverPreviewManager::startNext() {
+    if (grabber->isBusy() || pending.isEmpty()) return;
+
+    activeUrl = pending.takeFirst();
+    activeFrames.clear();
+
+    // 间隔取 1ms，FrameGrabber 会把帧数限制在 FrameCount 并拉伸间隔覆盖整段视频
+    grabber->start(activeUrl, QSize(FrameWidth, FrameHeight), 1, FrameCount);
+}
+
+void HoverPreviewManager::onGrabStarted(qint64 duration, qint64 intervalMs, int frameCount) {
+    Q_UNUSED(duration);
+    Q_UNUSED(intervalMs);
+    activeFrames.resize(frameCount);
+}
+
+void HoverPreviewManager::onFrameReady(int index, const QImage& frame) {
+    if (index < 0 || index >= activeFrames.size()) return;
+
+    // 居中放到固定尺寸的黑底上，播放时各帧大小一致
+    QImage canvas(FrameWidth, FrameHeight, QImage::Format_RGB32);
+    canvas.fill(Qt::black);
+    QPainter painter(&canvas);
+    painter.drawImage(QPoint((FrameWidth - frame.width()) / 2,
+                             (FrameHeight - frame.height()) / 2), frame);
+    painter.end();
+
+    QBuffer buffer(&activeFrames[index]);
+    buffer.open(QIODevice::WriteOnly);
+    canvas.save(&buffer, "JPG", JpegQuality);
+}
+
+void HoverPreviewManager::onGrabFinished(bool ok) {
+    // 超时跳过的时间点没有帧，直接去掉
+    HoverPreview preview;
+    for (const QByteArray& frame : activeFrames) {
+        if (!frame.isEmpty()) {
+            preview.frames.append(frame);
+        }
+    }
+    preview.frameSize = QSize(FrameWidth, FrameHeight);
+    preview.frameIntervalMs = FrameIntervalMs;
+
+    if (ok && preview.isValid()) {
+        QString key = cacheKey(activeUrl);
+        storePreview(key, preview);
+        saveToDisk(key, preview);
+
+        qDebug() << "Hover preview ready:" << activeUrl.fileName()
+                 << preview.frameCount() << "frames," << preview.byteSize() / 1024 << "KB";
+        emit previewReady(activeUrl);
+    } else {
+        // 文件被替换后缓存键变化，会重新尝试
+        failed.insert(cacheKey(activeUrl));
+        qDebug() << "Hover preview failed:" << activeUrl.fileName() << "- not retrying this session";
+    }
+
+    activeUrl = QUrl();
+    activeFrames.clear();
+    startNext();
+}
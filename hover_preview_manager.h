@@ -0,0 +1,96 @@
+//
+// HoverPreviewManager - 缩略图悬停预览循环
+// Iteration 4: 后台从整段视频中均匀抽取少量低分辨率帧，JPEG 压缩后持久化到磁盘；
+//              悬停时直接从内存播放，不再打开原始视频
+//
+
+#ifndef HOVER_PREVIEW_MANAGER_H
+#define HOVER_PREVIEW_MANAGER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QSet>
+#include <QSize>
+#include <QTimer>
+#include <QUrl>
+#include <QVector>
+#include "memory_budget.h"
+
+class FrameGrabber;
+
+// 一段预览循环：帧以 JPEG 字节保存，播放时逐帧解码
+struct HoverPreview {
+    QVector<QByteArray> frames;
+    QSize frameSize;
+    int frameIntervalMs;
+
+    HoverPreview() : frameIntervalMs(0) {}
+
+    bool isValid() const { return !frames.isEmpty() && frameIntervalMs > 0; }
+    int frameCount() const { return frames.size(); }
+    QImage frameAt(int index) const;
+    int byteSize() const;
+};
+
+class HoverPreviewManager : public QObject, public MemoryConsumer {
+    Q_OBJECT
+
+private:
+    static HoverPreviewManager* instance;
+
+    FrameGrabber* grabber;
+    QHash<QString, HoverPreview> previews;   // 缓存键 -> 预览
+    mutable QHash<QString, quint64> lastUsed;   // 缓存键 -> 最近使用的序号
+    mutable quint64 useClock;
+    QList<QUrl> pending;                     // 等待生成的视频
+    QSet<QString> failed;                    // 生成失败的缓存键，本次会话不再打开原文件重试
+    QString cacheDir;
+    QTimer* startDelay;                      // 启动后稍等，避开首屏和拖动预览图生成
+
+    // 正在生成的预览
+    QUrl activeUrl;
+    QVector<QByteArray> activeFrames;
+
+    explicit HoverPreviewManager(QObject* parent = nullptr);
+
+    QString cacheKey(const QUrl& url) const;
+    QString cachePath(const QString& key) const;
+    bool loadFromDisk(const QString& key);
+    void saveToDisk(const QString& key, const HoverPreview& preview);
+    void storePreview(const QString& key, const HoverPreview& preview);
+    void startNext();
+
+public:
+    // 单例模式
+    static HoverPreviewManager* getInstance();
+
+    // 预览参数：16 帧 × 250ms，约 4 秒一个循环
+    static const int FrameWidth = 200;
+    static const int FrameHeight = 110;
+    static const int FrameCount = 16;
+    static const int FrameIntervalMs = 250;
+    static const int JpegQuality = 70;
+
+    // 请求生成；已有磁盘缓存时只在 urgent 下读入内存。urgent 为 true 时插队到队首并立即开始
+    void requestPreview(const QUrl& url, bool urgent = false);
+    bool hasPreview(const QUrl& url) const;
+    HoverPreview getPreview(const QUrl& url) const;
+
+    // MemoryConsumer：磁盘上有缓存，释放后悬停时重新读取；正在播放的预览视为可见
+    QString memoryName() const override { return "hover previews"; }
+    qint64 memoryUsage() const override;
+    qint64 releaseMemory(qint64 bytes, EvictionPass pass) override;
+
+private slots:
+    void onGrabStarted(qint64 duration, qint64 intervalMs, int frameCount);
+    void onFrameReady(int index, const QImage& frame);
+    void onGrabFinished(bool ok);
+
+signals:
+    void previewReady(const QUrl& url);
+};
+
+#endif // HOVER_PREVIEW_MANAGER_H
@@ -0,0 +1,198 @@
+//
+// HttpSocialDataSource - 实现
+//
+
+#include "http_social_data_source.h"
+#include "social_json.h"
+#include <QDebug>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkDiskCache>
+#include <QNetworkRequest>
+#include <QStandardPaths>
+#include <QUrlQuery>
+
+const char* HttpSocialDataSource::CommandLineFlag = "--feed-url";
+
+// 磁盘缓存上限
+static const qint64 HttpCacheBytes = 50 * 1024 * 1024;
+
+HttpSocialDataSource::HttpSocialDataSource(const QUrl& url, int size, QObject* parent)
+    : SocialDataSource(parent),
+    baseUrl(url),
+    pageSize(size),
+    lastRequestId(0) {
+
+    network = new QNetworkAccessManager(this);
+
+    // QNetworkAccessManager 按 Cache-Control 判断是否新鲜，过期后带 If-None-Match 重新验证
+    QNetworkDiskCache* cache = new QNetworkDiskCache(this);
+    QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/http";
+    QDir().mkpath(cacheDir);
+    cache->setCacheDirectory(cacheDir);
+    cache->setMaximumCacheSize(HttpCacheBytes);
+    network->setCache(cache);
+
+    qDebug() << "HttpSocialDataSource: base URL" << baseUrl.toString()
+             << "cache" << cacheDir;
+}
+
+QUrl HttpSocialDataSource::endpoint(const QString& path) const {
+    QUrl url = baseUrl;
+    QString basePath = url.path();
+    if (basePath.endsWith('/')) basePath.chop(1);
+    url.setPath(basePath + path);
+    return url;
+}
+
+quint64 HttpSocialDataSource::fetchPosts(const QString& cursor, int limit) {
+    QUrl url = endpoint("/posts");
+    QUrlQuery query;
+    if (!cursor.isEmpty()) {
+        query.addQueryItem("cursor", cursor);
+    }
+    query.addQueryItem("limit", QString::number(limit > 0 ? limit : pageSize));
+    url.setQuery(query);
+    return request(url, PostsRequest);
+}
+
+quint64 HttpSocialDataSource::fetchComments(const QString& postId) {
+    QUrl url = endpoint("/posts/" + QString::fromUtf8(QUrl::toPercentEncoding(postId)) + "/comments");
+    return request(url, CommentsRequest, postId);
+}
+
+quint64 HttpSocialDataSource::fetchFriends() {
+    return request(endpoint("/friends"), FriendsRequest);
+}
+
+// 写请求不合并、不缓存，每次都单独发送
+quint64 HttpSocialDataSource::postMutations(const QJsonArray& mutations) {
+    quint64 requestId = ++lastRequestId;
+
+    QNetworkRequest networkRequest(endpoint("/mutations"));
+    networkRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    networkRequest.setRawHeader("Accept", "application/json");
+
+    QJsonObject payload;
+    payload["mutations"] = mutations;
+
+    InFlight entry;
+    entry.reply = network->post(networkRequest, QJsonDocument(payload).toJson(QJsonDocument::Compact));
+    entry.kind = MutationsRequest;
+    entry.requestIds.append(requestId);
+
+    QString key = QString("POST#%1").arg(requestId);
+    inFlight.insert(key, entry);
+
+    entry.reply->setProperty("inFlightKey", key);
+    connect(entry.reply, &QNetworkReply::finished, this, &HttpSocialDataSource::onReplyFinished);
+    return requestId;
+}
+
+quint64 HttpSocialDataSource::request(const QUrl& url, RequestKind kind, const QString& postId) {
+    quint64 requestId = ++lastRequestId;
+    QString key = url.toString(QUrl::FullyEncoded);
+
+    // 相同 URL 已在途：不再发请求，只登记编号
+    auto it = inFlight.find(key);
+    if (it != inFlight.end()) {
+        it->requestIds.append(requestId);
+        qDebug() << "HttpSocialDataSource: coalesced request" << requestId << "into" << key;
+        return requestId;
+    }
+
+    QNetworkRequest networkRequest(url);
+    networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute,
+                                QNetworkRequest::PreferNetwork);
+    networkRequest.setRawHeader("Accept", "application/json");
+
+    InFlight entry;
+    entry.reply = network->get(networkRequest);
+    entry.kind = kind;
+    entry.postId = postId;
+    entry.requestIds.append(requestId);
+    inFlight.insert(key, entry);
+
+    entry.reply->setProperty("inFlightKey", key);
+    connect(entry.reply, &QNetworkReply::finished, this, &HttpSocialDataSource::onReplyFinished);
+    return requestId;
+}
+
+void HttpSocialDataSource::onReplyFinished() {
+    QNetworkReply* reply = qobject_cast<QNetworkReply*>(sender());
+    if (!reply) return;
+    reply->deleteLater();
+
+    InFlight entry = inFlight.take(reply->property("inFlightKey").toString());
+    if (entry.requestIds.isEmpty()) return;
+
+    if (reply->error() != QNetworkReply::NoError) {
+        QString error = reply->errorString();
+        for (quint64 requestId : entry.requestIds) {
+            emit requestFailed(requestId, error);
+        }
+        return;
+    }
+
+    bool fromCache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+    qDebug() << "HttpSocialDataSource:" << reply->url().toString()
+             << (fromCache ? "(cache)" : "(network)");
+
+    deliver(entry, reply->readAll());
+}
+
+void HttpSocialDataSource::deliver(const InFlight& entry, const QByteArray& body) {
+    QJsonParseError parseError;
+    QJsonObject result = QJsonDocument::fromJson(body, &parseError).object();
+    if (parseError.error != QJsonParseError::NoError) {
+        for (quint64 requestId : entry.requestIds) {
+            emit requestFailed(requestId, tr("Invalid response: %1").arg(parseError.errorString()));
+        }
+        return;
+    }
+
+    // 只解析一次，再分发给所有合并的请求
+    switch (entry.kind) {
+    case PostsRequest: {
+        SocialPostPage page;
+        page.posts = SocialJson::postsFromJson(result["posts"].toArray());
+        page.cursor = result["cursor"].toString();
+        page.nextCursor = result["nextCursor"].toString();
+        for (quint64 requestId : entry.requestIds) {
+            emit postsFetched(requestId, page);
+        }
+        break;
+    }
+    case CommentsRequest: {
+        QVector<Comment> comments = SocialJson::commentsFromJson(result["comments"].toArray());
+        for (quint64 requestId : entry.requestIds) {
+            emit commentsFetched(requestId, entry.postId, comments);
+        }
+        break;
+    }
+    case FriendsRequest: {
+        QVector<UserInfo> friends = SocialJson::usersFromJson(result["friends"].toArray());
+        for (quint64 requestId : entry.requestIds) {
+            emit friendsFetched(requestId, friends);
+        }
+        break;
+    }
+    case MutationsRequest:
+        for (quint64 requestId : entry.requestIds) {
+            emit mutationsPosted(requestId, result["results"].toArray());
+        }
+        break;
+    }
+}
+
+QUrl HttpSocialDataSource::baseUrlFromArguments(int argc, char* argv[]) {
+    QString prefix = QString(CommandLineFlag) + "=";
+    for (int i = 1; i < argc; i++) {
+        QString argument = QString::fromLocal8Bit(argv[i]);
+        if (argument.startsWith(prefix)) {
+            return QUrl(argument.mid(prefix.size()));
+        }
+    }
+    return QUrl();
+}
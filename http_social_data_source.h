@@ -0,0 +1,66 @@
+//
+// HttpSocialDataSource - 基于 HTTP 的社交数据源
+// Iteration 4: QNetworkAccessManager 异步分页获取帖子，合并相同的在途请求，
+//              通过磁盘缓存遵循 ETag / Cache-Control
+//
+
+#ifndef HTTP_SOCIAL_DATA_SOURCE_H
+#define HTTP_SOCIAL_DATA_SOURCE_H
+
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QUrl>
+#include <QVector>
+#include "social_data_source.h"
+
+class HttpSocialDataSource : public SocialDataSource {
+    Q_OBJECT
+
+private:
+    enum RequestKind {
+        PostsRequest,
+        CommentsRequest,
+        FriendsRequest,
+        MutationsRequest
+    };
+
+    // 同一 URL 的请求共用一个 reply，结果分发给所有请求编号
+    struct InFlight {
+        QNetworkReply* reply;
+        RequestKind kind;
+        QString postId;
+        QVector<quint64> requestIds;
+    };
+
+    QNetworkAccessManager* network;
+    QUrl baseUrl;
+    int pageSize;
+    quint64 lastRequestId;
+    QHash<QString, InFlight> inFlight;   // URL -> 在途请求
+
+    QUrl endpoint(const QString& path) const;
+    quint64 request(const QUrl& url, RequestKind kind, const QString& postId = QString());
+    void deliver(const InFlight& entry, const QByteArray& body);
+
+public:
+    static const char* CommandLineFlag;   // --feed-url=<base url>
+
+    explicit HttpSocialDataSource(const QUrl& baseUrl, int pageSize = 20, QObject* parent = nullptr);
+
+    QString name() const override { return "http"; }
+    quint64 fetchPosts(const QString& cursor, int limit) override;
+    quint64 fetchComments(const QString& postId) override;
+    quint64 fetchFriends() override;
+    quint64 postMutations(const QJsonArray& mutations) override;
+
+    int inFlightCount() const { return inFlight.size(); }
+
+    // 从命令行读取 --feed-url，未指定时返回空 URL
+    static QUrl baseUrlFromArguments(int argc, char* argv[]);
+
+private slots:
+    void onReplyFinished();
+};
+
+#endif // HTTP_SOCIAL_DATA_SOURCE_H
@@ -0,0 +1,154 @@
+//
+// ImageDecodePool - 实现
+//
+
+#include "image_decode_pool.h"
+#include <QDebug>
+#include <QImageReader>
+#include <QPair>
+#include <QThread>
+#include <QVector>
+#include <algorithm>
+
+ImageDecodePool* ImageDecodePool::instance = nullptr;
+
+// 默认缓存 48MB：约 90 张 368x300@2x 的卡片缩略图
+static const int DefaultCacheKilobytes = 48 * 1024;
+
+ImageDecodePool::ImageDecodePool(QObject* parent)
+    : QObject(parent),
+    cacheCost(0),
+    maxCacheCost(DefaultCacheKilobytes),
+    useClock(0) {
+
+    // 留出核心给 UI 线程和视频解码
+    pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() / 2));
+
+    qDebug() << "ImageDecodePool:" << pool.maxThreadCount() << "threads,"
+             << DefaultCacheKilobytes / 1024 << "MB cache";
+
+    MemoryBudget::getInstance()->registerConsumer(this);
+}
+
+ImageDecodePool* ImageDecodePool::getInstance() {
+    if (instance == nullptr) {
+        instance = new ImageDecodePool();
+    }
+    return instance;
+}
+
+QString ImageDecodePool::cacheKey(const QString& path, const QSize& logicalSize, qreal devicePixelRatio) {
+    QSize pixelSize = logicalSize * devicePixelRatio;
+    return QString("%1@%2x%3").arg(path).arg(pixelSize.width()).arg(pixelSize.height());
+}
+
+bool ImageDecodePool::fetch(const QString& path, const QSize& logicalSize,
+                            qreal devicePixelRatio, QPixmap* pixmap) {
+    QString key = cacheKey(path, logicalSize, devicePixelRatio);
+
+    auto cached = cache.find(key);
+    if (cached != cache.end()) {
+        cached->lastUsed = ++useClock;
+        *pixmap = cached->pixmap;
+        return true;
+    }
+
+    if (inFlight.contains(key) || failed.contains(key)) {
+        return false;
+    }
+    inFlight.insert(key);
+
+    QSize pixelSize = logicalSize * devicePixelRatio;
+    pool.start([this, key, path, pixelSize, devicePixelRatio]() {
+        QImage image = decodeScaled(path, pixelSize);
+        QMetaObject::invokeMethod(this, [this, key, image, devicePixelRatio]() {
+            onDecoded(key, image, devicePixelRatio);
+        }, Qt::QueuedConnection);
+    });
+    return false;
+}
+
+QImage ImageDecodePool::decodeScaled(const QString& path, const QSize& pixelSize) {
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+
+    // JPEG 等格式可在解码阶段直接降采样，其余格式解码后立即缩小，不保留原图
+    if (pixelSize.isValid() && !pixelSize.isEmpty()) {
+        reader.setScaledSize(pixelSize);
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qDebug() << "ImageDecodePool: failed to decode" << path << ":" << reader.errorString();
+    }
+    return image;
+}
+
+void ImageDecodePool::onDecoded(const QString& key, const QImage& image, qreal devicePixelRatio) {
+    inFlight.remove(key);
+
+    if (image.isNull()) {
+        failed.insert(key);
+        emit imageDecoded(key, QPixmap());
+        return;
+    }
+
+    CacheEntry entry;
+    entry.pixmap = QPixmap::fromImage(image);
+    entry.pixmap.setDevicePixelRatio(devicePixelRatio);
+    entry.cost = qMax(1, int(image.sizeInBytes() / 1024));
+    entry.lastUsed = ++useClock;
+    QPixmap result = entry.pixmap;
+
+    // 超过单条上限的图片不缓存（与 QCache 一致）
+    if (entry.cost <= maxCacheCost) {
+        cacheCost += entry.cost;
+        cache.insert(key, entry);
+        evictTo(maxCacheCost, false);
+        MemoryBudget::getInstance()->notifyGrowth();
+    }
+
+    emit imageDecoded(key, result);
+}
+
+void ImageDecodePool::setCacheLimit(int kilobytes) {
+    maxCacheCost = qMax(0, kilobytes);
+    evictTo(maxCacheCost, false);
+}
+
+void ImageDecodePool::clearCache() {
+    cache.clear();
+    cacheCost = 0;
+}
+
+void ImageDecodePool::evictTo(int limit, bool onlyUnused) {
+    if (cacheCost <= limit) return;
+
+    QVector<QPair<quint64, QString>> order;
+    order.reserve(cache.size());
+    for (auto it = cache.constBegin(); it != cache.constEnd(); ++it) {
+        order.append(qMakePair(it->lastUsed, it.key()));
+    }
+    std::sort(order.begin(), order.end());
+
+    for (const auto& item : order) {
+        if (cacheCost <= limit) break;
+
+        // QLabel 等控件持有的是共享副本；只剩缓存一份时说明已不在屏幕上
+        auto it = cache.find(item.second);
+        if (onlyUnused && !it->pixmap.isDetached()) continue;
+
+        cacheCost -= it->cost;
+        cache.erase(it);
+    }
+}
+
+qint64 ImageDecodePool::releaseMemory(qint64 bytes, EvictionPass pass) {
+    qint64 before = memoryUsage();
+
+    // 两轮都从最久未用的开始；检查是否仍在显示不会改变使用顺序
+    int kilobytes = int((bytes + 1023) / 1024);
+    evictTo(qMax(0, cacheCost - kilobytes), pass == Invisible);
+
+    return before - memoryUsage();
+}
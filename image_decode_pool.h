@@ -0,0 +1,78 @@
+//
+// ImageDecodePool - 缩略图解码线程池
+// Iteration 4: 在后台线程用 QImageReader::setScaledSize() 直接解码到显示尺寸，
+//              按（文件, 像素尺寸）缓存，相同请求只解码一次
+//
+
+#ifndef IMAGE_DECODE_POOL_H
+#define IMAGE_DECODE_POOL_H
+
+#include <QObject>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QSet>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+#include "memory_budget.h"
+
+class ImageDecodePool : public QObject, public MemoryConsumer {
+    Q_OBJECT
+
+private:
+    static ImageDecodePool* instance;
+
+    // 自行维护 LRU：QCache 的任何查找都会刷新最近使用顺序，
+    // 释放内存时检查条目是否仍被控件持有会打乱淘汰顺序
+    struct CacheEntry {
+        QPixmap pixmap;
+        int cost;             // KB
+        quint64 lastUsed;     // 最近使用的序号
+    };
+
+    QThreadPool pool;
+    QHash<QString, CacheEntry> cache;
+    int cacheCost;
+    int maxCacheCost;
+    quint64 useClock;
+    QSet<QString> inFlight;           // 正在解码的 key，重复请求直接合并
+    QSet<QString> failed;             // 解码失败的 key，不再重复尝试
+
+    explicit ImageDecodePool(QObject* parent = nullptr);
+
+    // 按最久未用的顺序淘汰，直到总代价不超过 limit；onlyUnused 为 true 时跳过仍被控件持有的条目
+    void evictTo(int limit, bool onlyUnused);
+
+    // 工作线程中运行；QImage 可跨线程传递，QPixmap 只在 GUI 线程创建
+    static QImage decodeScaled(const QString& path, const QSize& pixelSize);
+
+private slots:
+    void onDecoded(const QString& key, const QImage& image, qreal devicePixelRatio);
+
+public:
+    static ImageDecodePool* getInstance();
+
+    // logicalSize 为控件上的显示尺寸，实际按 logicalSize * devicePixelRatio 解码
+    static QString cacheKey(const QString& path, const QSize& logicalSize, qreal devicePixelRatio);
+
+    // 命中缓存时写入 pixmap 并返回 true；否则排队解码，完成后发出 imageDecoded
+    bool fetch(const QString& path, const QSize& logicalSize, qreal devicePixelRatio, QPixmap* pixmap);
+
+    void setCacheLimit(int kilobytes);
+    int cacheLimit() const { return maxCacheCost; }
+    int cacheUsage() const { return cacheCost; }
+    void clearCache();
+
+    // MemoryConsumer：只被缓存持有（没有控件在显示）的缩略图视为不可见
+    QString memoryName() const override { return "thumbnails"; }
+    qint64 memoryUsage() const override { return qint64(cacheCost) * 1024; }
+    int memoryPriority() const override { return 1; }
+    qint64 releaseMemory(qint64 bytes, EvictionPass pass) override;
+
+signals:
+    // 解码失败时 pixmap 为空
+    void imageDecoded(const QString& key, const QPixmap& pixmap);
+};
+
+#endif // IMAGE_DECODE_POOL_H
@@ -0,0 +1,168 @@
+//
+// InlinePlaybackPool - 实现
+//
+
+#include "inline_playback_pool.h"
+#include "video_post_card.h"
+#include "media_session_pool.h"
+#include <QDebug>
+#include <QSettings>
+
+// 同时解码的预览数上限；默认 2 路
+static const int MaxInlinePlayers = 3;
+static const int DefaultInlinePlayers = 2;
+
+InlinePlaybackPool::InlinePlaybackPool(int size, QObject* parent)
+    : QObject(parent),
+    capacity(qBound(0, size, MaxInlinePlayers)) {
+
+    qDebug() << "InlinePlaybackPool: capacity" << capacity;
+}
+
+InlinePlaybackPool::~InlinePlaybackPool() {
+    for (InlinePlayer* entry : players) {
+        release(entry);
+        // 输出控件可能挂在卡片上，直接删除会自动从父控件移除
+        delete entry->output.data();
+        delete entry;
+    }
+}
+
+int InlinePlaybackPool::loadCapacity() {
+    QSettings settings("Tomeo", "PlaybackSettings");
+    return qBound(0, settings.value("inlinePreviewPlayers", DefaultInlinePlayers).toInt(),
+                  MaxInlinePlayers);
+}
+
+void InlinePlaybackPool::saveCapacity(int size) {
+    QSettings settings("Tomeo", "PlaybackSettings");
+    settings.setValue("inlinePreviewPlayers", qBound(0, size, MaxInlinePlayers));
+}
+
+int InlinePlaybackPool::activeCount() const {
+    int count = 0;
+    for (InlinePlayer* entry : players) {
+        if (entry->player) count++;
+    }
+    return count;
+}
+
+InlinePlaybackPool::InlinePlayer* InlinePlaybackPool::playerFor(VideoPostCard* card) const {
+    for (InlinePlayer* entry : players) {
+        if (entry->card == card) return entry;
+    }
+    return nullptr;
+}
+
+InlinePlaybackPool::InlinePlayer* InlinePlaybackPool::freePlayer() {
+    for (InlinePlayer* entry : players) {
+        if (!entry->card) {
+            // 卡片已被销毁时播放器可能还在槽位上，先还给会话池
+            release(entry);
+            return entry;
+        }
+    }
+
+    if (players.size() >= capacity) {
+        return nullptr;
+    }
+
+    // 第一次需要时才创建槽位，之后一直复用
+    InlinePlayer* entry = new InlinePlayer;
+    players.append(entry);
+    qDebug() << "InlinePlaybackPool: created slot" << players.size() << "of" << capacity;
+    return entry;
+}
+
+void InlinePlaybackPool::assign(const QVector<VideoPostCard*>& wanted) {
+    QVector<VideoPostCard*> targets = wanted.mid(0, capacity);
+
+    // 先释放不再需要的播放器，再分配给新卡片，任何时刻都不超过上限
+    for (InlinePlayer* entry : players) {
+        if (entry->card && !targets.contains(entry->card.data())) {
+            release(entry);
+        }
+    }
+
+    for (VideoPostCard* card : targets) {
+        if (playerFor(card)) continue;
+
+        QUrl url = card->getPost().videoUrl;
+        if (url.isEmpty() || failedUrls.contains(url)) continue;
+
+        InlinePlayer* entry = freePlayer();
+        if (!entry) break;
+
+        QWidget* host = card->inlineVideoHost();
+        if (!entry->output) {
+            entry->output = new QVideoWidget();
+            entry->output->setAspectRatioMode(Qt::IgnoreAspectRatio);
+        }
+
+        // 挂到缩略图下层，播放按钮和标记仍在上面
+        entry->output->hide();
+        entry->output->setParent(host);
+        entry->output->setGeometry(host->rect());
+        entry->output->lower();
+
+        entry->card = card;
+        entry->player = MediaSessionPool::getInstance()->acquire(url);
+        entry->player->setMuted(true);
+        entry->player->setVideoOutput(entry->output.data());
+
+        // 首帧就绪前保持缩略图可见，避免黑屏闪烁；播完从头循环
+        QMediaPlayer* player = entry->player;
+        connect(player, &QMediaPlayer::mediaStatusChanged, this, [entry](QMediaPlayer::MediaStatus status) {
+            if (!entry->card || !entry->player) return;
+            if ((status == QMediaPlayer::BufferedMedia || status == QMediaPlayer::LoadedMedia) &&
+                entry->output) {
+                entry->output->show();
+            } else if (status == QMediaPlayer::EndOfMedia) {
+                entry->player->setPosition(0);
+                entry->player->play();
+            }
+        });
+        connect(player, QOverload<QMediaPlayer::Error>::of(&QMediaPlayer::error), this, [this, entry]() {
+            if (!entry->card || !entry->player) return;
+            qDebug() << "InlinePlaybackPool: preview failed:" << entry->player->errorString();
+            failedUrls.insert(entry->card->getPost().videoUrl);
+            release(entry);
+        });
+
+        player->play();
+
+        qDebug() << "InlinePlaybackPool: autoplay" << card->getPost().postId;
+    }
+}
+
+void InlinePlaybackPool::release(InlinePlayer* entry) {
+    if (!entry->player) return;
+
+    if (entry->card) {
+        qDebug() << "InlinePlaybackPool: stop" << entry->card->getPost().postId;
+    }
+
+    // 播放器还给会话池（媒体被清空、解码器释放，播放器后端留给同族视频复用），输出控件从卡片上摘下等待复用
+    disconnect(entry->player, nullptr, this, nullptr);
+    entry->player->setVideoOutput(static_cast<QVideoWidget*>(nullptr));
+    MediaSessionPool::getInstance()->release(entry->player);
+    entry->player = nullptr;
+    if (entry->output) {
+        entry->output->hide();
+        entry->output->setParent(nullptr);
+    }
+    entry->card = nullptr;
+}
+
+void InlinePlaybackPool::detach(VideoPostCard* card) {
+    InlinePlayer* entry = playerFor(card);
+    if (entry) {
+        release(entry);
+    }
+}
+
+void InlinePlaybackPool::detachAll() {
+    for (InlinePlayer* entry : players) {
+        release(entry);
+    }
+}
@@ -0,0 +1,60 @@
+//
+// InlinePlaybackPool - Feed 内联自动播放的播放器池
+// Iteration 4: 固定数量的静音播放槽位在可见卡片之间复用，
+//              播放器从 MediaSessionPool 按编码族借出，不会同时解码超过上限的视频
+//
+
+#ifndef INLINE_PLAYBACK_POOL_H
+#define INLINE_PLAYBACK_POOL_H
+
+#include <QObject>
+#include <QMediaPlayer>
+#include <QPointer>
+#include <QSet>
+#include <QUrl>
+#include <QVector>
+#include <QVideoWidget>
+
+class VideoPostCard;
+
+class InlinePlaybackPool : public QObject {
+    Q_OBJECT
+
+private:
+    // 一个播放槽位及其输出；output 挂到卡片的缩略图区域上显示，
+    // player 在播放期间从 MediaSessionPool 借出
+    struct InlinePlayer {
+        QMediaPlayer* player;
+        QPointer<QVideoWidget> output;
+        QPointer<VideoPostCard> card;
+
+        InlinePlayer() : player(nullptr) {}
+    };
+
+    QVector<InlinePlayer*> players;   // 按需创建，数量不超过 capacity
+    int capacity;
+    QSet<QUrl> failedUrls;            // 无法播放的视频不再反复尝试
+
+    InlinePlayer* playerFor(VideoPostCard* card) const;
+    InlinePlayer* freePlayer();
+    void release(InlinePlayer* entry);
+
+public:
+    explicit InlinePlaybackPool(int capacity, QObject* parent = nullptr);
+    ~InlinePlaybackPool();
+
+    // 播放器数量保存在 QSettings("Tomeo", "PlaybackSettings")，0 表示关闭自动播放
+    static int loadCapacity();
+    static void saveCapacity(int capacity);
+
+    int getCapacity() const { return capacity; }
+    int activeCount() const;
+    bool isAttached(VideoPostCard* card) const { return playerFor(card) != nullptr; }
+
+    // 让 wanted 中的卡片（按优先级排序）播放，其余卡片全部停止；超出上限的忽略
+    void assign(const QVector<VideoPostCard*>& wanted);
+    void detach(VideoPostCard* card);
+    void detachAll();
+};
+
+#endif // INLINE_PLAYBACK_POOL_H
@@ -2,22 +2,49 @@
 #include "design_system.h"
 #include "settings_dialog.h" // [修复] 引入设置对话框
 #include "comment_dialog.h"  // [修复] 引入评论对话框
+#include "video_diagnostics_dialog.h"
 
+#include <QApplication>
 #include <QDebug>
 #include <QLabel>
 #include <QMessageBox>
 #include <QGraphicsDropShadowEffect>
+#include <QScrollBar>
+#include <QElapsedTimer>
 
 MainContainer::MainContainer(std::vector<TheButtonInfo>& videos, QWidget* parent)
-    : QWidget(parent), recordDialog(nullptr) {
+    : QWidget(parent),
+    socialPage(nullptr),
+    messagesPage(nullptr),
+    profilePage(nullptr),
+    recordDialog(nullptr),
+    diagnosticsDialog(nullptr),
+    windowWatcher(nullptr),
+    pendingLayoutWidth(0),
+    layoutColumns(0),
+    layoutThumbnailWidth(0) {
+
+    // 连续拖动窗口时每帧最多重排一次
+    relayoutTimer = new QTimer(this);
+    relayoutTimer->setSingleShot(true);
+    relayoutTimer->setInterval(16);
+    connect(relayoutTimer, &QTimer::timeout, this, &MainContainer::onRelayoutTimeout);
+
+    // 屏幕外缩略图在空闲时分批调整尺寸
+    resizeBacklogTimer = new QTimer(this);
+    resizeBacklogTimer->setInterval(0);
+    connect(resizeBacklogTimer, &QTimer::timeout, this, &MainContainer::onResizeBacklogTimeout);
+
+    // 搜索防抖：按键连发时合并，查询 + 切换显示仍能在一帧内完成
+    searchDebounceTimer = new QTimer(this);
+    searchDebounceTimer->setSingleShot(true);
+    searchDebounceTimer->setInterval(8);
+    connect(searchDebounceTimer, &QTimer::timeout, this, &MainContainer::onSearchDebounceTimeout);
 
     setupUI();
 
-    // 初始化页面
-    createVideosPage();   // Index 0: 本地视频
-    createSocialPage();   // Index 1: 社交Feed
-    createMessagesPage(); // Index 2: 消息
-    createProfilePage();  // Index 3: 个人中心
+    // 只构建首页；其余页面在第一次导航到时才创建，缩短首屏时间
+    createVideosPage();
 
     // 填充视频网格 (本地文件)
     if (gridLayout) {
@@ -35,8 +62,24 @@ MainContainer::MainContainer(std::vector<TheButtonInfo>& videos, QWidget* parent
         player->setContent(&allButtons, &videos);
     }
 
+    // 最小化、被遮挡或切到其他页面时停止解码
+    windowWatcher = new WindowVisibilityWatcher(this);
+    connect(windowWatcher, &WindowVisibilityWatcher::presentedChanged,
+            this, &MainContainer::updatePlaybackVisibility);
+    connect(contentStack, &QStackedWidget::currentChanged,
+            this, &MainContainer::updatePlaybackVisibility);
+    if (player) {
+        connect(player, &ThePlayer::videoOutputWanted,
+                this, &MainContainer::onVideoOutputWanted);
+    }
+
+    // 搜索索引：本地视频 + 社交帖子，帖子/评论变更时增量更新
+    searchIndex = new SearchIndex(this);
+    searchIndex->indexClips(videos);
+    searchIndex->attachToSocialManager();
+
     // 默认显示 '视频' 页面
-    contentStack->setCurrentIndex(0);
+    contentStack->setCurrentWidget(videosPage);
 }
 
 MainContainer::~MainContainer() {
@@ -52,6 +95,7 @@ void MainContainer::setupUI() {
     topToolbar = new TopToolbar(this);
     // [修复] 连接设置按钮点击信号
     connect(topToolbar, &TopToolbar::settingsClicked, this, &MainContainer::onSettingsClicked);
+    connect(topToolbar, &TopToolbar::searchTextChanged, this, &MainContainer::onSearchTextChanged);
 
     mainLayout->addWidget(topToolbar);
 
@@ -87,6 +131,11 @@ void MainContainer::createVideosPage() {
     videoWidget->setStyleSheet("background-color: black;");
     playerLayout->addWidget(videoWidget);
 
+    // 可选的 OpenGL 输出，运行时在设置中切换
+    glVideoWidget = new GLVideoWidget(playerContainer);
+    glVideoWidget->hide();
+    playerLayout->addWidget(glVideoWidget);
+
     controls = new PlaybackControls(playerContainer);
     playerLayout->addWidget(controls);
 
@@ -106,9 +155,13 @@ void MainContainer::createVideosPage() {
     gridScrollArea->setWidget(gridWidget);
     layout->addWidget(gridScrollArea, 1);
 
+    // 滚动时优先调整新露出的缩略图
+    connect(gridScrollArea->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &MainContainer::resizeVisibleButtons);
+
     player = new ThePlayer();
-    player->setVideoOutput(videoWidget);
     player->setControls(controls);
+    setVideoOutputMode(VideoOutput::loadMode());
 
     videosPage->setStyleSheet(QString("background-color: %1;")
                                   .arg(DesignSystem::Colors::getBackground().name()));
@@ -129,6 +182,9 @@ void MainContainer::createSocialPage() {
 
     socialPage = feedWidget;
     contentStack->addWidget(socialPage);
+
+    // 页面是懒创建的，创建时补上当前的搜索过滤
+    applySearchToFeed();
 }
 
 // === PAGE 3: 消息 ===
@@ -206,19 +262,19 @@ void MainContainer::createProfilePage() {
 void MainContainer::onNavigationPageChanged(BottomNavigationBar::NavigationPage page) {
     switch (page) {
     case BottomNavigationBar::HomePage:
-        contentStack->setCurrentIndex(0);
+        contentStack->setCurrentWidget(videosPage);
         break;
     case BottomNavigationBar::ExplorePage:
-        contentStack->setCurrentIndex(1);
-        player->pause();
+        if (!socialPage) createSocialPage();
+        contentStack->setCurrentWidget(socialPage);
         break;
     case BottomNavigationBar::MessagesPage:
-        contentStack->setCurrentIndex(2);
-        player->pause();
+        if (!messagesPage) createMessagesPage();
+        contentStack->setCurrentWidget(messagesPage);
         break;
     case BottomNavigationBar::ProfilePage:
-        contentStack->setCurrentIndex(3);
-        player->pause();
+        if (!profilePage) createProfilePage();
+        contentStack->setCurrentWidget(profilePage);
         break;
     default: break;
     }
@@ -229,12 +285,14 @@ void MainContainer::onCreateRequested() {
         recordDialog = new RecordDialog(this);
         connect(recordDialog, &RecordDialog::videoRecorded, this, &MainContainer::onVideoRecorded);
     }
+    recordDialog->setOutputDirectory(libraryDirectory);
     recordDialog->exec();
 }
 
-void MainContainer::onVideoRecorded(const QString& videoPath, bool isFrontCamera) {
+void MainContainer::onVideoRecorded(const QString& videoPath, bool isFrontCamera, bool isBeReal) {
     QMessageBox::information(this, tr("Upload Complete"),
-                             tr("Video recorded to: %1").arg(videoPath));
+                             isBeReal ? tr("BeReal moment recorded to: %1").arg(videoPath)
+                                      : tr("Video recorded to: %1").arg(videoPath));
 }
 
 void MainContainer::onVideoSelected(TheButtonInfo* info) {
@@ -247,11 +305,10 @@ void MainContainer::onVideoSelected(TheButtonInfo* info) {
 void MainContainer::onSocialPlayRequested(const VideoPost& post) {
     if (!post.videoUrl.isEmpty()) {
         bottomNav->setCurrentPage(BottomNavigationBar::HomePage);
-        contentStack->setCurrentIndex(0);
+        contentStack->setCurrentWidget(videosPage);
         playerContainer->show();
 
-        player->setMedia(post.videoUrl);
-        player->play();
+        player->playSource(post.videoUrl);
     } else {
         QMessageBox::information(this, tr("Error"), tr("Video file not found for this post."));
     }
@@ -263,6 +320,10 @@ void MainContainer::onSettingsClicked() {
     // 设置更改后刷新UI
     connect(settingsDialog, &SettingsDialog::settingsApplied,
             this, &MainContainer::updateTheme);
+    connect(settingsDialog, &SettingsDialog::videoOutputChanged,
+            this, &MainContainer::onVideoOutputChanged);
+    connect(settingsDialog, &SettingsDialog::diagnosticsRequested,
+            this, &MainContainer::onDiagnosticsRequested);
 
     settingsDialog->exec();
     settingsDialog->deleteLater();
@@ -275,27 +336,167 @@ void MainContainer::onCommentDialogRequested(const QString& postId) {
     dialog->deleteLater();
 }
 
+void MainContainer::setVideoOutputMode(VideoOutput::Mode mode) {
+    videoOutputMode = mode;
+
+    if (mode == VideoOutput::OpenGL) {
+        videoWidget->hide();
+        glVideoWidget->show();
+        glVideoWidget->resetStats();
+    } else {
+        glVideoWidget->hide();
+        videoWidget->show();
+    }
+    attachVideoOutput();
+
+    if (diagnosticsDialog) {
+        diagnosticsDialog->setOutputMode(mode);
+    }
+
+    qDebug() << "Video output mode:" << (mode == VideoOutput::OpenGL ? "OpenGL" : "Standard");
+}
+
+void MainContainer::attachVideoOutput() {
+    if (videoOutputMode == VideoOutput::OpenGL) {
+        player->setVideoOutput(glVideoWidget->videoSurface());
+    } else {
+        player->setVideoOutput(videoWidget);
+    }
+}
+
+void MainContainer::updatePlaybackVisibility() {
+    if (!player || !windowWatcher) return;
+
+    bool visible = windowWatcher->isPresented() &&
+                   contentStack->currentWidget() == videosPage &&
+                   playerContainer->isVisible();
+    player->setOutputVisible(visible);
+}
+
+void MainContainer::onVideoOutputWanted(bool wanted) {
+    if (wanted) {
+        attachVideoOutput();
+    } else {
+        player->setVideoOutput(static_cast<QVideoWidget*>(nullptr));
+    }
+}
+
+void MainContainer::onVideoOutputChanged(int mode) {
+    setVideoOutputMode(mode == VideoOutput::OpenGL ? VideoOutput::OpenGL : VideoOutput::Standard);
+}
+
+void MainContainer::onDiagnosticsRequested() {
+    // 从模态的设置对话框里打开时，诊断面板必须是它的子窗口，否则在设置关闭前无法操作
+    QWidget* owner = QApplication::activeModalWidget();
+    if (!owner) owner = this;
+
+    if (diagnosticsDialog && diagnosticsDialog->parentWidget() != owner) {
+        delete diagnosticsDialog;
+    }
+    if (!diagnosticsDialog) {
+        diagnosticsDialog = new VideoDiagnosticsDialog(player, glVideoWidget,
+                                                       videoOutputMode, owner);
+    }
+    diagnosticsDialog->show();
+    diagnosticsDialog->raise();
+}
+
 void MainContainer::updateResponsiveLayout(int windowWidth) {
     if (allButtons.empty() || !gridLayout) return;
 
     int columns = DesignSystem::Dimensions::getGridColumns(windowWidth);
+    int thumbnailWidth = DesignSystem::Dimensions::getThumbnailWidth(windowWidth);
+    bool columnsChanged = columns != layoutColumns;
+    bool sizeChanged = thumbnailWidth != layoutThumbnailWidth;
+
+    // 断点和列数都没变时无需任何操作
+    if (!columnsChanged && !sizeChanged) return;
+
+    layoutColumns = columns;
+    layoutThumbnailWidth = thumbnailWidth;
+
+    gridWidget->setUpdatesEnabled(false);
+
+    if (sizeChanged) {
+        // 所有缩略图进入待调整队列，可见的立即处理，其余空闲时分批处理
+        resizeBacklog.clear();
+        for (TheButton* button : allButtons) {
+            resizeBacklog.append(button);
+        }
+        resizeVisibleButtons();
+        resizeBacklogTimer->start();
+    }
+
+    if (columnsChanged) {
+        reflowGrid();
+    }
+
+    gridWidget->setUpdatesEnabled(true);
+
+    qDebug() << "Grid relayout:" << columns << "columns," << thumbnailWidth << "px thumbnails";
+}
+
+// 按当前列数重新排布，搜索过滤掉的缩略图只隐藏、不占格子
+void MainContainer::reflowGrid() {
+    if (layoutColumns <= 0) return;
 
     QLayoutItem* item;
     while ((item = gridLayout->takeAt(0)) != nullptr) {
         delete item;
     }
 
-    for (size_t i = 0; i < allButtons.size(); i++) {
-        int row = i / columns;
-        int col = i % columns;
-        allButtons[i]->setResponsiveSize(windowWidth);
-        gridLayout->addWidget(allButtons[i], row, col);
+    int index = 0;
+    for (TheButton* button : allButtons) {
+        bool matches = !clipFilter || clipFilter(button->getInfo());
+        if (button->isHidden() == matches) {
+            button->setVisible(matches);
+        }
+        if (!matches) continue;
+
+        gridLayout->addWidget(button, index / layoutColumns, index % layoutColumns);
+        index++;
+    }
+}
+
+void MainContainer::resizeVisibleButtons() {
+    if (resizeBacklog.isEmpty()) return;
+
+    int windowWidth = pendingLayoutWidth > 0 ? pendingLayoutWidth : width();
+    for (int i = resizeBacklog.size() - 1; i >= 0; i--) {
+        TheButton* button = resizeBacklog.at(i);
+        if (!button->visibleRegion().isEmpty()) {
+            button->setResponsiveSize(windowWidth);
+            resizeBacklog.removeAt(i);
+        }
+    }
+}
+
+void MainContainer::onResizeBacklogTimeout() {
+    // 每次空闲只处理一小批，避免阻塞输入
+    const int batchSize = 32;
+    int windowWidth = pendingLayoutWidth > 0 ? pendingLayoutWidth : width();
+
+    for (int i = 0; i < batchSize && !resizeBacklog.isEmpty(); i++) {
+        resizeBacklog.takeLast()->setResponsiveSize(windowWidth);
+    }
+
+    if (resizeBacklog.isEmpty()) {
+        resizeBacklogTimer->stop();
     }
 }
 
+void MainContainer::onRelayoutTimeout() {
+    updateResponsiveLayout(pendingLayoutWidth);
+}
+
 void MainContainer::resizeEvent(QResizeEvent* event) {
     QWidget::resizeEvent(event);
-    updateResponsiveLayout(event->size().width());
+
+    // 只记录最新宽度；计时器未运行时才启动，保证每帧最多处理一次
+    pendingLayoutWidth = event->size().width();
+    if (!relayoutTimer->isActive()) {
+        relayoutTimer->start();
+    }
 }
 
 void MainContainer::updateTheme() {
@@ -317,3 +518,55 @@ void MainContainer::updateTheme() {
         feed->updateTheme();
     }
 }
+
+void MainContainer::onSearchTextChanged(const QString& text) {
+    // 重新计时即丢弃上一次尚未执行的查询
+    pendingSearchText = text.trimmed();
+    searchDebounceTimer->start();
+}
+
+void MainContainer::onSearchDebounceTimeout() {
+    if (pendingSearchText == appliedSearchText) return;
+    appliedSearchText = pendingSearchText;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (appliedSearchText.isEmpty()) {
+        clipFilter = ClipPredicate();
+        matchingPostIds.clear();
+    } else {
+        // 过滤只需要命中集合，不做排序
+        QSet<QString> matchingClips;
+        searchIndex->matchKeys(appliedSearchText, matchingClips, matchingPostIds);
+
+        clipFilter = [matchingClips](const TheButtonInfo* info) {
+            return info && info->url && matchingClips.contains(info->url->toLocalFile());
+        };
+    }
+
+    gridWidget->setUpdatesEnabled(false);
+    reflowGrid();
+    gridWidget->setUpdatesEnabled(true);
+    resizeVisibleButtons();
+
+    applySearchToFeed();
+
+    qDebug() << "Search" << appliedSearchText << "filtered in"
+             << timer.nsecsElapsed() / 1000 << "us";
+}
+
+void MainContainer::applySearchToFeed() {
+    SocialFeedWidget* feedWidget = qobject_cast<SocialFeedWidget*>(socialPage);
+    if (!feedWidget) return;
+
+    if (appliedSearchText.isEmpty()) {
+        feedWidget->clearPostFilter();
+        return;
+    }
+
+    QSet<QString> postIds = matchingPostIds;
+    feedWidget->setPostFilter([postIds](const VideoPost& post) {
+        return postIds.contains(post.postId);
+    });
+}
@@ -7,6 +7,10 @@
 #include <QScrollArea>
 #include <QVideoWidget>
 #include <QGridLayout>
+#include <QTimer>
+#include <QSet>
+#include <QPointer>
+#include <functional>
 #include <vector>
 
 // 引入自定义头文件
@@ -19,8 +23,13 @@
 #include "social_manager.h"
 #include "video_post_card.h"
 #include "social_feed_widget.h"
+#include "gl_video_widget.h"
+#include "search_index.h"
+#include "window_visibility_watcher.h"
 // 注意：SettingsDialog 和 CommentDialog 在 cpp 中引入即可，这里不需要
 
+class VideoDiagnosticsDialog;
+
 class MainContainer : public QWidget {
     Q_OBJECT
 
@@ -39,6 +48,8 @@ private:
     // 视频页组件
     QWidget* playerContainer;
     QVideoWidget* videoWidget;
+    GLVideoWidget* glVideoWidget;
+    VideoOutput::Mode videoOutputMode;
     PlaybackControls* controls;
     QScrollArea* gridScrollArea;
     QWidget* gridWidget;
@@ -47,7 +58,27 @@ private:
     // 逻辑组件
     ThePlayer* player;
     RecordDialog* recordDialog;
+    QString libraryDirectory;        // 新录制的视频保存到视频库目录
+    QPointer<VideoDiagnosticsDialog> diagnosticsDialog;   // 父窗口可能是设置对话框，随之销毁
+    WindowVisibilityWatcher* windowWatcher;
     std::vector<TheButton*> allButtons;
+    SearchIndex* searchIndex;
+
+    // 边输入边过滤：防抖合并连续按键，新输入会取消尚未执行的旧查询
+    typedef std::function<bool(const TheButtonInfo*)> ClipPredicate;
+    QTimer* searchDebounceTimer;
+    QString pendingSearchText;
+    QString appliedSearchText;
+    ClipPredicate clipFilter;
+    QSet<QString> matchingPostIds;
+
+    // 响应式重排：按帧合并 resize 事件，只在断点/列数变化时重排
+    QTimer* relayoutTimer;
+    QTimer* resizeBacklogTimer;
+    int pendingLayoutWidth;
+    int layoutColumns;
+    int layoutThumbnailWidth;
+    QVector<TheButton*> resizeBacklog;   // 尚未调整尺寸的屏幕外缩略图
 
     // 函数
     void setupUI();
@@ -56,6 +87,11 @@ private:
     void createMessagesPage();
     void createProfilePage();
     void updateResponsiveLayout(int windowWidth);
+    void resizeVisibleButtons();
+    void reflowGrid();
+    void applySearchToFeed();
+    void setVideoOutputMode(VideoOutput::Mode mode);
+    void attachVideoOutput();
 
 protected:
     void resizeEvent(QResizeEvent* event) override;
@@ -65,18 +101,35 @@ public:
     ~MainContainer();
 
     ThePlayer* getPlayer() const { return player; }
+    void setLibraryDirectory(const QString& directory) { libraryDirectory = directory; }
     void updateTheme();
 
 private slots:
     void onNavigationPageChanged(BottomNavigationBar::NavigationPage page);
     void onCreateRequested();
-    void onVideoRecorded(const QString& videoPath, bool isFrontCamera);
+    void onVideoRecorded(const QString& videoPath, bool isFrontCamera, bool isBeReal);
     void onVideoSelected(TheButtonInfo* info);
     void onSocialPlayRequested(const VideoPost& post);
 
     // [修复] 新增：处理设置和评论的槽函数
     void onSettingsClicked();
     void onCommentDialogRequested(const QString& postId);
+
+    // 视频输出切换与诊断面板
+    void onVideoOutputChanged(int mode);
+    void onDiagnosticsRequested();
+
+    // 播放画面可见性：窗口、页面和播放区域都可见时才解码
+    void updatePlaybackVisibility();
+    void onVideoOutputWanted(bool wanted);
+
+    // 搜索框输入
+    void onSearchTextChanged(const QString& text);
+    void onSearchDebounceTimeout();
+
+    // 响应式重排
+    void onRelayoutTimeout();
+    void onResizeBacklogTimeout();
 };
 
 #endif // MAIN_CONTAINER_H
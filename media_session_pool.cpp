@@ -0,0 +1,226 @@
+//
+// MediaSessionPool - 实现
+//
+
+#include "media_session_pool.h"
+#include "mp4_parser.h"
+#include <QDebug>
+#include <QFileInfo>
+#include <QSettings>
+
+MediaSessionPool* MediaSessionPool::instance = nullptr;
+
+// 空闲会话只保留播放器后端，默认最多保留 3 个
+static const int MaxIdleSessions = 6;
+static const int DefaultIdleSessions = 3;
+
+MediaSessionPool::MediaSessionPool(QObject* parent)
+    : QObject(parent),
+    capacity(loadCapacity()) {
+
+    qDebug() << "MediaSessionPool initialized, idle capacity:" << capacity;
+}
+
+MediaSessionPool* MediaSessionPool::getInstance() {
+    if (instance == nullptr) {
+        instance = new MediaSessionPool();
+    }
+    return instance;
+}
+
+int MediaSessionPool::loadCapacity() {
+    QSettings settings("Tomeo", "PlaybackSettings");
+    return qBound(0, settings.value("idleMediaSessions", DefaultIdleSessions).toInt(),
+                  MaxIdleSessions);
+}
+
+void MediaSessionPool::saveCapacity(int size) {
+    QSettings settings("Tomeo", "PlaybackSettings");
+    settings.setValue("idleMediaSessions", qBound(0, size, MaxIdleSessions));
+}
+
+QString MediaSessionPool::familyOf(const QUrl& url) const {
+    if (!url.isLocalFile()) {
+        return url.scheme();
+    }
+
+    QString path = url.toLocalFile();
+    auto cached = familyCache.constFind(path);
+    if (cached != familyCache.constEnd()) {
+        return cached.value();
+    }
+
+    QString family = QFileInfo(path).suffix().toLower();
+    if (Mp4Parser::isCandidate(path)) {
+        Mp4Info info = Mp4Parser::parseFile(path);
+        if (!info.videoCodec.isEmpty()) {
+            family += "/" + QString::fromLatin1(info.videoCodec);
+        }
+    }
+
+    familyCache.insert(path, family);
+    return family;
+}
+
+QMediaPlayer* MediaSessionPool::acquire(const QUrl& url) {
+    QString family = familyOf(url);
+    QMediaPlayer* player = nullptr;
+    bool reused = false;
+
+    // 从最近释放的开始找同族会话
+    for (int i = idle.size() - 1; i >= 0; --i) {
+        if (idle.at(i).family == family) {
+            player = idle.takeAt(i).player;
+            reused = true;
+            break;
+        }
+    }
+
+    if (player) {
+        stats[family].reused++;
+    } else {
+        player = new QMediaPlayer(this, QMediaPlayer::VideoSurface);
+        stats[family].created++;
+        qDebug() << "MediaSessionPool: created session for" << family;
+    }
+
+    observe(player);
+    inUse.insert(player, family);
+    trackLoad(player, family, reused ? ReusedLoad : FreshLoad);
+    player->setMedia(url);
+    return player;
+}
+
+void MediaSessionPool::release(QMediaPlayer* player) {
+    if (!player || !inUse.contains(player)) return;
+
+    IdleSession session;
+    session.player = player;
+    session.family = inUse.take(player);
+    pending.remove(player);
+
+    // 清空媒体释放解码器：空闲会话不能占用内联播放上限和不可见时应释放的解码资源
+    player->stop();
+    player->setMedia(QMediaContent());
+    player->setMuted(false);
+    player->setPlaybackRate(1.0);
+    idle.append(session);
+
+    trimIdle();
+}
+
+void MediaSessionPool::trackResident(QMediaPlayer* player, const QUrl& url) {
+    if (!player || url.isEmpty()) return;
+
+    QString family = familyOf(url);
+
+    // 后端在第一次 setMedia 时才建立，之后一直保留：只有这一次是真正的管线构建
+    if (!residents.contains(player)) {
+        residents.insert(player);
+        stats[family].created++;
+        trackLoad(player, family, FreshLoad);
+        qDebug() << "MediaSessionPool: resident player built its pipeline for" << family;
+        return;
+    }
+    trackLoad(player, family, ResidentLoad);
+}
+
+void MediaSessionPool::trimIdle() {
+    while (idle.size() > capacity) {
+        IdleSession oldest = idle.takeFirst();
+        stats[oldest.family].evicted++;
+        observed.remove(oldest.player);
+        oldest.player->deleteLater();
+        qDebug() << "MediaSessionPool: evicted idle session for" << oldest.family;
+    }
+}
+
+void MediaSessionPool::observe(QMediaPlayer* player) {
+    if (observed.contains(player)) return;
+    observed.insert(player);
+
+    connect(player, &QMediaPlayer::mediaStatusChanged,
+            this, &MediaSessionPool::onMediaStatusChanged);
+    connect(player, &QObject::destroyed, this, [this, player]() {
+        observed.remove(player);
+        pending.remove(player);
+        inUse.remove(player);
+        residents.remove(player);
+    });
+}
+
+void MediaSessionPool::trackLoad(QMediaPlayer* player, const QString& family, LoadKind kind) {
+    observe(player);
+
+    PendingLoad load;
+    load.family = family;
+    load.kind = kind;
+    load.timer.start();
+    pending.insert(player, load);
+}
+
+void MediaSessionPool::onMediaStatusChanged(QMediaPlayer::MediaStatus status) {
+    QMediaPlayer* player = qobject_cast<QMediaPlayer*>(sender());
+    auto it = pending.find(player);
+    if (it == pending.end()) return;
+
+    if (status == QMediaPlayer::InvalidMedia) {
+        pending.erase(it);
+        return;
+    }
+    if (status != QMediaPlayer::LoadedMedia && status != QMediaPlayer::BufferedMedia) {
+        return;
+    }
+
+    qint64 elapsed = it->timer.elapsed();
+    SessionStats& familyStats = stats[it->family];
+    static const char* KindNames[] = { "fresh", "reused", "resident" };
+    switch (it->kind) {
+    case ReusedLoad:
+        familyStats.reusedLoads++;
+        familyStats.reusedLoadMs += elapsed;
+        break;
+    case ResidentLoad:
+        familyStats.residentLoads++;
+        familyStats.residentLoadMs += elapsed;
+        break;
+    default:
+        familyStats.freshLoads++;
+        familyStats.freshLoadMs += elapsed;
+        break;
+    }
+
+    qDebug() << "MediaSessionPool:" << it->family << KindNames[it->kind]
+             << "session loaded in" << elapsed << "ms";
+    pending.erase(it);
+}
+
+SessionStats MediaSessionPool::totals() const {
+    SessionStats total;
+    for (const SessionStats& familyStats : stats) {
+        total.created += familyStats.created;
+        total.reused += familyStats.reused;
+        total.evicted += familyStats.evicted;
+        total.freshLoads += familyStats.freshLoads;
+        total.freshLoadMs += familyStats.freshLoadMs;
+        total.reusedLoads += familyStats.reusedLoads;
+        total.reusedLoadMs += familyStats.reusedLoadMs;
+        total.residentLoads += familyStats.residentLoads;
+        total.residentLoadMs += familyStats.residentLoadMs;
+    }
+    return total;
+}
+
+// 节省时间按族分别计算后再求和，不同族的加载耗时不能直接比较
+qint64 MediaSessionPool::totalSavedMs() const {
+    qint64 saved = 0;
+    for (const SessionStats& familyStats : stats) {
+        saved += familyStats.savedMs();
+    }
+    return saved;
+}
+
+// residents 不清空：已建好管线的常驻播放器不会因为清零再算一次构建
+void MediaSessionPool::resetStats() {
+    stats.clear();
+}
@@ -0,0 +1,118 @@
+//
+// MediaSessionPool - 媒体会话池
+// Iteration 4: 按编码/容器族保留少量已初始化的 QMediaPlayer，
+//              切换同族视频时复用播放器后端，并统计创建/复用次数与节省的加载时间。
+//              空闲会话不持有媒体，也就不占解码器。
+//              主播放器不进池，它的加载单独计时（常驻管线上的重新加载），不计入节省时间
+//
+
+#ifndef MEDIA_SESSION_POOL_H
+#define MEDIA_SESSION_POOL_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QMediaPlayer>
+#include <QSet>
+#include <QUrl>
+
+// 一个编码族的统计
+struct SessionStats {
+    int created;            // 新建的会话
+    int reused;             // 复用的会话
+    int evicted;            // 空闲超出上限被销毁的会话
+    int freshLoads;         // 新管线上完成的加载
+    qint64 freshLoadMs;
+    int reusedLoads;        // 复用管线上完成的加载
+    qint64 reusedLoadMs;
+    int residentLoads;      // 主播放器常驻管线上完成的加载（不经过池）
+    qint64 residentLoadMs;
+
+    SessionStats()
+        : created(0), reused(0), evicted(0),
+        freshLoads(0), freshLoadMs(0), reusedLoads(0), reusedLoadMs(0),
+        residentLoads(0), residentLoadMs(0) {}
+
+    qint64 averageFreshMs() const { return freshLoads > 0 ? freshLoadMs / freshLoads : 0; }
+    qint64 averageReusedMs() const { return reusedLoads > 0 ? reusedLoadMs / reusedLoads : 0; }
+    qint64 averageResidentMs() const { return residentLoads > 0 ? residentLoadMs / residentLoads : 0; }
+
+    // 复用次数 × 两种加载的平均耗时差
+    qint64 savedMs() const {
+        if (freshLoads == 0 || reusedLoads == 0) return 0;
+        return qMax<qint64>(0, averageFreshMs() - averageReusedMs()) * reusedLoads;
+    }
+};
+
+class MediaSessionPool : public QObject {
+    Q_OBJECT
+
+private:
+    struct IdleSession {
+        QMediaPlayer* player;
+        QString family;
+    };
+
+    enum LoadKind {
+        FreshLoad,          // 池新建的会话
+        ReusedLoad,         // 池复用的空闲会话
+        ResidentLoad        // 池外常驻播放器上的重新加载
+    };
+
+    // 等待首帧就绪的加载
+    struct PendingLoad {
+        QString family;
+        LoadKind kind;
+        QElapsedTimer timer;
+    };
+
+    static MediaSessionPool* instance;
+
+    int capacity;                               // 空闲会话上限
+    QList<IdleSession> idle;                    // 最近释放的在末尾
+    QHash<QMediaPlayer*, QString> inUse;        // 会话 -> 当前编码族
+    QHash<QMediaPlayer*, PendingLoad> pending;
+    QSet<QMediaPlayer*> observed;
+    QMap<QString, SessionStats> stats;
+    QSet<QMediaPlayer*> residents;              // 已建好管线的池外播放器
+    mutable QHash<QString, QString> familyCache;
+
+    explicit MediaSessionPool(QObject* parent = nullptr);
+
+    void observe(QMediaPlayer* player);
+    void trimIdle();
+    void trackLoad(QMediaPlayer* player, const QString& family, LoadKind kind);
+
+private slots:
+    void onMediaStatusChanged(QMediaPlayer::MediaStatus status);
+
+public:
+    static MediaSessionPool* getInstance();
+
+    // 空闲会话数保存在 QSettings("Tomeo", "PlaybackSettings")
+    static int loadCapacity();
+    static void saveCapacity(int capacity);
+
+    // 编码族：容器后缀 + 视频编码（MP4/MOV 从容器中读取），如 "mp4/avc1"
+    QString familyOf(const QUrl& url) const;
+
+    // 取一个会话并加载 url；优先复用同族的空闲会话
+    QMediaPlayer* acquire(const QUrl& url);
+    // 停止播放、清空媒体（释放解码器）后放回池中，播放器后端保留
+    void release(QMediaPlayer* player);
+
+    // 池外的常驻播放器（主播放器）在 setMedia 之前调用：第一次加载算作新建管线，
+    // 之后是同一管线上的重新加载，单独计时，不算复用
+    void trackResident(QMediaPlayer* player, const QUrl& url);
+
+    QMap<QString, SessionStats> getStats() const { return stats; }
+    SessionStats totals() const;
+    qint64 totalSavedMs() const;
+    void resetStats();
+    int idleCount() const { return idle.size(); }
+    int inUseCount() const { return inUse.size(); }
+};
+
+#endif // MEDIA_SESSION_POOL_H
@@ -0,0 +1,139 @@
+//
+// MemoryBudget - 实现
+//
+
+#include "memory_budget.h"
+#include <QDebug>
+#include <QSettings>
+#include <QStringList>
+
+MemoryBudget* MemoryBudget::instance = nullptr;
+
+// 默认 192MB，适合 2GB 内存的展示终端
+static const int DefaultBudgetMegabytes = 192;
+
+// 超限后降到上限的 85%，避免每次新增一张图就触发一轮淘汰
+static const int LowWatermarkPercent = 85;
+
+static const int PollIntervalMs = 10000;
+
+MemoryBudget::MemoryBudget(QObject* parent)
+    : QObject(parent),
+    budget(qint64(loadBudgetMegabytes()) * 1024 * 1024),
+    evictedBytes(0) {
+
+    checkTimer = new QTimer(this);
+    checkTimer->setSingleShot(true);
+    checkTimer->setInterval(0);
+    connect(checkTimer, &QTimer::timeout, this, &MemoryBudget::enforce);
+
+    pollTimer = new QTimer(this);
+    pollTimer->setInterval(PollIntervalMs);
+    connect(pollTimer, &QTimer::timeout, this, &MemoryBudget::enforce);
+    pollTimer->start();
+
+    qDebug() << "MemoryBudget initialized:" << budget / (1024 * 1024) << "MB";
+}
+
+MemoryBudget* MemoryBudget::getInstance() {
+    if (instance == nullptr) {
+        instance = new MemoryBudget();
+    }
+    return instance;
+}
+
+int MemoryBudget::loadBudgetMegabytes() {
+    QSettings settings("Tomeo", "MemorySettings");
+    return qMax(0, settings.value("budgetMB", DefaultBudgetMegabytes).toInt());
+}
+
+void MemoryBudget::saveBudgetMegabytes(int megabytes) {
+    QSettings settings("Tomeo", "MemorySettings");
+    settings.setValue("budgetMB", qMax(0, megabytes));
+}
+
+void MemoryBudget::registerConsumer(MemoryConsumer* consumer) {
+    if (!consumer || consumers.contains(consumer)) return;
+
+    int index = 0;
+    while (index < consumers.size() &&
+           consumers.at(index)->memoryPriority() <= consumer->memoryPriority()) {
+        index++;
+    }
+    consumers.insert(index, consumer);
+
+    qDebug() << "MemoryBudget: registered" << consumer->memoryName();
+    notifyGrowth();
+}
+
+void MemoryBudget::unregisterConsumer(MemoryConsumer* consumer) {
+    consumers.removeAll(consumer);
+}
+
+void MemoryBudget::notifyGrowth() {
+    if (!checkTimer->isActive()) {
+        checkTimer->start();
+    }
+}
+
+void MemoryBudget::setBudget(qint64 bytes) {
+    budget = qMax<qint64>(0, bytes);
+    saveBudgetMegabytes(int(budget / (1024 * 1024)));
+    notifyGrowth();
+}
+
+qint64 MemoryBudget::totalUsage() const {
+    qint64 total = 0;
+    for (MemoryConsumer* consumer : consumers) {
+        total += consumer->memoryUsage();
+    }
+    return total;
+}
+
+qint64 MemoryBudget::evict(qint64 bytes, MemoryConsumer::EvictionPass pass) {
+    qint64 released = 0;
+    for (MemoryConsumer* consumer : consumers) {
+        if (released >= bytes) break;
+        qint64 freed = consumer->releaseMemory(bytes - released, pass);
+        if (freed > 0) {
+            qDebug() << "MemoryBudget: released" << freed / 1024 << "KB from"
+                     << consumer->memoryName()
+                     << (pass == MemoryConsumer::Invisible ? "(invisible)" : "(LRU)");
+        }
+        released += freed;
+    }
+    return released;
+}
+
+void MemoryBudget::enforce() {
+    qint64 usage = totalUsage();
+
+    if (budget > 0 && usage > budget) {
+        qint64 target = budget * LowWatermarkPercent / 100;
+        qint64 excess = usage - target;
+
+        // 先释放屏幕外的条目，仍不够时才淘汰正在显示的
+        qint64 released = evict(excess, MemoryConsumer::Invisible);
+        if (released < excess) {
+            released += evict(excess - released, MemoryConsumer::LeastRecentlyUsed);
+        }
+        evictedBytes += released;
+
+        qDebug() << "MemoryBudget: usage" << usage / 1024 << "KB over budget"
+                 << budget / 1024 << "KB, released" << released / 1024 << "KB";
+        usage = totalUsage();
+    }
+
+    emit usageChanged(usage, budget);
+}
+
+QString MemoryBudget::report() const {
+    QStringList lines;
+    for (MemoryConsumer* consumer : consumers) {
+        lines << QString("%1: %2 KB").arg(consumer->memoryName())
+                     .arg(consumer->memoryUsage() / 1024);
+    }
+    lines << QString("total: %1 / %2 KB, evicted %3 KB")
+                 .arg(totalUsage() / 1024).arg(budget / 1024).arg(evictedBytes / 1024);
+    return lines.join("\n");
+}
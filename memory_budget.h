@@ -0,0 +1,77 @@
+//
+// MemoryBudget - 全局内存预算
+// Iteration 4: 图片/缩略图/预览帧缓存注册到这里并上报占用，
+//              总量超过上限时先淘汰不可见的条目，再按 LRU 淘汰，长时间运行内存不再增长
+//
+
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include <QTimer>
+
+// 可被预算管理的缓存
+class MemoryConsumer {
+public:
+    enum EvictionPass {
+        Invisible,          // 只释放当前没有被任何控件显示/使用的条目
+        LeastRecentlyUsed   // 按最近使用时间释放，包括仍在显示的条目
+    };
+
+    virtual ~MemoryConsumer() {}
+
+    virtual QString memoryName() const = 0;
+    virtual qint64 memoryUsage() const = 0;     // 字节
+
+    // 重新生成的代价，小的先被淘汰（磁盘上有缓存的 < 需要重新解码的）
+    virtual int memoryPriority() const { return 0; }
+
+    // 尝试释放至少 bytes 字节，返回实际释放的字节数
+    virtual qint64 releaseMemory(qint64 bytes, EvictionPass pass) = 0;
+};
+
+class MemoryBudget : public QObject {
+    Q_OBJECT
+
+private:
+    static MemoryBudget* instance;
+
+    QList<MemoryConsumer*> consumers;   // 按 memoryPriority 升序
+    qint64 budget;                      // 字节，0 表示不限制
+    QTimer* checkTimer;                 // 合并短时间内的多次上报
+    QTimer* pollTimer;                  // 兜底的周期检查
+    qint64 evictedBytes;
+
+    explicit MemoryBudget(QObject* parent = nullptr);
+
+    qint64 evict(qint64 bytes, MemoryConsumer::EvictionPass pass);
+
+private slots:
+    void enforce();
+
+public:
+    static MemoryBudget* getInstance();
+
+    // 上限保存在 QSettings("Tomeo", "MemorySettings")，单位 MB
+    static int loadBudgetMegabytes();
+    static void saveBudgetMegabytes(int megabytes);
+
+    void registerConsumer(MemoryConsumer* consumer);
+    void unregisterConsumer(MemoryConsumer* consumer);
+
+    // 缓存占用增加后调用；检查在下一次事件循环中进行
+    void notifyGrowth();
+
+    void setBudget(qint64 bytes);
+    qint64 getBudget() const { return budget; }
+    qint64 totalUsage() const;
+    qint64 totalEvicted() const { return evictedBytes; }
+    QString report() const;
+
+signals:
+    void usageChanged(qint64 usage, qint64 budget);
+};
+
+#endif // MEMORY_BUDGET_H
@@ -0,0 +1,518 @@
+//
+// MockSocialService - 实现
+//
+
+#include "mock_social_service.h"
+#include "social_json.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QPointer>
+#include <QSettings>
+#include <QTimer>
+#include <QUrl>
+#include <QUrlQuery>
+#include <cstring>
+
+const char* MockSocialServer::CommandLineFlag = "--mock-social-server";
+const quint16 MockSocialServer::DefaultPort = 8765;
+
+static const QStringList CaptionWords = {
+    "sunset", "beach", "coffee", "city", "hiking", "concert", "cooking", "skate",
+    "rain", "street", "friends", "weekend", "morning", "night", "music", "travel",
+    "campus", "library", "dog", "garden"
+};
+
+static const QStringList TagWords = {
+    "bereal", "daily", "vlog", "food", "outdoors", "music", "study", "pets"
+};
+
+// ==================== MockSocialConfig ====================
+
+MockSocialConfig MockSocialConfig::load() {
+    QSettings settings("Tomeo", "MockSocialService");
+    MockSocialConfig config;
+    config.latencyMs = settings.value("latencyMs", config.latencyMs).toInt();
+    config.jitterMs = settings.value("jitterMs", config.jitterMs).toInt();
+    config.pageSize = settings.value("pageSize", config.pageSize).toInt();
+    config.maxPageSize = settings.value("maxPageSize", config.maxPageSize).toInt();
+    config.failureRate = settings.value("failureRate", config.failureRate).toDouble();
+    config.postCount = settings.value("postCount", config.postCount).toInt();
+    config.cacheMaxAgeSec = settings.value("cacheMaxAgeSec", config.cacheMaxAgeSec).toInt();
+    config.seed = settings.value("seed", config.seed).toUInt();
+    return config;
+}
+
+void MockSocialConfig::save() const {
+    QSettings settings("Tomeo", "MockSocialService");
+    settings.setValue("latencyMs", latencyMs);
+    settings.setValue("jitterMs", jitterMs);
+    settings.setValue("pageSize", pageSize);
+    settings.setValue("maxPageSize", maxPageSize);
+    settings.setValue("failureRate", failureRate);
+    settings.setValue("postCount", postCount);
+    settings.setValue("cacheMaxAgeSec", cacheMaxAgeSec);
+    settings.setValue("seed", seed);
+}
+
+// ==================== MockSocialDataset ====================
+
+MockSocialDataset::MockSocialDataset(const MockSocialConfig& config) {
+    QRandomGenerator random(config.seed);
+
+    // 用户池，前四位是当前用户的好友
+    QVector<UserInfo> users;
+    for (int i = 0; i < 12; i++) {
+        UserInfo user;
+        user.userId = QString("mock_user_%1").arg(i);
+        user.username = QString("@%1_%2").arg(CaptionWords.at(i % CaptionWords.size())).arg(i);
+        user.displayName = QString("Mock User %1").arg(i);
+        user.bio = QString("Posting about %1").arg(CaptionWords.at((i * 7) % CaptionWords.size()));
+        user.followersCount = random.bounded(10, 5000);
+        user.followingCount = random.bounded(10, 800);
+        user.isFriend = i < 4;
+        users.append(user);
+
+        if (user.isFriend) {
+            friendList.append(SocialJson::userToJson(user));
+        }
+    }
+
+    // 发布时间在过去一周内，按时间倒序生成
+    QDateTime now = QDateTime::currentDateTime();
+    qint64 offsetSecs = 0;
+    int spacingSecs = qMax(1, 7 * 24 * 3600 / qMax(1, config.postCount));
+
+    for (int i = 0; i < config.postCount; i++) {
+        VideoPost post;
+        post.postId = QString("mock_post_%1").arg(i);
+        post.author = users.at(random.bounded(users.size()));
+
+        QStringList words;
+        int wordCount = random.bounded(3, 7);
+        for (int w = 0; w < wordCount; w++) {
+            words << CaptionWords.at(random.bounded(CaptionWords.size()));
+        }
+        post.caption = words.join(' ');
+        post.caption[0] = post.caption.at(0).toUpper();
+
+        int tagCount = random.bounded(1, 4);
+        for (int t = 0; t < tagCount; t++) {
+            QString tag = TagWords.at(random.bounded(TagWords.size()));
+            if (!post.tags.contains(tag)) {
+                post.tags.append(tag);
+            }
+        }
+
+        offsetSecs += random.bounded(spacingSecs / 2 + 1, spacingSecs * 3 / 2 + 2);
+        post.timestamp = now.addSecs(-offsetSecs);
+        post.likesCount = random.bounded(0, 500);
+        post.viewsCount = post.likesCount * random.bounded(2, 20);
+        post.isBeRealMoment = random.bounded(5) == 0;
+        post.isFrontCamera = random.bounded(2) == 0;
+
+        int commentCount = random.bounded(0, 7);
+        for (int c = 0; c < commentCount; c++) {
+            Comment comment;
+            comment.commentId = QString("%1_comment_%2").arg(post.postId).arg(c);
+            comment.author = users.at(random.bounded(users.size()));
+            comment.content = QuickComments::REACTIONS.at(random.bounded(QuickComments::REACTIONS.size()));
+            comment.timestamp = post.timestamp.addSecs(random.bounded(60, 7200));
+            comment.likesCount = random.bounded(0, 30);
+            post.comments.append(comment);
+        }
+        post.commentsCount = post.comments.size();
+
+        indexById.insert(post.postId, posts.size());
+        posts.append(SocialJson::postToJson(post));
+    }
+}
+
+// 游标就是偏移量的字符串形式，客户端应视为不透明
+QJsonObject MockSocialDataset::postsPage(const QString& cursor, int limit) const {
+    int offset = qBound(0, cursor.toInt(), posts.size());
+    int end = qMin(posts.size(), offset + limit);
+
+    QJsonArray page;
+    for (int i = offset; i < end; i++) {
+        QJsonObject post = posts.at(i).toObject();
+        // 列表接口不带评论，评论需单独请求
+        post.remove("comments");
+        page.append(post);
+    }
+
+    QJsonObject result;
+    result["posts"] = page;
+    result["cursor"] = QString::number(offset);
+    result["nextCursor"] = end < posts.size() ? QString::number(end) : QString();
+    return result;
+}
+
+QJsonObject MockSocialDataset::comments(const QString& postId) const {
+    auto it = indexById.constFind(postId);
+    if (it == indexById.constEnd()) return QJsonObject();
+
+    QJsonObject result;
+    result["postId"] = postId;
+    result["comments"] = posts.at(it.value()).toObject()["comments"];
+    return result;
+}
+
+QJsonObject MockSocialDataset::friends() const {
+    QJsonObject result;
+    result["friends"] = friendList;
+    return result;
+}
+
+QJsonObject MockSocialDataset::postState(int index) const {
+    QJsonObject post = posts.at(index).toObject();
+    QJsonObject state;
+    state["postId"] = post["postId"];
+    state["likesCount"] = post["likesCount"];
+    state["commentsCount"] = post["commentsCount"];
+    state["isLiked"] = post["isLiked"];
+    return state;
+}
+
+// 模拟服务只有一个客户端用户，isLiked 即该用户的点赞状态
+QJsonObject MockSocialDataset::applyMutation(const QJsonObject& mutation) {
+    QString mutationId = mutation["mutationId"].toString();
+    QString type = mutation["type"].toString();
+    int index = indexById.value(mutation["postId"].toString(), -1);
+
+    QJsonObject result;
+    result["mutationId"] = mutationId;
+
+    if (index < 0) {
+        result["status"] = "rejected";
+        return result;
+    }
+
+    if (appliedMutationIds.contains(mutationId)) {
+        result["status"] = "applied";
+        result["post"] = postState(index);
+        return result;
+    }
+
+    QJsonObject post = posts.at(index).toObject();
+    QString status = "applied";
+
+    if (type == "like" || type == "unlike") {
+        bool like = type == "like";
+        if (post["isLiked"].toBool() == like) {
+            status = "conflict";
+        } else {
+            post["isLiked"] = like;
+            post["likesCount"] = post["likesCount"].toInt() + (like ? 1 : -1);
+        }
+    } else if (type == "comment") {
+        QJsonArray comments = post["comments"].toArray();
+        comments.append(mutation["comment"]);
+        post["comments"] = comments;
+        post["commentsCount"] = comments.size();
+    } else {
+        result["status"] = "rejected";
+        return result;
+    }
+
+    if (status == "applied") {
+        posts[index] = post;
+        appliedMutationIds.insert(mutationId);
+    }
+
+    result["status"] = status;
+    result["post"] = postState(index);
+    return result;
+}
+
+// ==================== MockSocialDataSource ====================
+
+MockSocialDataSource::MockSocialDataSource(const MockSocialConfig& c, QObject* parent)
+    : SocialDataSource(parent),
+    config(c),
+    dataset(c),
+    random(c.seed ^ 0x5eed),
+    lastRequestId(0) {
+
+    qDebug() << "MockSocialDataSource:" << dataset.postCount() << "posts,"
+             << config.latencyMs << "±" << config.jitterMs << "ms latency,"
+             << config.failureRate * 100 << "% failures";
+}
+
+int MockSocialDataSource::nextDelay() {
+    int jitter = config.jitterMs > 0 ? random.bounded(-config.jitterMs, config.jitterMs + 1) : 0;
+    return qMax(0, config.latencyMs + jitter);
+}
+
+bool MockSocialDataSource::shouldFail() {
+    return random.generateDouble() < config.failureRate;
+}
+
+// 延迟后投递结果，或按失败率投递错误
+quint64 MockSocialDataSource::schedule(const std::function<void(quint64)>& deliver) {
+    quint64 requestId = ++lastRequestId;
+    bool fail = shouldFail();
+
+    QTimer::singleShot(nextDelay(), this, [this, requestId, fail, deliver]() {
+        if (fail) {
+            emit requestFailed(requestId, tr("Injected failure (503)"));
+        } else {
+            deliver(requestId);
+        }
+    });
+    return requestId;
+}
+
+quint64 MockSocialDataSource::fetchPosts(const QString& cursor, int limit) {
+    int pageSize = limit > 0 ? qMin(limit, config.maxPageSize) : config.pageSize;
+
+    return schedule([this, cursor, pageSize](quint64 requestId) {
+        QJsonObject result = dataset.postsPage(cursor, pageSize);
+
+        SocialPostPage page;
+        page.posts = SocialJson::postsFromJson(result["posts"].toArray());
+        page.cursor = result["cursor"].toString();
+        page.nextCursor = result["nextCursor"].toString();
+        emit postsFetched(requestId, page);
+    });
+}
+
+quint64 MockSocialDataSource::fetchComments(const QString& postId) {
+    return schedule([this, postId](quint64 requestId) {
+        QJsonObject result = dataset.comments(postId);
+        if (result.isEmpty()) {
+            emit requestFailed(requestId, tr("Post not found (404)"));
+            return;
+        }
+        emit commentsFetched(requestId, postId,
+                             SocialJson::commentsFromJson(result["comments"].toArray()));
+    });
+}
+
+quint64 MockSocialDataSource::fetchFriends() {
+    return schedule([this](quint64 requestId) {
+        emit friendsFetched(requestId,
+                            SocialJson::usersFromJson(dataset.friends()["friends"].toArray()));
+    });
+}
+
+quint64 MockSocialDataSource::postMutations(const QJsonArray& mutations) {
+    return schedule([this, mutations](quint64 requestId) {
+        QJsonArray results;
+        for (const QJsonValue& mutation : mutations) {
+            results.append(dataset.applyMutation(mutation.toObject()));
+        }
+        emit mutationsPosted(requestId, results);
+    });
+}
+
+// ==================== MockSocialServer ====================
+
+MockSocialServer::MockSocialServer(const MockSocialConfig& c, QObject* parent)
+    : QObject(parent),
+    config(c),
+    dataset(c),
+    random(c.seed ^ 0x5eed) {
+
+    server = new QTcpServer(this);
+    connect(server, &QTcpServer::newConnection, this, &MockSocialServer::onNewConnection);
+}
+
+bool MockSocialServer::listen(quint16 port) {
+    // 只监听本机回环地址
+    if (!server->listen(QHostAddress::LocalHost, port)) {
+        qDebug() << "MockSocialServer: failed to listen on port" << port << ":" << server->errorString();
+        return false;
+    }
+
+    qDebug() << "MockSocialServer: serving" << dataset.postCount() << "posts on http://127.0.0.1:"
+             << server->serverPort();
+    return true;
+}
+
+quint16 MockSocialServer::port() const {
+    return server->serverPort();
+}
+
+int MockSocialServer::nextDelay() {
+    int jitter = config.jitterMs > 0 ? random.bounded(-config.jitterMs, config.jitterMs + 1) : 0;
+    return qMax(0, config.latencyMs + jitter);
+}
+
+void MockSocialServer::onNewConnection() {
+    while (QTcpSocket* socket = server->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, &MockSocialServer::onReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, &MockSocialServer::onDisconnected);
+        buffers.insert(socket, QByteArray());
+    }
+}
+
+void MockSocialServer::onReadyRead() {
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket) return;
+
+    buffers[socket].append(socket->readAll());
+    processBuffer(socket);
+}
+
+void MockSocialServer::onDisconnected() {
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket) return;
+
+    buffers.remove(socket);
+    socket->deleteLater();
+}
+
+// 一个缓冲区内可能有多个请求
+void MockSocialServer::processBuffer(QTcpSocket* socket) {
+    QByteArray& buffer = buffers[socket];
+
+    int headerEnd;
+    while ((headerEnd = buffer.indexOf("\r\n\r\n")) >= 0) {
+        QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+        QHash<QByteArray, QByteArray> headers;
+        for (int i = 1; i < lines.size(); i++) {
+            int colon = lines.at(i).indexOf(':');
+            if (colon > 0) {
+                headers.insert(lines.at(i).left(colon).trimmed().toLower(),
+                               lines.at(i).mid(colon + 1).trimmed());
+            }
+        }
+
+        int bodyLength = headers.value("content-length").toInt();
+        if (buffer.size() < headerEnd + 4 + bodyLength) return;
+        QByteArray body = buffer.mid(headerEnd + 4, bodyLength);
+        buffer.remove(0, headerEnd + 4 + bodyLength);
+
+        QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+        if (requestLine.size() < 2) {
+            sendResponse(socket, 400, "{\"error\":\"bad request\"}", {});
+            continue;
+        }
+        handleRequest(socket, requestLine.at(0), requestLine.at(1), headers, body);
+    }
+}
+
+void MockSocialServer::handleRequest(QTcpSocket* socket, const QByteArray& method,
+                                     const QByteArray& target,
+                                     const QHash<QByteArray, QByteArray>& headers,
+                                     const QByteArray& body) {
+    QUrl url(QString::fromUtf8(target));
+    QUrlQuery query(url);
+    QStringList segments = url.path().split('/', Qt::SkipEmptyParts);
+
+    int status = 200;
+    QJsonObject result;
+
+    // 失败注入在处理之前，失败的请求不会产生副作用
+    bool injectFailure = random.generateDouble() < config.failureRate;
+
+    if (method == "POST" && segments == QStringList{"mutations"}) {
+        if (!injectFailure) {
+            QJsonArray results;
+            for (const QJsonValue& mutation : QJsonDocument::fromJson(body).object()["mutations"].toArray()) {
+                results.append(dataset.applyMutation(mutation.toObject()));
+            }
+            result["results"] = results;
+        }
+    } else if (method != "GET") {
+        status = 405;
+        result["error"] = "method not allowed";
+    } else if (segments == QStringList{"posts"}) {
+        int limit = query.queryItemValue("limit").toInt();
+        limit = limit > 0 ? qMin(limit, config.maxPageSize) : config.pageSize;
+        result = dataset.postsPage(query.queryItemValue("cursor"), limit);
+    } else if (segments.size() == 3 && segments.at(0) == "posts" && segments.at(2) == "comments") {
+        result = dataset.comments(segments.at(1));
+        if (result.isEmpty()) {
+            status = 404;
+            result["error"] = "post not found";
+        }
+    } else if (segments == QStringList{"friends"}) {
+        result = dataset.friends();
+    } else {
+        status = 404;
+        result["error"] = "not found";
+    }
+
+    if (status == 200 && injectFailure) {
+        status = 503;
+        result = QJsonObject();
+        result["error"] = "injected failure";
+    }
+
+    QByteArray responseBody = QJsonDocument(result).toJson(QJsonDocument::Compact);
+    QList<QPair<QByteArray, QByteArray>> extraHeaders;
+
+    if (status == 200 && method == "GET") {
+        QByteArray etag = '"' + QCryptographicHash::hash(responseBody, QCryptographicHash::Sha1).toHex().left(16) + '"';
+        extraHeaders << qMakePair(QByteArray("ETag"), etag);
+        extraHeaders << qMakePair(QByteArray("Cache-Control"),
+                                  QByteArray("max-age=") + QByteArray::number(config.cacheMaxAgeSec));
+
+        if (headers.value("if-none-match") == etag) {
+            status = 304;
+            responseBody.clear();
+        }
+    }
+
+    // 模拟网络延迟；连接在等待期间断开时 QPointer 为空
+    QPointer<QTcpSocket> pendingSocket(socket);
+    QTimer::singleShot(nextDelay(), this, [this, pendingSocket, status, responseBody, extraHeaders]() {
+        if (pendingSocket) {
+            sendResponse(pendingSocket, status, responseBody, extraHeaders);
+        }
+    });
+}
+
+void MockSocialServer::sendResponse(QTcpSocket* socket, int status, const QByteArray& body,
+                                    const QList<QPair<QByteArray, QByteArray>>& extraHeaders) {
+    static const QHash<int, QByteArray> reasons = {
+        {200, "OK"}, {304, "Not Modified"}, {400, "Bad Request"}, {404, "Not Found"},
+        {405, "Method Not Allowed"}, {503, "Service Unavailable"}
+    };
+
+    QByteArray response = "HTTP/1.1 " + QByteArray::number(status) + ' ' + reasons.value(status) + "\r\n";
+    if (status != 304) {
+        response += "Content-Type: application/json\r\n";
+    }
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    for (const auto& header : extraHeaders) {
+        response += header.first + ": " + header.second + "\r\n";
+    }
+    response += "\r\n";
+    response += body;
+
+    socket->write(response);
+}
+
+bool MockSocialServer::isServerMode(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], CommandLineFlag, std::strlen(CommandLineFlag)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int MockSocialServer::runStandalone(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Tomeo");
+
+    quint16 port = DefaultPort;
+    for (int i = 1; i < argc; i++) {
+        QString argument = QString::fromLocal8Bit(argv[i]);
+        QString prefix = QString(CommandLineFlag) + "=";
+        if (argument.startsWith(prefix)) {
+            port = argument.mid(prefix.size()).toUShort();
+        }
+    }
+
+    MockSocialServer server(MockSocialConfig::load());
+    if (!server.listen(port)) {
+        return 1;
+    }
+    return app.exec();
+}
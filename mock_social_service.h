@@ -0,0 +1,132 @@
+//
+// MockSocialService - 本地模拟社交服务
+// Iteration 4: 生成可复现的帖子/评论/好友数据，按配置注入延迟、抖动和失败；
+//              可作为进程内数据源，也可作为独立进程提供 HTTP/JSON 接口
+//
+
+#ifndef MOCK_SOCIAL_SERVICE_H
+#define MOCK_SOCIAL_SERVICE_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <functional>
+#include "social_data_source.h"
+
+// 模拟服务参数，保存在 QSettings("Tomeo", "MockSocialService")
+struct MockSocialConfig {
+    int latencyMs;         // 平均延迟
+    int jitterMs;          // 延迟在 ±jitter 内均匀分布
+    int pageSize;          // 默认页大小
+    int maxPageSize;
+    double failureRate;    // 0~1，按概率返回 503
+    int postCount;
+    int cacheMaxAgeSec;    // 响应的 Cache-Control max-age
+    quint32 seed;          // 数据生成种子，保证每次运行数据一致
+
+    MockSocialConfig()
+        : latencyMs(120), jitterMs(60), pageSize(20), maxPageSize(100),
+        failureRate(0.05), postCount(500), cacheMaxAgeSec(30), seed(42) {}
+
+    static MockSocialConfig load();
+    void save() const;
+};
+
+// 数据以 JSON 形式保存，与线上接口格式一致
+class MockSocialDataset {
+private:
+    QJsonArray posts;                      // 按发布时间倒序
+    QHash<QString, int> indexById;
+    QJsonArray friendList;
+    QSet<QString> appliedMutationIds;      // 重试的同一变更只生效一次
+
+    QJsonObject postState(int index) const;
+
+public:
+    explicit MockSocialDataset(const MockSocialConfig& config);
+
+    // {"posts": [...], "cursor": "...", "nextCursor": "..."}
+    QJsonObject postsPage(const QString& cursor, int limit) const;
+    // {"postId": "...", "comments": [...]}，帖子不存在时返回空对象
+    QJsonObject comments(const QString& postId) const;
+    // {"friends": [...]}
+    QJsonObject friends() const;
+
+    // 应用一条变更，返回 {"mutationId", "status": applied|conflict|rejected, "post": {...}}
+    QJsonObject applyMutation(const QJsonObject& mutation);
+
+    int postCount() const { return posts.size(); }
+};
+
+// 进程内数据源：不经过网络，但同样按配置模拟延迟和失败
+class MockSocialDataSource : public SocialDataSource {
+    Q_OBJECT
+
+private:
+    MockSocialConfig config;
+    MockSocialDataset dataset;
+    QRandomGenerator random;
+    quint64 lastRequestId;
+
+    int nextDelay();
+    bool shouldFail();
+    quint64 schedule(const std::function<void(quint64)>& deliver);
+
+public:
+    explicit MockSocialDataSource(const MockSocialConfig& config, QObject* parent = nullptr);
+
+    QString name() const override { return "mock"; }
+    quint64 fetchPosts(const QString& cursor, int limit) override;
+    quint64 fetchComments(const QString& postId) override;
+    quint64 fetchFriends() override;
+    quint64 postMutations(const QJsonArray& mutations) override;
+};
+
+// 最小 HTTP/1.1 服务：
+//   GET /posts?cursor=<c>&limit=<n>
+//   GET /posts/<postId>/comments
+//   GET /friends
+//   POST /mutations   {"mutations": [...]} -> {"results": [...]}
+// 响应带 ETag 和 Cache-Control，支持 If-None-Match 返回 304
+class MockSocialServer : public QObject {
+    Q_OBJECT
+
+private:
+    MockSocialConfig config;
+    MockSocialDataset dataset;
+    QRandomGenerator random;
+    QTcpServer* server;
+    QHash<QTcpSocket*, QByteArray> buffers;
+
+    void processBuffer(QTcpSocket* socket);
+    void handleRequest(QTcpSocket* socket, const QByteArray& method, const QByteArray& target,
+                       const QHash<QByteArray, QByteArray>& headers, const QByteArray& body);
+    void sendResponse(QTcpSocket* socket, int status, const QByteArray& body,
+                      const QList<QPair<QByteArray, QByteArray>>& extraHeaders);
+    int nextDelay();
+
+public:
+    static const char* CommandLineFlag;   // --mock-social-server[=port]
+    static const quint16 DefaultPort;
+
+    explicit MockSocialServer(const MockSocialConfig& config, QObject* parent = nullptr);
+
+    bool listen(quint16 port);
+    quint16 port() const;
+
+    // 独立进程模式：命令行带 CommandLineFlag 时只运行服务
+    static bool isServerMode(int argc, char* argv[]);
+    static int runStandalone(int argc, char* argv[]);
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void onDisconnected();
+};
+
+#endif // MOCK_SOCIAL_SERVICE_H
@@ -0,0 +1,434 @@
+//
+// Mp4Parser - 实现
+//
+
+#include "mp4_parser.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <algorithm>
+#include <cstring>
+
+static const char* CheckFlag = "--check-media";
+
+// box 类型按大端 fourcc 比较，解析过程中不分配内存
+static quint32 fourCC(const char* s) {
+    return (quint32(uchar(s[0])) << 24) | (quint32(uchar(s[1])) << 16) |
+           (quint32(uchar(s[2])) << 8) | quint32(uchar(s[3]));
+}
+
+static QString typeName(quint32 type) {
+    char name[5] = {
+        char(type >> 24), char((type >> 16) & 0xff), char((type >> 8) & 0xff), char(type & 0xff), 0
+    };
+    return QString::fromLatin1(name);
+}
+
+static const quint32 FtypBox = fourCC("ftyp");
+static const quint32 MoovBox = fourCC("moov");
+static const quint32 MdatBox = fourCC("mdat");
+static const quint32 FreeBox = fourCC("free");
+static const quint32 SkipBox = fourCC("skip");
+static const quint32 WideBox = fourCC("wide");
+static const quint32 PnotBox = fourCC("pnot");
+static const quint32 MvhdBox = fourCC("mvhd");
+static const quint32 TrakBox = fourCC("trak");
+static const quint32 TkhdBox = fourCC("tkhd");
+static const quint32 MdiaBox = fourCC("mdia");
+static const quint32 MdhdBox = fourCC("mdhd");
+static const quint32 HdlrBox = fourCC("hdlr");
+static const quint32 MinfBox = fourCC("minf");
+static const quint32 StblBox = fourCC("stbl");
+static const quint32 StsdBox = fourCC("stsd");
+static const quint32 SttsBox = fourCC("stts");
+static const quint32 StssBox = fourCC("stss");
+static const quint32 StszBox = fourCC("stsz");
+static const quint32 StcoBox = fourCC("stco");
+static const quint32 Co64Box = fourCC("co64");
+static const quint32 VideHandler = fourCC("vide");
+static const quint32 SounHandler = fourCC("soun");
+
+// 防止恶意文件构造过深的嵌套
+static const int MaxBoxDepth = 16;
+
+qint64 Mp4Info::keyframeBefore(qint64 positionMs) const {
+    if (keyframesMs.isEmpty()) return positionMs;
+
+    auto it = std::upper_bound(keyframesMs.constBegin(), keyframesMs.constEnd(), positionMs);
+    if (it == keyframesMs.constBegin()) return keyframesMs.first();
+    return *(it - 1);
+}
+
+Mp4Parser::Mp4Parser(const uchar* bytes, qint64 length)
+    : data(bytes),
+    size(length),
+    sawMoov(false),
+    chunkLimit(0) {
+    info.status = Mp4Info::Ok;
+}
+
+quint32 Mp4Parser::u32(qint64 offset) const {
+    return (quint32(data[offset]) << 24) | (quint32(data[offset + 1]) << 16) |
+           (quint32(data[offset + 2]) << 8) | quint32(data[offset + 3]);
+}
+
+quint64 Mp4Parser::u64(qint64 offset) const {
+    return (quint64(u32(offset)) << 32) | u32(offset + 4);
+}
+
+// 只升级问题的严重程度：截断之后再发现损坏则记为损坏
+void Mp4Parser::fail(Mp4Info::Status status, const QString& problem) {
+    if (info.status == Mp4Info::Ok ||
+        (info.status == Mp4Info::Truncated && status != Mp4Info::Truncated)) {
+        info.status = status;
+        info.problem = problem;
+    }
+}
+
+bool Mp4Parser::require(quint32 type, qint64 payload, qint64 end, qint64 length) {
+    if (length < 0 || payload + length > end) {
+        fail(Mp4Info::Corrupt, QString("%1 box is too short").arg(typeName(type)));
+        return false;
+    }
+    return true;
+}
+
+Mp4Info Mp4Parser::parse(const uchar* data, qint64 size) {
+    Mp4Parser parser(data, size);
+
+    // 第一个 box 决定是否为 ISO-BMFF / QuickTime 文件
+    quint32 firstType = size >= 8 ? parser.u32(4) : 0;
+    if (firstType != FtypBox && firstType != MoovBox && firstType != MdatBox &&
+        firstType != FreeBox && firstType != SkipBox && firstType != WideBox &&
+        firstType != PnotBox) {
+        parser.info.status = Mp4Info::NotIsoMedia;
+        parser.info.problem = "not an MP4/MOV file";
+        return parser.info;
+    }
+
+    parser.parseBoxes(0, size, 0, 0);
+
+    if (!parser.sawMoov) {
+        parser.fail(Mp4Info::Corrupt, "missing moov box");
+    } else if (parser.chunkLimit >= size) {
+        parser.fail(Mp4Info::Truncated, "media chunks point past the end of the file");
+    }
+
+    return parser.info;
+}
+
+Mp4Info Mp4Parser::parseFile(const QString& path) {
+    Mp4Info info;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        info.problem = file.errorString();
+        return info;
+    }
+
+    qint64 size = file.size();
+    if (size < 8) {
+        info.status = Mp4Info::NotIsoMedia;
+        info.problem = "file too small";
+        return info;
+    }
+
+    // 只有被访问的页（box 头和 moov）会真正读入
+    uchar* mapped = file.map(0, size);
+    if (!mapped) {
+        info.problem = file.errorString();
+        return info;
+    }
+
+    info = parse(mapped, size);
+    file.unmap(mapped);
+    return info;
+}
+
+bool Mp4Parser::isCandidate(const QString& path) {
+    QString suffix = QFileInfo(path).suffix().toLower();
+    return suffix == "mp4" || suffix == "mov" || suffix == "m4v" || suffix == "3gp";
+}
+
+bool Mp4Parser::parseBoxes(qint64 begin, qint64 end, int depth, quint32 parent) {
+    if (depth > MaxBoxDepth) {
+        fail(Mp4Info::Corrupt, "boxes nested too deeply");
+        return false;
+    }
+
+    qint64 offset = begin;
+    while (offset < end) {
+        if (end - offset < 8) {
+            fail(depth == 0 ? Mp4Info::Truncated : Mp4Info::Corrupt, "incomplete box header");
+            return depth == 0;
+        }
+
+        quint64 boxSize = u32(offset);
+        quint32 type = u32(offset + 4);
+        qint64 header = 8;
+
+        if (boxSize == 1) {
+            if (end - offset < 16) {
+                fail(Mp4Info::Corrupt, "incomplete 64-bit box header");
+                return false;
+            }
+            boxSize = u64(offset + 8);
+            header = 16;
+        } else if (boxSize == 0) {
+            // 大小为 0 表示延伸到父容器末尾
+            boxSize = quint64(end - offset);
+        }
+
+        if (boxSize < quint64(header)) {
+            fail(Mp4Info::Corrupt, QString("invalid size for %1 box").arg(typeName(type)));
+            return false;
+        }
+
+        if (boxSize > quint64(end - offset)) {
+            if (depth == 0 && type != MoovBox) {
+                // 顶层的 mdat 等被截断：元数据可能仍然完整
+                fail(Mp4Info::Truncated, QString("%1 box runs past the end of the file").arg(typeName(type)));
+                boxSize = quint64(end - offset);
+            } else {
+                fail(Mp4Info::Corrupt, QString("%1 box exceeds its container").arg(typeName(type)));
+                return false;
+            }
+        }
+
+        if (!parseBox(type, offset + header, offset + qint64(boxSize), depth, parent)) {
+            return false;
+        }
+        offset += qint64(boxSize);
+    }
+    return true;
+}
+
+bool Mp4Parser::parseBox(quint32 type, qint64 payload, qint64 end, int depth, quint32 parent) {
+    if (type == MoovBox) {
+        sawMoov = true;
+        return parseBoxes(payload, end, depth + 1, type);
+    }
+
+    if (type == TrakBox) {
+        track = Track();
+        bool ok = parseBoxes(payload, end, depth + 1, type);
+        if (ok) finishTrack();
+        return ok;
+    }
+
+    if (type == MdiaBox || type == MinfBox || type == StblBox) {
+        return parseBoxes(payload, end, depth + 1, type);
+    }
+
+    if (type == FtypBox) {
+        if (payload + 4 <= end) {
+            info.brand = QByteArray(reinterpret_cast<const char*>(data + payload), 4);
+        }
+        return true;
+    }
+
+    if (type == MvhdBox) {
+        if (!require(type, payload, end, 4)) return false;
+        bool v1 = data[payload] == 1;
+        if (!require(type, payload, end, v1 ? 32 : 20)) return false;
+
+        quint32 timescale = u32(payload + (v1 ? 20 : 12));
+        quint64 duration = v1 ? u64(payload + 24) : u32(payload + 16);
+        if (timescale > 0) {
+            info.durationMs = qint64(duration * 1000 / timescale);
+        }
+        return true;
+    }
+
+    if (type == TkhdBox) {
+        if (!require(type, payload, end, 4)) return false;
+        bool v1 = data[payload] == 1;
+        qint64 sizeOffset = v1 ? 88 : 76;
+        if (!require(type, payload, end, sizeOffset + 8)) return false;
+
+        // 16.16 定点数
+        track.width = int(u32(payload + sizeOffset) >> 16);
+        track.height = int(u32(payload + sizeOffset + 4) >> 16);
+        return true;
+    }
+
+    if (type == MdhdBox) {
+        if (!require(type, payload, end, 4)) return false;
+        bool v1 = data[payload] == 1;
+        if (!require(type, payload, end, v1 ? 24 : 16)) return false;
+        track.timescale = u32(payload + (v1 ? 20 : 12));
+        return true;
+    }
+
+    // 轨道类型只看 mdia 下的 hdlr；QuickTime 在 minf 里还有一个数据引用 hdlr（dhlr / alis），不能覆盖它
+    if (type == HdlrBox) {
+        if (parent != MdiaBox) return true;
+        if (!require(type, payload, end, 12)) return false;
+        track.handler = u32(payload + 8);
+        return true;
+    }
+
+    if (type == StsdBox) {
+        // 版本/标志、条目数、第一个条目的大小，然后是编码 fourcc
+        if (!require(type, payload, end, 16)) return false;
+        if (u32(payload + 4) > 0) {
+            track.codec = u32(payload + 12);
+        }
+        return true;
+    }
+
+    if (type == SttsBox) {
+        if (!require(type, payload, end, 8)) return false;
+        quint32 count = u32(payload + 4);
+        if (!require(type, payload, end, 8 + qint64(count) * 8)) return false;
+        track.stts = data + payload + 8;
+        track.sttsCount = count;
+        return true;
+    }
+
+    if (type == StssBox) {
+        if (!require(type, payload, end, 8)) return false;
+        quint32 count = u32(payload + 4);
+        if (!require(type, payload, end, 8 + qint64(count) * 4)) return false;
+        track.stss = data + payload + 8;
+        track.stssCount = count;
+        track.hasStss = true;
+        return true;
+    }
+
+    if (type == StszBox) {
+        if (!require(type, payload, end, 12)) return false;
+        track.sampleCount = u32(payload + 8);
+        return true;
+    }
+
+    if (type == StcoBox || type == Co64Box) {
+        if (!require(type, payload, end, 8)) return false;
+        quint32 count = u32(payload + 4);
+        qint64 entrySize = type == Co64Box ? 8 : 4;
+        if (!require(type, payload, end, 8 + qint64(count) * entrySize)) return false;
+
+        // 块偏移超出文件说明 mdat 被截断
+        for (quint32 i = 0; i < count; i++) {
+            qint64 offset = payload + 8 + qint64(i) * entrySize;
+            qint64 chunk = type == Co64Box ? qint64(u64(offset)) : qint64(u32(offset));
+            chunkLimit = qMax(chunkLimit, chunk);
+        }
+        return true;
+    }
+
+    // 其他 box（mdat、udta、edts 等）只跳过
+    Q_UNUSED(depth);
+    return true;
+}
+
+void Mp4Parser::finishTrack() {
+    if (track.handler == SounHandler) {
+        info.hasAudio = true;
+        return;
+    }
+
+    // 只取第一条视频轨
+    if (track.handler != VideHandler || !info.videoCodec.isEmpty()) return;
+
+    info.width = track.width;
+    info.height = track.height;
+    info.videoSampleCount = track.sampleCount;
+    if (track.codec != 0) {
+        info.videoCodec = typeName(track.codec).toLatin1();
+    } else {
+        info.videoCodec = "????";
+    }
+
+    if (!track.hasStss) {
+        info.allFramesKey = true;
+        return;
+    }
+    if (track.timescale == 0 || !track.stts) return;
+
+    // 沿 stts 累加时间，把 stss 中的样本序号（从 1 开始）换算成毫秒
+    info.keyframesMs.reserve(int(track.stssCount));
+    quint64 time = 0;
+    quint64 firstSample = 1;
+    quint32 entry = 0;
+    quint32 previous = 0;
+
+    for (quint32 k = 0; k < track.stssCount; k++) {
+        quint32 sample = u32(track.stss - data + qint64(k) * 4);
+        if (sample <= previous) {
+            fail(Mp4Info::Corrupt, "sync sample table is not sorted");
+            return;
+        }
+        previous = sample;
+
+        while (entry < track.sttsCount) {
+            quint32 count = u32(track.stts - data + qint64(entry) * 8);
+            if (sample < firstSample + count) break;
+            quint32 delta = u32(track.stts - data + qint64(entry) * 8 + 4);
+            time += quint64(count) * delta;
+            firstSample += count;
+            entry++;
+        }
+        if (entry >= track.sttsCount) break;
+
+        quint32 delta = u32(track.stts - data + qint64(entry) * 8 + 4);
+        quint64 sampleTime = time + (sample - firstSample) * quint64(delta);
+        info.keyframesMs.append(qint64(sampleTime * 1000 / track.timescale));
+    }
+}
+
+// ==================== 检查模式 ====================
+
+bool Mp4Parser::isCheckMode(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], CheckFlag, std::strlen(CheckFlag)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int Mp4Parser::runCheck(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Tomeo");
+
+    // --check-media[=目录]，默认 test_videos
+    QString directory = "test_videos";
+    for (int i = 1; i < argc; i++) {
+        QString argument = QString::fromLocal8Bit(argv[i]);
+        QString prefix = QString(CheckFlag) + "=";
+        if (argument.startsWith(prefix) && argument.size() > prefix.size()) {
+            directory = argument.mid(prefix.size());
+        }
+    }
+
+    int checked = 0;
+    int failures = 0;
+    QDirIterator it(directory, QDir::Files);
+    while (it.hasNext()) {
+        QString path = it.next();
+        if (!isCandidate(path)) continue;
+
+        Mp4Info info = parseFile(path);
+        checked++;
+
+        // 能播放的文件必须解析出视频轨，否则扫描得不到分辨率、编码和关键帧
+        bool ok = info.isPlayable() && !info.videoCodec.isEmpty() && info.width > 0 && info.height > 0;
+        if (!ok) failures++;
+
+        qDebug().noquote() << QString("  %1 %2 %3 %4x%5 %6 ms, %7 keyframes%8%9")
+                                  .arg(ok ? "ok  " : "FAIL")
+                                  .arg(QFileInfo(path).fileName(), -12)
+                                  .arg(QString::fromLatin1(info.videoCodec), -4)
+                                  .arg(info.width).arg(info.height)
+                                  .arg(info.durationMs)
+                                  .arg(info.allFramesKey ? QString("all") : QString::number(info.keyframesMs.size()))
+                                  .arg(info.hasAudio ? ", audio" : "")
+                                  .arg(info.problem.isEmpty() ? QString() : " - " + info.problem);
+    }
+
+    qDebug().noquote() << QString("Media check: %1 files in %2, %3 failed").arg(checked).arg(directory).arg(failures);
+    return failures == 0 && checked > 0 ? 0 : 1;
+}
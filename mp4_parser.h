@@ -0,0 +1,98 @@
+//
+// Mp4Parser - MP4/MOV（ISO-BMFF）容器解析
+// Iteration 4: 内存映射文件，只读取 box 头和 moov 中的少量表，
+//              微秒级得到时长、分辨率、关键帧表，并在扫描时发现截断/损坏的文件；
+//              --check-media[=目录] 检查一批文件的解析结果
+//
+
+#ifndef MP4_PARSER_H
+#define MP4_PARSER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+struct Mp4Info {
+    enum Status {
+        Ok,
+        Truncated,      // 媒体数据超出文件末尾，通常只能播放前半段
+        Corrupt,        // box 结构或 moov 损坏，无法播放
+        NotIsoMedia,    // 不是 MP4/MOV
+        Unreadable      // 无法打开或映射
+    };
+
+    Status status;
+    QString problem;          // 人类可读的问题描述
+    QByteArray brand;         // ftyp 主品牌，如 "isom"、"qt  "
+    qint64 durationMs;
+    int width;
+    int height;
+    QByteArray videoCodec;    // 样本描述 fourcc，如 "avc1"、"hvc1"
+    bool hasAudio;
+    quint32 videoSampleCount;
+    bool allFramesKey;        // 没有 stss：每一帧都是关键帧
+    QVector<qint64> keyframesMs;
+
+    Mp4Info()
+        : status(Unreadable), durationMs(0), width(0), height(0),
+        hasAudio(false), videoSampleCount(0), allFramesKey(false) {}
+
+    bool isPlayable() const { return status == Ok || status == Truncated; }
+
+    // 不晚于 positionMs 的最近关键帧，没有关键帧表时原样返回
+    qint64 keyframeBefore(qint64 positionMs) const;
+};
+
+class Mp4Parser {
+private:
+    // 正在解析的轨道
+    struct Track {
+        quint32 handler;
+        quint32 codec;
+        quint32 timescale;
+        int width;
+        int height;
+        quint32 sampleCount;
+        const uchar* stts;      // 指向映射内存中的表，不复制
+        quint32 sttsCount;
+        const uchar* stss;
+        quint32 stssCount;
+        bool hasStss;
+
+        Track()
+            : handler(0), codec(0), timescale(0), width(0), height(0), sampleCount(0),
+            stts(nullptr), sttsCount(0), stss(nullptr), stssCount(0), hasStss(false) {}
+    };
+
+    const uchar* data;
+    qint64 size;
+    Mp4Info info;
+    Track track;
+    bool sawMoov;
+    qint64 chunkLimit;          // 最大的块偏移，用于判断媒体数据是否完整
+
+    Mp4Parser(const uchar* data, qint64 size);
+
+    // parent 为外层容器的类型，顶层为 0
+    bool parseBoxes(qint64 begin, qint64 end, int depth, quint32 parent);
+    bool parseBox(quint32 type, qint64 payload, qint64 end, int depth, quint32 parent);
+    bool require(quint32 type, qint64 payload, qint64 end, qint64 length);
+    void finishTrack();
+    void fail(Mp4Info::Status status, const QString& problem);
+
+    quint32 u32(qint64 offset) const;
+    quint64 u64(qint64 offset) const;
+
+public:
+    // 解析整段内存（通常是映射后的文件）
+    static Mp4Info parse(const uchar* data, qint64 size);
+    static Mp4Info parseFile(const QString& path);
+
+    static bool isCandidate(const QString& path);
+
+    // --check-media[=目录]：解析目录中的每个 MP4/MOV 并打印结果，有文件缺少视频轨时返回非零
+    static bool isCheckMode(int argc, char* argv[]);
+    static int runCheck(int argc, char* argv[]);
+};
+
+#endif // MP4_PARSER_H
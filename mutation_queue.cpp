@@ -0,0 +1,338 @@
+//
+// MutationQueue - 实现
+//
+
+#include "mutation_queue.h"
+#include "social_data_source.h"
+#include "social_json.h"
+#include "social_manager.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QStandardPaths>
+#include <QUuid>
+
+MutationQueue* MutationQueue::instance = nullptr;
+
+// 攒批窗口：连续点击合并为一次请求
+static const int BatchWindowMs = 500;
+static const int MaxBatchSize = 50;
+// 失败重试：1s 起步，每次翻倍，上限 60s，另加最多 25% 的随机抖动
+static const int InitialRetryMs = 1000;
+static const int MaxRetryMs = 60000;
+
+// ==================== PendingMutation ====================
+
+QJsonObject PendingMutation::toJson() const {
+    QJsonObject object;
+    object["mutationId"] = mutationId;
+    object["type"] = type;
+    object["postId"] = postId;
+    if (type == "comment") {
+        object["comment"] = SocialJson::commentToJson(comment);
+    }
+    object["createdAt"] = createdAt.toString(Qt::ISODateWithMs);
+    object["attempts"] = attempts;
+    return object;
+}
+
+PendingMutation PendingMutation::fromJson(const QJsonObject& object) {
+    PendingMutation mutation;
+    mutation.mutationId = object["mutationId"].toString();
+    mutation.type = object["type"].toString();
+    mutation.postId = object["postId"].toString();
+    if (object.contains("comment")) {
+        mutation.comment = SocialJson::commentFromJson(object["comment"].toObject());
+    }
+    mutation.createdAt = QDateTime::fromString(object["createdAt"].toString(), Qt::ISODateWithMs);
+    mutation.attempts = object["attempts"].toInt();
+    return mutation;
+}
+
+// ==================== MutationQueue ====================
+
+MutationQueue::MutationQueue(QObject* parent)
+    : QObject(parent),
+    inFlightRequest(0),
+    consecutiveFailures(0),
+    lastLocalId(0) {
+
+    QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dataDir);
+    storagePath = dataDir + "/pending_mutations.json";
+    load();
+
+    flushTimer = new QTimer(this);
+    flushTimer->setSingleShot(true);
+    connect(flushTimer, &QTimer::timeout, this, &MutationQueue::flush);
+
+    SocialManager* manager = SocialManager::getInstance();
+    connect(manager, &SocialManager::dataSourceChanged, this, &MutationQueue::attachSource);
+    if (manager->getDataSource()) {
+        attachSource(manager->getDataSource());
+    }
+}
+
+MutationQueue* MutationQueue::getInstance() {
+    if (instance == nullptr) {
+        instance = new MutationQueue();
+    }
+    return instance;
+}
+
+void MutationQueue::likePost(const QString& postId) {
+    SocialManager* manager = SocialManager::getInstance();
+    VideoPost before = manager->getPost(postId);
+    manager->likePost(postId);
+
+    // 状态未变化（帖子不存在或已点赞）时不产生变更
+    if (before.postId.isEmpty() || before.isLiked || !source) return;
+
+    // 尚未发出的“取消点赞”与本次点赞相互抵消
+    if (cancelOpposite(postId, "unlike")) return;
+
+    PendingMutation mutation;
+    mutation.type = "like";
+    mutation.postId = postId;
+    enqueue(mutation);
+}
+
+void MutationQueue::unlikePost(const QString& postId) {
+    SocialManager* manager = SocialManager::getInstance();
+    VideoPost before = manager->getPost(postId);
+    manager->unlikePost(postId);
+
+    if (before.postId.isEmpty() || !before.isLiked || !source) return;
+    if (cancelOpposite(postId, "like")) return;
+
+    PendingMutation mutation;
+    mutation.type = "unlike";
+    mutation.postId = postId;
+    enqueue(mutation);
+}
+
+void MutationQueue::addComment(const QString& postId, const Comment& comment) {
+    SocialManager::getInstance()->addComment(postId, comment);
+    if (!source) return;
+
+    PendingMutation mutation;
+    mutation.type = "comment";
+    mutation.postId = postId;
+    mutation.comment = comment;
+    enqueue(mutation);
+}
+
+void MutationQueue::enqueue(const PendingMutation& m) {
+    PendingMutation mutation = m;
+    mutation.mutationId = nextMutationId();
+    mutation.createdAt = QDateTime::currentDateTime();
+    pending.append(mutation);
+    save();
+
+    qDebug() << "MutationQueue: queued" << mutation.type << mutation.postId
+             << "pending:" << pending.size();
+    emit pendingCountChanged(pending.size());
+
+    // 退避期间定时器已在运行，不提前重试
+    if (pending.size() - inFlightIds.size() >= MaxBatchSize && consecutiveFailures == 0) {
+        scheduleFlush(0);
+    } else if (!flushTimer->isActive()) {
+        scheduleFlush(BatchWindowMs);
+    }
+}
+
+bool MutationQueue::cancelOpposite(const QString& postId, const QString& type) {
+    for (int i = pending.size() - 1; i >= 0; i--) {
+        const PendingMutation& mutation = pending[i];
+        if (mutation.postId != postId) continue;
+        if (mutation.type != type || inFlightIds.contains(mutation.mutationId)) return false;
+
+        qDebug() << "MutationQueue: cancelled pending" << type << postId;
+        pending.remove(i);
+        save();
+        emit pendingCountChanged(pending.size());
+        return true;
+    }
+    return false;
+}
+
+bool MutationQueue::hasPendingForPost(const QString& postId) const {
+    for (const PendingMutation& mutation : pending) {
+        if (mutation.postId == postId) return true;
+    }
+    return false;
+}
+
+QString MutationQueue::nextMutationId() {
+    return QString("m_%1_%2")
+        .arg(QUuid::createUuid().toString(QUuid::WithoutBraces))
+        .arg(++lastLocalId);
+}
+
+void MutationQueue::scheduleFlush(int delayMs) {
+    flushTimer->start(delayMs);
+}
+
+int MutationQueue::retryDelay() const {
+    int shift = qMin(consecutiveFailures - 1, 6);
+    int delay = qMin(MaxRetryMs, InitialRetryMs << qMax(shift, 0));
+    return delay + QRandomGenerator::global()->bounded(delay / 4 + 1);
+}
+
+void MutationQueue::attachSource(SocialDataSource* dataSource) {
+    if (source) {
+        disconnect(source, nullptr, this, nullptr);
+    }
+
+    // 旧数据源的在途批次作废，未确认的变更会重新发送（服务端按 mutationId 去重）
+    source = dataSource;
+    inFlightRequest = 0;
+    inFlightIds.clear();
+    consecutiveFailures = 0;
+
+    if (!source) return;
+
+    connect(source, &SocialDataSource::mutationsPosted, this, &MutationQueue::onMutationsPosted);
+    connect(source, &SocialDataSource::requestFailed, this, &MutationQueue::onRequestFailed);
+
+    if (!pending.isEmpty()) {
+        qDebug() << "MutationQueue:" << pending.size() << "pending mutations to upload to" << source->name();
+        scheduleFlush(0);
+    }
+}
+
+void MutationQueue::flush() {
+    if (!source || inFlightRequest != 0 || pending.isEmpty()) return;
+
+    QJsonArray batch;
+    for (PendingMutation& mutation : pending) {
+        if (batch.size() >= MaxBatchSize) break;
+        mutation.attempts++;
+        inFlightIds.insert(mutation.mutationId);
+        batch.append(mutation.toJson());
+    }
+    save();
+
+    qDebug() << "MutationQueue: uploading" << batch.size() << "mutations";
+    inFlightRequest = source->postMutations(batch);
+}
+
+void MutationQueue::onMutationsPosted(quint64 requestId, const QJsonArray& results) {
+    if (requestId != inFlightRequest) return;
+    inFlightRequest = 0;
+    consecutiveFailures = 0;
+
+    SocialManager* manager = SocialManager::getInstance();
+    QHash<QString, QJsonObject> serverStates;   // postId -> 最新的服务端状态
+
+    for (const QJsonValue& value : results) {
+        QJsonObject result = value.toObject();
+        QString mutationId = result["mutationId"].toString();
+        QString status = result["status"].toString();
+
+        int index = -1;
+        for (int i = 0; i < pending.size(); i++) {
+            if (pending[i].mutationId == mutationId) {
+                index = i;
+                break;
+            }
+        }
+        if (index < 0) continue;
+
+        PendingMutation mutation = pending.takeAt(index);
+        inFlightIds.remove(mutationId);
+
+        if (status == "rejected") {
+            qDebug() << "MutationQueue: rejected" << mutation.type << mutation.postId;
+            // 撤销本地已生效的修改；同一帖子还有后续变更时以后续变更为准，由对账收尾
+            if (mutation.type == "comment") {
+                manager->deleteComment(mutation.postId, mutation.comment.commentId);
+            } else if (!hasPendingForPost(mutation.postId)) {
+                if (mutation.type == "like") {
+                    manager->unlikePost(mutation.postId);
+                } else if (mutation.type == "unlike") {
+                    manager->likePost(mutation.postId);
+                }
+            }
+            emit mutationRejected(mutation.postId, mutation.type);
+            continue;
+        }
+
+        // applied 与 conflict 都以服务端状态为准
+        QJsonObject post = result["post"].toObject();
+        if (!post.isEmpty()) {
+            serverStates.insert(mutation.postId, post);
+        }
+    }
+
+    // 服务端未答复的条目留在队列中，下一批重发
+    inFlightIds.clear();
+
+    // 仍有未确认变更的帖子暂不对账，避免回退用户刚做的操作
+    for (auto it = serverStates.constBegin(); it != serverStates.constEnd(); ++it) {
+        if (hasPendingForPost(it.key())) continue;
+        const QJsonObject& post = it.value();
+        manager->reconcilePost(it.key(), post["likesCount"].toInt(),
+                               post["commentsCount"].toInt(), post["isLiked"].toBool());
+    }
+
+    save();
+    emit pendingCountChanged(pending.size());
+
+    if (!pending.isEmpty()) {
+        scheduleFlush(BatchWindowMs);
+    }
+}
+
+void MutationQueue::onRequestFailed(quint64 requestId, const QString& error) {
+    if (requestId != inFlightRequest) return;
+    inFlightRequest = 0;
+    inFlightIds.clear();
+    consecutiveFailures++;
+
+    int delay = retryDelay();
+    qDebug() << "MutationQueue: upload failed:" << error << "- retry" << consecutiveFailures
+             << "in" << delay << "ms";
+    scheduleFlush(delay);
+}
+
+void MutationQueue::load() {
+    QFile file(storagePath);
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    QJsonArray array = QJsonDocument::fromJson(file.readAll()).object()["mutations"].toArray();
+    for (const QJsonValue& value : array) {
+        PendingMutation mutation = PendingMutation::fromJson(value.toObject());
+        if (!mutation.mutationId.isEmpty()) {
+            pending.append(mutation);
+        }
+    }
+
+    if (!pending.isEmpty()) {
+        qDebug() << "MutationQueue: restored" << pending.size() << "pending mutations";
+    }
+}
+
+void MutationQueue::save() const {
+    QJsonArray array;
+    for (const PendingMutation& mutation : pending) {
+        array.append(mutation.toJson());
+    }
+    QJsonObject root;
+    root["mutations"] = array;
+
+    // 先写临时文件再替换，避免中途退出留下半个文件
+    QString tempPath = storagePath + ".tmp";
+    QFile file(tempPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "MutationQueue: failed to write" << tempPath;
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.close();
+
+    QFile::remove(storagePath);
+    QFile::rename(tempPath, storagePath);
+}
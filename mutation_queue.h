@@ -0,0 +1,87 @@
+//
+// MutationQueue - 离线优先的社交变更队列
+// Iteration 4: 点赞/评论先在本地生效，再持久化排队、批量上传，
+//              失败按指数退避重试，并以服务端返回的权威状态对账
+//
+
+#ifndef MUTATION_QUEUE_H
+#define MUTATION_QUEUE_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QPointer>
+#include <QSet>
+#include <QTimer>
+#include <QVector>
+#include "social_types.h"
+
+class SocialDataSource;
+
+// 一条待上传的变更；mutationId 全局唯一，服务端据此去重，保证重试幂等
+struct PendingMutation {
+    QString mutationId;
+    QString type;            // like | unlike | comment
+    QString postId;
+    Comment comment;         // 仅 type == comment 时有效
+    QDateTime createdAt;
+    int attempts;
+
+    PendingMutation() : attempts(0) {}
+
+    QJsonObject toJson() const;
+    static PendingMutation fromJson(const QJsonObject& object);
+};
+
+class MutationQueue : public QObject {
+    Q_OBJECT
+
+private:
+    static MutationQueue* instance;
+
+    QVector<PendingMutation> pending;       // 按提交顺序
+    QSet<QString> inFlightIds;              // 已发出、等待结果的 mutationId
+    quint64 inFlightRequest;                // 同一时刻只有一批在途，保证顺序
+    QPointer<SocialDataSource> source;
+    QTimer* flushTimer;
+    int consecutiveFailures;
+    QString storagePath;
+    quint64 lastLocalId;
+
+    explicit MutationQueue(QObject* parent = nullptr);
+
+    void enqueue(const PendingMutation& mutation);
+    bool cancelOpposite(const QString& postId, const QString& type);
+    bool hasPendingForPost(const QString& postId) const;
+    QString nextMutationId();
+    void scheduleFlush(int delayMs);
+    int retryDelay() const;
+    void load();
+    void save() const;
+
+private slots:
+    void attachSource(SocialDataSource* source);
+    void flush();
+    void onMutationsPosted(quint64 requestId, const QJsonArray& results);
+    void onRequestFailed(quint64 requestId, const QString& error);
+
+public:
+    static MutationQueue* getInstance();
+
+    // 本地立即生效；有数据源时排队上传
+    void likePost(const QString& postId);
+    void unlikePost(const QString& postId);
+    void addComment(const QString& postId, const Comment& comment);
+
+    int pendingCount() const { return pending.size(); }
+    bool isPending(const QString& postId) const { return hasPendingForPost(postId); }
+
+signals:
+    void pendingCountChanged(int count);
+    // 本地修改已撤销（评论删除、点赞恢复）后发出
+    void mutationRejected(const QString& postId, const QString& type);
+};
+
+#endif // MUTATION_QUEUE_H
@@ -0,0 +1,324 @@
+//
+// PipCompositor - 实现
+//
+
+#include "pip_compositor.h"
+#include <QPainter>
+#include <cstring>
+
+// x86-64 和开启 SSE2 的 32 位编译都保证有 SSE2，不需要运行时检测
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PIP_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+PipCompositor::PipCompositor()
+    : quality(Bilinear) {
+}
+
+bool PipCompositor::usesSimd() {
+#ifdef PIP_USE_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PipCompositor::setOutputSize(const QSize& size) {
+    if (size == outputSize) return;
+    outputSize = size;
+
+    // BeReal 式布局：副画面占宽度 1/4，与主画面同比例，放在左上角
+    int margin = qMax(4, size.width() / 40);
+    int width = (size.width() / 4) & ~1;
+    int height = (width * size.height() / qMax(1, size.width())) & ~1;
+    insetRect = QRect(margin, margin, width, height);
+
+    scaledInset = QImage();
+    buildMasks();
+}
+
+void PipCompositor::buildMasks() {
+    QSize size = insetRect.size();
+    if (size.isEmpty()) {
+        insetMask = QImage();
+        borderMask = QImage();
+        return;
+    }
+
+    qreal radius = size.width() / 10.0;
+    qreal border = qMax(2, outputSize.height() / 240);
+
+    // 先在 ARGB 上抗锯齿绘制，再只保留 alpha 通道
+    QImage canvas(size, QImage::Format_ARGB32_Premultiplied);
+    canvas.fill(Qt::transparent);
+    {
+        QPainter painter(&canvas);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(Qt::white);
+        painter.drawRoundedRect(QRectF(0, 0, size.width(), size.height()), radius, radius);
+    }
+    insetMask = canvas.convertToFormat(QImage::Format_Alpha8);
+
+    canvas.fill(Qt::transparent);
+    {
+        QPainter painter(&canvas);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(QPen(Qt::white, border));
+        painter.setBrush(Qt::NoBrush);
+        qreal half = border / 2;
+        painter.drawRoundedRect(QRectF(half, half, size.width() - border, size.height() - border),
+                                radius - half, radius - half);
+    }
+    borderMask = canvas.convertToFormat(QImage::Format_Alpha8);
+}
+
+QRect PipCompositor::fillRect(const QSize& source, const QSize& target) {
+    if (source.isEmpty() || target.isEmpty()) return QRect(QPoint(0, 0), source);
+
+    // 比较 source.w / source.h 与 target.w / target.h，裁掉多出来的一边
+    qint64 lhs = qint64(source.width()) * target.height();
+    qint64 rhs = qint64(target.width()) * source.height();
+    if (lhs > rhs) {
+        int width = int(rhs / target.height());
+        return QRect((source.width() - width) / 2, 0, width, source.height());
+    }
+    int height = int(qint64(target.height()) * source.width() / target.width());
+    return QRect(0, (source.height() - height) / 2, source.width(), height);
+}
+
+void PipCompositor::updateInset(const QImage& inset) {
+    if (inset.isNull() || insetRect.isEmpty()) return;
+
+    QImage source = inset.format() == QImage::Format_RGB32
+                        ? inset : inset.convertToFormat(QImage::Format_RGB32);
+    if (scaledInset.size() != insetRect.size()) {
+        scaledInset = QImage(insetRect.size(), QImage::Format_RGB32);
+    }
+    scale(source, fillRect(source.size(), insetRect.size()), scaledInset, quality);
+}
+
+QImage PipCompositor::compose(const QImage& primary) {
+    QImage output;
+    if (primary.size() == outputSize && primary.format() == QImage::Format_RGB32) {
+        output = primary;       // 下面第一次 scanLine() 时分离出自己的一份
+    } else {
+        QImage source = primary.convertToFormat(QImage::Format_RGB32);
+        output = QImage(outputSize, QImage::Format_RGB32);
+        scale(source, fillRect(source.size(), outputSize), output, quality);
+    }
+
+    if (scaledInset.isNull()) return output;
+
+    int width = insetRect.width();
+    for (int y = 0; y < insetRect.height(); y++) {
+        quint32* dst = reinterpret_cast<quint32*>(output.scanLine(insetRect.top() + y)) + insetRect.left();
+        blendRow(dst, reinterpret_cast<const quint32*>(scaledInset.constScanLine(y)),
+                 insetMask.constScanLine(y), width);
+        blendSolidRow(dst, 0xFFFFFFFFu, borderMask.constScanLine(y), width);
+    }
+    return output;
+}
+
+// ==================== 缩放 ====================
+
+// 16.16 定点的像素中心对齐映射；返回起点和到下一像素的权重（0..256）
+static void bilinearTable(int sourceStart, int sourceLength, int targetLength,
+                          QVector<int>& index, QVector<int>& weight) {
+    index.resize(targetLength);
+    weight.resize(targetLength);
+
+    qint64 step = (qint64(sourceLength) << 16) / targetLength;
+    qint64 position = step / 2 - (1 << 15);
+    for (int i = 0; i < targetLength; i++, position += step) {
+        qint64 clamped = qBound<qint64>(0, position, qint64(sourceLength - 1) << 16);
+        int integer = int(clamped >> 16);
+        int fraction = int((clamped & 0xFFFF) >> 8);
+        if (integer >= sourceLength - 1) {
+            // 最后一个像素：用前一个像素配满权重，避免越界读取
+            integer = sourceLength - 2;
+            fraction = 256;
+        }
+        index[i] = sourceStart + integer;
+        weight[i] = fraction;
+    }
+}
+
+static void scaleNearest(const QImage& source, const QRect& area, QImage& target) {
+    int targetWidth = target.width();
+    int targetHeight = target.height();
+
+    QVector<int> columns(targetWidth);
+    for (int x = 0; x < targetWidth; x++) {
+        columns[x] = area.left() + int((qint64(x) * 2 + 1) * area.width() / (2 * targetWidth));
+    }
+
+    for (int y = 0; y < targetHeight; y++) {
+        int sy = area.top() + int((qint64(y) * 2 + 1) * area.height() / (2 * targetHeight));
+        const quint32* src = reinterpret_cast<const quint32*>(source.constScanLine(sy));
+        quint32* dst = reinterpret_cast<quint32*>(target.scanLine(y));
+        for (int x = 0; x < targetWidth; x++) {
+            dst[x] = src[columns[x]];
+        }
+    }
+}
+
+static inline quint32 lerpPixel(quint32 a, quint32 b, int weight) {
+    // 每次处理两个通道（0x00FF00FF 掩码），权重 0..256
+    quint32 rb = (((a & 0x00FF00FF) * (256 - weight) + (b & 0x00FF00FF) * weight) >> 8) & 0x00FF00FF;
+    quint32 ag = ((((a >> 8) & 0x00FF00FF) * (256 - weight) + ((b >> 8) & 0x00FF00FF) * weight)) & 0xFF00FF00;
+    return rb | ag;
+}
+
+static void bilinearRowScalar(quint32* dst, const quint32* row0, const quint32* row1, int wy,
+                              const int* columns, const int* weights, int count) {
+    for (int x = 0; x < count; x++) {
+        int sx = columns[x];
+        quint32 top = lerpPixel(row0[sx], row0[sx + 1], weights[x]);
+        quint32 bottom = lerpPixel(row1[sx], row1[sx + 1], weights[x]);
+        dst[x] = lerpPixel(top, bottom, wy);
+    }
+}
+
+#ifdef PIP_USE_SSE2
+// 一个像素的两个水平邻居放在同一个寄存器的 8 个 16 位通道里，先做垂直插值再做水平插值
+static void bilinearRowSse2(quint32* dst, const quint32* row0, const quint32* row1, int wy,
+                            const int* columns, const qint16* weightPairs, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i top = _mm_set1_epi16(qint16(256 - wy));
+    const __m128i bottom = _mm_set1_epi16(qint16(wy));
+
+    for (int x = 0; x < count; x++) {
+        int sx = columns[x];
+        __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row0 + sx)), zero);
+        __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row1 + sx)), zero);
+
+        // 255 * 256 仍在无符号 16 位范围内
+        __m128i v = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(a, top), _mm_mullo_epi16(b, bottom)), 8);
+
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weightPairs + x * 8));
+        __m128i h = _mm_mullo_epi16(v, w);
+        h = _mm_srli_epi16(_mm_add_epi16(h, _mm_srli_si128(h, 8)), 8);
+        dst[x] = quint32(_mm_cvtsi128_si32(_mm_packus_epi16(h, zero)));
+    }
+}
+#endif
+
+void PipCompositor::scale(const QImage& source, const QRect& sourceRect, QImage& target, Quality quality) {
+    QRect area = sourceRect.intersected(source.rect());
+    if (area.isEmpty() || target.isNull()) return;
+
+    // 源区域太窄无法取相邻像素时退回最近邻
+    if (quality == Nearest || area.width() < 2 || area.height() < 2) {
+        scaleNearest(source, area, target);
+        return;
+    }
+
+    int targetWidth = target.width();
+    int targetHeight = target.height();
+
+    QVector<int> columns, columnWeights, rows, rowWeights;
+    bilinearTable(area.left(), area.width(), targetWidth, columns, columnWeights);
+    bilinearTable(area.top(), area.height(), targetHeight, rows, rowWeights);
+
+#ifdef PIP_USE_SSE2
+    // 每列预先展开为 [左权重 x4, 右权重 x4]
+    QVector<qint16> weightPairs(targetWidth * 8);
+    for (int x = 0; x < targetWidth; x++) {
+        for (int c = 0; c < 4; c++) {
+            weightPairs[x * 8 + c] = qint16(256 - columnWeights[x]);
+            weightPairs[x * 8 + 4 + c] = qint16(columnWeights[x]);
+        }
+    }
+#endif
+
+    for (int y = 0; y < targetHeight; y++) {
+        const quint32* row0 = reinterpret_cast<const quint32*>(source.constScanLine(rows[y]));
+        const quint32* row1 = reinterpret_cast<const quint32*>(source.constScanLine(rows[y] + 1));
+        quint32* dst = reinterpret_cast<quint32*>(target.scanLine(y));
+#ifdef PIP_USE_SSE2
+        bilinearRowSse2(dst, row0, row1, rowWeights[y], columns.constData(), weightPairs.constData(), targetWidth);
+#else
+        bilinearRowScalar(dst, row0, row1, rowWeights[y], columns.constData(), columnWeights.constData(), targetWidth);
+#endif
+    }
+}
+
+// ==================== 混合 ====================
+
+// (x + 128 + ((x + 128) >> 8)) >> 8 等于 round(x / 255)
+static inline quint32 blendChannel(quint32 d, quint32 s, quint32 a) {
+    quint32 x = s * a + d * (255 - a) + 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static inline quint32 blendPixel(quint32 d, quint32 s, quint32 a) {
+    return (blendChannel(d >> 24, s >> 24, a) << 24) |
+           (blendChannel((d >> 16) & 0xFF, (s >> 16) & 0xFF, a) << 16) |
+           (blendChannel((d >> 8) & 0xFF, (s >> 8) & 0xFF, a) << 8) |
+           blendChannel(d & 0xFF, s & 0xFF, a);
+}
+
+#ifdef PIP_USE_SSE2
+static inline __m128i blendHalf(__m128i d, __m128i s, __m128i a) {
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i round = _mm_set1_epi16(128);
+    __m128i x = _mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, _mm_sub_epi16(full, a)));
+    x = _mm_add_epi16(x, round);
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// 4 个像素一组；整组全透明或全不透明时跳过乘法
+static int blendSse2(quint32* dst, const quint32* src, bool solid, const uchar* alpha, int count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i color = _mm_set1_epi32(int(src[0]));
+
+    int x = 0;
+    for (; x + 4 <= count; x += 4) {
+        quint32 alphas;
+        memcpy(&alphas, alpha + x, 4);
+        if (alphas == 0) continue;
+
+        __m128i s = solid ? color : _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+        if (alphas == 0xFFFFFFFFu) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), s);
+            continue;
+        }
+
+        __m128i a = _mm_cvtsi32_si128(int(alphas));
+        a = _mm_unpacklo_epi8(a, a);
+        a = _mm_unpacklo_epi16(a, a);          // 每个 alpha 扩展到 4 个通道
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + x));
+
+        __m128i lo = blendHalf(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(a, zero));
+        __m128i hi = blendHalf(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(a, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_packus_epi16(lo, hi));
+    }
+    return x;
+}
+#endif
+
+void PipCompositor::blendRow(quint32* dst, const quint32* src, const uchar* alpha, int count) {
+    int x = 0;
+#ifdef PIP_USE_SSE2
+    x = blendSse2(dst, src, false, alpha, count);
+#endif
+    for (; x < count; x++) {
+        quint32 a = alpha[x];
+        if (a == 255) dst[x] = src[x];
+        else if (a) dst[x] = blendPixel(dst[x], src[x], a);
+    }
+}
+
+void PipCompositor::blendSolidRow(quint32* dst, quint32 color, const uchar* alpha, int count) {
+    int x = 0;
+#ifdef PIP_USE_SSE2
+    x = blendSse2(dst, &color, true, alpha, count);
+#endif
+    for (; x < count; x++) {
+        quint32 a = alpha[x];
+        if (a == 255) dst[x] = color;
+        else if (a) dst[x] = blendPixel(dst[x], color, a);
+    }
+}
@@ -0,0 +1,60 @@
+//
+// PipCompositor - 画中画合成
+// Iteration 4: 双摄录制时把副画面缩放后以圆角 + 白边叠加到主画面左上角；
+//              缩放和混合在 x86 上使用 SSE2 内核，其余平台走标量实现，
+//              超出时间预算时自动降级为最近邻缩放
+//
+
+#ifndef PIP_COMPOSITOR_H
+#define PIP_COMPOSITOR_H
+
+#include <QImage>
+#include <QRect>
+#include <QSize>
+#include <QVector>
+
+class PipCompositor {
+public:
+    enum Quality {
+        Bilinear,
+        Nearest         // 超预算时使用
+    };
+
+private:
+    QSize outputSize;
+    QRect insetRect;
+    QImage insetMask;       // Format_Alpha8，圆角内容区域
+    QImage borderMask;      // Format_Alpha8，白边
+    QImage scaledInset;     // 缓存：副画面只有新帧到达时才重新缩放
+    Quality quality;
+
+    void buildMasks();
+
+public:
+    PipCompositor();
+
+    // 设置输出尺寸并计算副画面位置（宽度为输出的 1/4，左上角）
+    void setOutputSize(const QSize& size);
+    QSize getOutputSize() const { return outputSize; }
+    QRect getInsetRect() const { return insetRect; }
+
+    void setQuality(Quality quality) { this->quality = quality; }
+    Quality getQuality() const { return quality; }
+
+    // 更新副画面；inset 为空时保留上一帧
+    void updateInset(const QImage& inset);
+
+    // 返回合成后的 RGB32 帧（主画面尺寸不符时先缩放）
+    QImage compose(const QImage& primary);
+
+    // 保持宽高比铺满 target 时需要取用的 source 区域（居中裁切）
+    static QRect fillRect(const QSize& source, const QSize& target);
+
+    // 内核（公开以便单独测量）；source / target 均为 RGB32
+    static void scale(const QImage& source, const QRect& sourceRect, QImage& target, Quality quality);
+    static void blendRow(quint32* dst, const quint32* src, const uchar* alpha, int count);
+    static void blendSolidRow(quint32* dst, quint32 color, const uchar* alpha, int count);
+    static bool usesSimd();
+};
+
+#endif // PIP_COMPOSITOR_H
@@ -4,10 +4,14 @@
 //
 
 #include "playback_controls.h"
+#include "trickplay_manager.h"
 #include <QDebug>
+#include <QMouseEvent>
 
 PlaybackControls::PlaybackControls(QWidget* parent)
     : QWidget(parent),
+    currentDuration(0),
+    previewSheetLooked(false),
     isPlaying(false),
     isMuted(false),
     lastVolume(70),
@@ -33,6 +37,7 @@ void PlaybackControls::setupUI() {
     setupLeftControls();
     setupCenterControls();
     setupRightControls();
+    setupScrubPreview();
 
     // 添加到主布局
     mainLayout->addWidget(leftControlsWidget);
@@ -101,6 +106,8 @@ void PlaybackControls::setupCenterControls() {
     progressSlider->setMaximum(100);
     progressSlider->setValue(0);
     progressSlider->setCursor(Qt::PointingHandCursor);
+    progressSlider->setMouseTracking(true);
+    progressSlider->installEventFilter(this);
 
     // 总时长
     totalTimeLabel = new QLabel("00:00", centerControlsWidget);
@@ -175,6 +182,29 @@ void PlaybackControls::setupRightControls() {
     rightLayout->addWidget(fullscreenBtn);
 }
 
+void PlaybackControls::setupScrubPreview() {
+    // 使用独立的 ToolTip 窗口，避免被原生视频窗口遮挡
+    scrubPreview = new QFrame(this, Qt::ToolTip | Qt::FramelessWindowHint);
+    scrubPreview->setAttribute(Qt::WA_TransparentForMouseEvents);
+    scrubPreview->setAttribute(Qt::WA_ShowWithoutActivating);
+
+    QVBoxLayout* previewLayout = new QVBoxLayout(scrubPreview);
+    previewLayout->setContentsMargins(2, 2, 2, 2);
+    previewLayout->setSpacing(2);
+
+    scrubPreviewImage = new QLabel(scrubPreview);
+    scrubPreviewImage->setFixedSize(TrickplayManager::TileWidth, TrickplayManager::TileHeight);
+    scrubPreviewImage->setAlignment(Qt::AlignCenter);
+    previewLayout->addWidget(scrubPreviewImage);
+
+    scrubPreviewTime = new QLabel("00:00", scrubPreview);
+    scrubPreviewTime->setFont(DesignSystem::Typography::getCaption());
+    scrubPreviewTime->setAlignment(Qt::AlignCenter);
+    previewLayout->addWidget(scrubPreviewTime);
+
+    scrubPreview->hide();
+}
+
 void PlaybackControls::connectSignals() {
     // 播放控制
     connect(playPauseBtn, &QPushButton::clicked,
@@ -186,9 +216,15 @@ void PlaybackControls::connectSignals() {
     connect(nextBtn, &QPushButton::clicked,
             this, &PlaybackControls::nextClicked);
 
-    // 进度控制
+    // 进度控制：拖动时只显示预览，松开后才真正 seek
     connect(progressSlider, &QSlider::sliderMoved,
             this, &PlaybackControls::onProgressSliderMoved);
+    connect(progressSlider, &QSlider::sliderReleased,
+            this, &PlaybackControls::onProgressSliderReleased);
+
+    // 预览图生成完成
+    connect(TrickplayManager::getInstance(), &TrickplayManager::sheetReady,
+            this, &PlaybackControls::onTrickplaySheetReady);
 
     // 音量控制
     connect(volumeBtn, &QPushButton::clicked,
@@ -321,6 +357,22 @@ void PlaybackControls::applyStyles() {
     )").arg(DesignSystem::Colors::getBorder().name())
                                   .arg(DesignSystem::Colors::getTextPrimary().name())
                                   .arg(DesignSystem::Colors::getPrimary().name()));
+
+    // 拖动预览样式
+    scrubPreview->setStyleSheet(QString(R"(
+        QFrame {
+            background-color: %1;
+            border: 1px solid %2;
+            border-radius: 4px;
+        }
+        QLabel {
+            color: %3;
+            background: transparent;
+            border: none;
+        }
+    )").arg(DesignSystem::Colors::getSurface().name())
+                                    .arg(DesignSystem::Colors::getDivider().name())
+                                    .arg(DesignSystem::Colors::getTextPrimary().name()));
 }
 
 void PlaybackControls::resizeEvent(QResizeEvent* event) {
@@ -336,6 +388,81 @@ void PlaybackControls::resizeEvent(QResizeEvent* event) {
     }
 }
 
+bool PlaybackControls::eventFilter(QObject* watched, QEvent* event) {
+    if (watched == progressSlider) {
+        switch (event->type()) {
+        case QEvent::MouseMove:
+            // 拖动中由 sliderMoved 负责，悬停时按鼠标位置预览
+            if (!progressSlider->isSliderDown() && progressSlider->width() > 0) {
+                QMouseEvent* mouseEvent = static_cast<QMouseEvent*>(event);
+                showScrubPreview(qBound(0.0, mouseEvent->pos().x() /
+                                             static_cast<qreal>(progressSlider->width()), 1.0));
+            }
+            break;
+        case QEvent::Leave:
+            if (!progressSlider->isSliderDown()) {
+                hideScrubPreview();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    return QWidget::eventFilter(watched, event);
+}
+
+void PlaybackControls::showScrubPreview(qreal fraction) {
+    if (currentDuration <= 0) return;
+
+    qint64 position = static_cast<qint64>(fraction * currentDuration);
+    scrubPreviewTime->setText(formatTime(position));
+
+    if (!previewSheetLooked) {
+        previewSheet = TrickplayManager::getInstance()->getSheet(previewSource);
+        previewSheetLooked = true;
+    }
+    if (previewSheet.isValid()) {
+        scrubPreviewImage->setPixmap(QPixmap::fromImage(previewSheet.tileAt(position)));
+        scrubPreviewImage->show();
+    } else {
+        scrubPreviewImage->hide();
+    }
+
+    scrubPreview->adjustSize();
+
+    // 预览框水平跟随指针，位于进度条上方
+    QPoint anchor = progressSlider->mapToGlobal(
+        QPoint(static_cast<int>(fraction * progressSlider->width()), 0));
+    scrubPreview->move(anchor.x() - scrubPreview->width() / 2,
+                       anchor.y() - scrubPreview->height() - DesignSystem::Dimensions::SpacingSmall);
+    scrubPreview->show();
+}
+
+void PlaybackControls::hideScrubPreview() {
+    scrubPreview->hide();
+}
+
+void PlaybackControls::setPreviewSource(const QUrl& url) {
+    previewSource = url;
+    previewSheet = TrickplaySheet();
+    previewSheetLooked = false;
+    hideScrubPreview();
+
+    // 当前视频优先生成
+    TrickplayManager::getInstance()->requestSheet(url, true);
+}
+
+void PlaybackControls::onTrickplaySheetReady(const QUrl& url) {
+    if (url != previewSource) return;
+
+    previewSheet = TrickplaySheet();
+    previewSheetLooked = false;
+    if (scrubPreview->isVisible()) {
+        showScrubPreview(progressSlider->value() / 100.0);
+    }
+}
+
 void PlaybackControls::updateLayoutForDevice(DesignSystem::DeviceType device) {
     switch (device) {
     case DesignSystem::Mobile:
@@ -412,11 +539,17 @@ void PlaybackControls::updateProgress(qint64 position, qint64 duration) {
 }
 
 void PlaybackControls::setTotalDuration(qint64 duration) {
+    currentDuration = duration;
     totalTimeLabel->setText(formatTime(duration));
 }
 
 void PlaybackControls::onProgressSliderMoved(int position) {
-    emit seekRequested(position);
+    showScrubPreview(position / 100.0);
+}
+
+void PlaybackControls::onProgressSliderReleased() {
+    hideScrubPreview();
+    emit seekRequested(progressSlider->value());
 }
 
 void PlaybackControls::onVolumeButtonClicked() {
@@ -474,11 +607,21 @@ void PlaybackControls::updateTheme() {
     update();
 }
 
+void PlaybackControls::setEffectiveSpeed(qreal requested, qreal effective) {
+    if (qFuzzyCompare(requested, effective)) {
+        speedCombo->setToolTip(QString());
+    } else {
+        speedCombo->setToolTip(tr("Limited to %1x to keep playback smooth")
+                                   .arg(effective));
+    }
+}
+
 void PlaybackControls::onSpeedChanged(int index) {
     QStringList speeds = {"0.25", "0.5", "0.75", "1.0", "1.25", "1.5", "1.75", "2.0"};
     qreal speed = speeds[index].toDouble();
 
     qDebug() << "Playback speed changed to:" << speed;
+    speedCombo->setToolTip(QString());
     emit playbackSpeedChanged(speed);
 }
 
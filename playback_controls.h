@@ -16,7 +16,10 @@
 #include <QTime>
 #include <QComboBox>
 #include <QResizeEvent>
+#include <QFrame>
+#include <QUrl>
 #include "design_system.h"
+#include "trickplay_manager.h"
 
 class PlaybackControls : public QWidget {
     Q_OBJECT
@@ -43,6 +46,16 @@ private:
     // 其他控制
     QPushButton* fullscreenBtn;
 
+    // 拖动预览（trickplay）
+    QFrame* scrubPreview;
+    QLabel* scrubPreviewImage;
+    QLabel* scrubPreviewTime;
+    QUrl previewSource;
+    qint64 currentDuration;
+    // 当前视频的雪碧图只查一次（缓存键要 stat + SHA1，缺失时还要读盘），换视频或生成完成时失效
+    TrickplaySheet previewSheet;
+    bool previewSheetLooked;
+
     // 布局管理
     QHBoxLayout* mainLayout;
     QWidget* leftControlsWidget;   // 左侧按钮组
@@ -64,8 +77,13 @@ private:
     void updateLayoutForDevice(DesignSystem::DeviceType device);
     QString formatTime(qint64 milliseconds);
 
+    void setupScrubPreview();
+    void showScrubPreview(qreal fraction);
+    void hideScrubPreview();
+
 protected:
     void resizeEvent(QResizeEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
 
 public:
     explicit PlaybackControls(QWidget* parent = nullptr);
@@ -76,6 +94,12 @@ public:
     void setMuted(bool muted);
     void updateTheme();
 
+    // 设置当前视频，用于查找拖动预览图
+    void setPreviewSource(const QUrl& url);
+
+    // 倍速因丢帧被自动降低时提示用户
+    void setEffectiveSpeed(qreal requested, qreal effective);
+
 public slots:
     void updateProgress(qint64 position, qint64 duration);
     void setTotalDuration(qint64 duration);
@@ -83,6 +107,8 @@ public slots:
     void onVolumeButtonClicked();
     void onVolumeChanged(int value);
     void onProgressSliderMoved(int position);
+    void onProgressSliderReleased();
+    void onTrickplaySheetReady(const QUrl& url);
     void onSpeedChanged(int index);
 
 signals:
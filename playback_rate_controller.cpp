@@ -0,0 +1,174 @@
+//
+// PlaybackRateController - 实现
+//
+
+#include "playback_rate_controller.h"
+#include <QDebug>
+#include <QVideoFrame>
+#include <QVideoProbe>
+
+// 评估窗口长度
+static const int EvaluateIntervalMs = 3000;
+
+// 丢帧率超过该阈值时降一档
+static const double DropThreshold = 0.25;
+
+// 窗口内帧数太少时不做判断
+static const qint64 MinWindowFrames = 30;
+
+// 时间戳跳变超过该值视为 seek，而不是丢帧
+static const qint64 SeekGapUs = 500000;
+
+// 可理解音频的倍速范围，范围外静音
+// Qt5 的 QMediaPlayer 没有暴露变速不变调（time-stretch）接口，
+// 音调是否保持取决于后端（GStreamer 保持，部分 DirectShow 滤镜不保持）
+static const qreal MinAudibleRate = 0.5;
+static const qreal MaxAudibleRate = 2.0;
+
+PlaybackRateController::PlaybackRateController(QMediaPlayer* mediaPlayer, QObject* parent)
+    : QObject(parent),
+    player(mediaPlayer),
+    probeAvailable(false),
+    requestedRate(1.0),
+    effectiveRate(1.0),
+    mutedByPolicy(false),
+    lastFrameTimeUs(-1),
+    nominalFrameUs(0) {
+
+    // 通过探针观察解码输出，不影响现有的视频输出
+    probe = new QVideoProbe(this);
+    probeAvailable = probe->setSource(player);
+    if (probeAvailable) {
+        connect(probe, &QVideoProbe::videoFrameProbed,
+                this, &PlaybackRateController::onFrameProbed);
+    } else {
+        qDebug() << "PlaybackRateController: video probe not supported by backend,"
+                 << "drop-frame adaptation disabled";
+    }
+
+    evaluateTimer = new QTimer(this);
+    evaluateTimer->setInterval(EvaluateIntervalMs);
+    connect(evaluateTimer, &QTimer::timeout,
+            this, &PlaybackRateController::evaluate);
+
+    connect(player, &QMediaPlayer::mediaStatusChanged,
+            this, &PlaybackRateController::onMediaStatusChanged);
+}
+
+QVector<qreal> PlaybackRateController::rateSteps() {
+    return QVector<qreal>() << 0.25 << 0.5 << 0.75 << 1.0 << 1.25 << 1.5 << 1.75 << 2.0;
+}
+
+void PlaybackRateController::setRequestedRate(qreal rate) {
+    if (rate <= 0) return;
+
+    requestedRate = rate;
+    applyRate(rate);
+
+    if (probeAvailable && rate > 1.0) {
+        evaluateTimer->start();
+    } else {
+        evaluateTimer->stop();
+    }
+}
+
+void PlaybackRateController::applyRate(qreal rate) {
+    effectiveRate = rate;
+    resetWindow();
+
+    // 注意：调用的是 QMediaPlayer 的实现，ThePlayer::setPlaybackRate 会转发到这里
+    player->setPlaybackRate(rate);
+    applyAudioPolicy();
+
+    qDebug() << "Playback rate applied:" << rate << "(requested" << requestedRate << ")";
+}
+
+void PlaybackRateController::applyAudioPolicy() {
+    bool shouldMute = effectiveRate < MinAudibleRate || effectiveRate > MaxAudibleRate;
+
+    if (shouldMute && !player->isMuted()) {
+        player->setMuted(true);
+        mutedByPolicy = true;
+    } else if (!shouldMute && mutedByPolicy) {
+        // 只恢复由本策略静音的情况，不覆盖用户的静音选择
+        player->setMuted(false);
+        mutedByPolicy = false;
+    }
+}
+
+void PlaybackRateController::resetWindow() {
+    window = RateStats();
+    lastFrameTimeUs = -1;
+}
+
+qreal PlaybackRateController::nextLowerRate(qreal rate) const {
+    QVector<qreal> steps = rateSteps();
+    qreal lower = 1.0;
+    for (qreal step : steps) {
+        if (step >= 1.0 && step < rate) {
+            lower = step;
+        }
+    }
+    return lower;
+}
+
+void PlaybackRateController::onFrameProbed(const QVideoFrame& frame) {
+    qint64 startUs = frame.startTime();
+    if (startUs < 0) return;
+
+    window.framesPresented++;
+    stats[effectiveRate].framesPresented++;
+
+    if (lastFrameTimeUs >= 0) {
+        qint64 delta = startUs - lastFrameTimeUs;
+
+        if (delta > 0 && delta < SeekGapUs) {
+            if (nominalFrameUs == 0 || delta < nominalFrameUs) {
+                nominalFrameUs = delta;
+            }
+
+            // 时间戳空洞超过 1.5 帧即认为中间的帧被丢弃
+            if (delta * 2 > nominalFrameUs * 3) {
+                qint64 missing = (delta + nominalFrameUs / 2) / nominalFrameUs - 1;
+                window.framesDropped += missing;
+                stats[effectiveRate].framesDropped += missing;
+            }
+        }
+    }
+
+    lastFrameTimeUs = startUs;
+}
+
+void PlaybackRateController::onMediaStatusChanged(QMediaPlayer::MediaStatus status) {
+    if (status == QMediaPlayer::LoadedMedia) {
+        // 部分后端在 setMedia 后会重置倍速；新视频重新尝试用户选择的倍速
+        nominalFrameUs = 0;
+        if (!qFuzzyCompare(requestedRate, 1.0) || !qFuzzyCompare(effectiveRate, 1.0)) {
+            applyRate(requestedRate);
+        }
+    }
+}
+
+void PlaybackRateController::evaluate() {
+    if (player->state() != QMediaPlayer::PlayingState) {
+        resetWindow();
+        return;
+    }
+
+    if (window.framesPresented + window.framesDropped < MinWindowFrames) {
+        return;
+    }
+
+    double ratio = window.dropRatio();
+    qDebug() << "Rate" << effectiveRate << "window drop ratio:" << ratio
+             << "(" << window.framesDropped << "dropped /"
+             << window.framesPresented << "presented)";
+
+    if (ratio > DropThreshold && effectiveRate > 1.0) {
+        qreal lower = nextLowerRate(effectiveRate);
+        applyRate(lower);
+        emit rateAdjusted(requestedRate, lower);
+    } else {
+        resetWindow();
+    }
+}
@@ -0,0 +1,79 @@
+//
+// PlaybackRateController - 倍速播放控制器
+// Iteration 4: 统一倍速行为、按倍速统计丢帧，并在卡顿时自动降速
+//
+
+#ifndef PLAYBACK_RATE_CONTROLLER_H
+#define PLAYBACK_RATE_CONTROLLER_H
+
+#include <QObject>
+#include <QMap>
+#include <QMediaPlayer>
+#include <QTimer>
+#include <QVector>
+
+class QVideoProbe;
+class QVideoFrame;
+
+// 某一倍速下的帧统计
+struct RateStats {
+    qint64 framesPresented;   // 实际送达的帧
+    qint64 framesDropped;     // 根据时间戳空洞推算的丢帧
+
+    RateStats()
+        : framesPresented(0), framesDropped(0) {}
+
+    double dropRatio() const {
+        qint64 total = framesPresented + framesDropped;
+        return total > 0 ? static_cast<double>(framesDropped) / total : 0.0;
+    }
+};
+
+class PlaybackRateController : public QObject {
+    Q_OBJECT
+
+private:
+    QMediaPlayer* player;
+    QVideoProbe* probe;
+    QTimer* evaluateTimer;
+    bool probeAvailable;
+
+    qreal requestedRate;   // 用户选择的倍速
+    qreal effectiveRate;   // 实际生效的倍速（可能因丢帧而降低）
+    bool mutedByPolicy;
+
+    // 丢帧检测
+    qint64 lastFrameTimeUs;
+    qint64 nominalFrameUs;    // 观察到的最小帧间隔，即视频帧时长
+    RateStats window;         // 当前评估窗口
+    QMap<qreal, RateStats> stats;
+
+    void applyRate(qreal rate);
+    void applyAudioPolicy();
+    void resetWindow();
+    qreal nextLowerRate(qreal rate) const;
+
+public:
+    explicit PlaybackRateController(QMediaPlayer* player, QObject* parent = nullptr);
+
+    // 与 PlaybackControls::speedCombo 一致的倍速档位
+    static QVector<qreal> rateSteps();
+
+    void setRequestedRate(qreal rate);
+    qreal getRequestedRate() const { return requestedRate; }
+    qreal getEffectiveRate() const { return effectiveRate; }
+
+    bool isMeasuring() const { return probeAvailable; }
+    QMap<qreal, RateStats> getStats() const { return stats; }
+
+private slots:
+    void onFrameProbed(const QVideoFrame& frame);
+    void onMediaStatusChanged(QMediaPlayer::MediaStatus status);
+    void evaluate();
+
+signals:
+    // 因丢帧过多自动降速
+    void rateAdjusted(qreal requested, qreal effective);
+};
+
+#endif // PLAYBACK_RATE_CONTROLLER_H
@@ -0,0 +1,455 @@
+//
+// ProxyTranscoder - 实现
+//
+
+#include "proxy_transcoder.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QThread>
+#include <QTimer>
+
+ProxyTranscoder* ProxyTranscoder::instance = nullptr;
+
+// 探测一个文件最多等待的时间
+static const int ProbeTimeoutMs = 15000;
+
+// ==================== SourceProfile ====================
+
+QJsonObject SourceProfile::toJson() const {
+    QJsonObject object;
+    object["codec"] = codec;
+    object["width"] = width;
+    object["height"] = height;
+    object["frameRate"] = frameRate;
+    object["bitRate"] = QString::number(bitRate);
+    object["durationMs"] = QString::number(durationMs);
+    return object;
+}
+
+SourceProfile SourceProfile::fromJson(const QJsonObject& object) {
+    SourceProfile profile;
+    profile.codec = object["codec"].toString();
+    profile.width = object["width"].toInt();
+    profile.height = object["height"].toInt();
+    profile.frameRate = object["frameRate"].toDouble();
+    profile.bitRate = object["bitRate"].toString().toLongLong();
+    profile.durationMs = object["durationMs"].toString().toLongLong();
+    return profile;
+}
+
+// ==================== ProxyConfig ====================
+
+ProxyConfig::ProxyConfig()
+    : enabled(true),
+    maxPixelRate(1920.0 * 1080.0 * 30.0),
+    maxBitRate(20LL * 1000 * 1000),
+    proxyHeight(720),
+    maxConcurrentJobs(1),
+    threadsPerJob(qMax(1, QThread::idealThreadCount() / 4)) {}
+
+ProxyConfig ProxyConfig::load() {
+    ProxyConfig config;
+    QSettings settings("Tomeo", "ProxySettings");
+    config.enabled = settings.value("enabled", config.enabled).toBool();
+    config.maxPixelRate = settings.value("maxPixelRate", config.maxPixelRate).toDouble();
+    config.maxBitRate = settings.value("maxBitRate", config.maxBitRate).toLongLong();
+    config.proxyHeight = settings.value("proxyHeight", config.proxyHeight).toInt();
+    config.maxConcurrentJobs = qMax(1, settings.value("maxConcurrentJobs", config.maxConcurrentJobs).toInt());
+    config.threadsPerJob = qMax(1, settings.value("threadsPerJob", config.threadsPerJob).toInt());
+    return config;
+}
+
+void ProxyConfig::save() const {
+    QSettings settings("Tomeo", "ProxySettings");
+    settings.setValue("enabled", enabled);
+    settings.setValue("maxPixelRate", maxPixelRate);
+    settings.setValue("maxBitRate", maxBitRate);
+    settings.setValue("proxyHeight", proxyHeight);
+    settings.setValue("maxConcurrentJobs", maxConcurrentJobs);
+    settings.setValue("threadsPerJob", threadsPerJob);
+}
+
+// ==================== ProxyTranscoder ====================
+
+ProxyTranscoder::ProxyTranscoder(QObject* parent)
+    : QObject(parent),
+    config(ProxyConfig::load()) {
+
+    ffmpegPath = QStandardPaths::findExecutable("ffmpeg");
+    ffprobePath = QStandardPaths::findExecutable("ffprobe");
+    // 转码进程降低优先级，播放和界面优先
+    nicePath = QStandardPaths::findExecutable("nice");
+
+    proxyDir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/proxies";
+    QDir().mkpath(proxyDir);
+    mappingPath = proxyDir + "/proxies.json";
+    loadMapping();
+
+    // 退出时终止转码，未完成的临时文件下次重新生成
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+            queue.clear();
+            for (Job* job : running) {
+                // 被中断不算失败，断开信号以免记为转码失败
+                job->process->disconnect(this);
+                job->process->kill();
+                job->process->waitForFinished(1000);
+                if (!job->outputPath.isEmpty()) {
+                    QFile::remove(job->outputPath + ".part");
+                }
+            }
+        });
+    }
+
+    if (isAvailable()) {
+        qDebug() << "ProxyTranscoder: using" << ffmpegPath << "," << config.maxConcurrentJobs
+                 << "job(s) x" << config.threadsPerJob << "thread(s)";
+    } else {
+        qDebug() << "ProxyTranscoder: ffmpeg/ffprobe not found, playing originals only";
+    }
+}
+
+ProxyTranscoder* ProxyTranscoder::getInstance() {
+    if (instance == nullptr) {
+        instance = new ProxyTranscoder();
+    }
+    return instance;
+}
+
+QString ProxyTranscoder::sourceKey(const QString& path) {
+    QFileInfo info(path);
+    return QString("%1|%2").arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch());
+}
+
+QString ProxyTranscoder::proxyPathFor(const QString& sourcePath) const {
+    QString hash = QString::fromLatin1(
+        QCryptographicHash::hash(sourcePath.toUtf8(), QCryptographicHash::Sha1).toHex());
+    return proxyDir + "/" + hash + ".mp4";
+}
+
+// 这些编码在多数平台上没有硬件解码，软件解码开销大
+bool ProxyTranscoder::isLegacyCodec(const QString& codec) const {
+    static const QStringList legacy = {
+        "wmv1", "wmv2", "wmv3", "vc1", "msmpeg4v2", "msmpeg4v3", "mjpeg", "prores"
+    };
+    return legacy.contains(codec);
+}
+
+bool ProxyTranscoder::exceedsBudget(const SourceProfile& profile) const {
+    if (!profile.isValid()) return false;
+    return isLegacyCodec(profile.codec) ||
+           profile.pixelRate() > config.maxPixelRate ||
+           profile.bitRate > config.maxBitRate;
+}
+
+bool ProxyTranscoder::isQueuedOrRunning(const QString& sourcePath) const {
+    if (queue.contains(sourcePath)) return true;
+    for (Job* job : running) {
+        if (job->sourcePath == sourcePath) return true;
+    }
+    return false;
+}
+
+void ProxyTranscoder::request(const QUrl& source) {
+    if (!config.enabled || !isAvailable() || !source.isLocalFile()) return;
+
+    QString path = QFileInfo(source.toLocalFile()).absoluteFilePath();
+    QString key = sourceKey(path);
+
+    auto it = entries.find(path);
+    if (it != entries.end()) {
+        if (it->sourceKey == key) {
+            bool proxyReadyOnDisk = !it->proxyPath.isEmpty() && QFile::exists(it->proxyPath);
+            if (!it->heavy || proxyReadyOnDisk || it->failed) return;
+        } else {
+            // 源文件已被替换，旧代理作废
+            if (!it->proxyPath.isEmpty()) {
+                QFile::remove(it->proxyPath);
+            }
+            entries.erase(it);
+            saveMapping();
+        }
+    }
+
+    if (isQueuedOrRunning(path)) return;
+
+    queue.append(path);
+    startNext();
+}
+
+QUrl ProxyTranscoder::playbackUrl(const QUrl& source) const {
+    if (!config.enabled || !source.isLocalFile()) return source;
+
+    QString path = QFileInfo(source.toLocalFile()).absoluteFilePath();
+    auto it = entries.constFind(path);
+    if (it == entries.constEnd() || !it->heavy || it->proxyPath.isEmpty()) return source;
+    if (it->sourceKey != sourceKey(path) || !QFile::exists(it->proxyPath)) return source;
+
+    qDebug() << "ProxyTranscoder: playing proxy for" << source.fileName();
+    return QUrl::fromLocalFile(it->proxyPath);
+}
+
+bool ProxyTranscoder::hasProxy(const QUrl& source) const {
+    return playbackUrl(source) != source;
+}
+
+void ProxyTranscoder::setConfig(const ProxyConfig& newConfig) {
+    config = newConfig;
+    config.save();
+
+    // 预算变化后重新判定（探测结果仍然有效，不必重新探测）
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        it->heavy = exceedsBudget(it->profile);
+    }
+    saveMapping();
+}
+
+void ProxyTranscoder::startNext() {
+    // 工具启动失败后停用，排队的文件不再处理
+    if (!isAvailable()) {
+        queue.clear();
+        return;
+    }
+
+    while (running.size() < config.maxConcurrentJobs && !queue.isEmpty()) {
+        Job* job = new Job;
+        job->sourcePath = queue.takeFirst();
+        job->process = new QProcess(this);
+        job->process->setProcessChannelMode(QProcess::SeparateChannels);
+        connect(job->process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
+                this, &ProxyTranscoder::onProcessFinished);
+        // 启动失败时不会有 finished；排队处理，避免在 start() 内部同步结束任务
+        connect(job->process, &QProcess::errorOccurred,
+                this, &ProxyTranscoder::onProcessError, Qt::QueuedConnection);
+        running.append(job);
+
+        // 已探测过的文件直接转码
+        const ProxyEntry entry = entries.value(job->sourcePath);
+        if (entry.sourceKey == sourceKey(job->sourcePath) && entry.profile.isValid()) {
+            startTranscode(job);
+        } else {
+            startProbe(job);
+        }
+    }
+}
+
+void ProxyTranscoder::startProbe(Job* job) {
+    job->stage = Probing;
+
+    QStringList arguments;
+    arguments << "-v" << "error"
+              << "-select_streams" << "v:0"
+              << "-show_entries" << "stream=codec_name,width,height,avg_frame_rate,bit_rate:format=duration,bit_rate"
+              << "-of" << "json"
+              << job->sourcePath;
+    job->process->start(ffprobePath, arguments);
+
+    // 损坏的文件可能让 ffprobe 卡住
+    QProcess* process = job->process;
+    QTimer::singleShot(ProbeTimeoutMs, process, [process]() {
+        if (process->state() != QProcess::NotRunning) {
+            process->kill();
+        }
+    });
+}
+
+void ProxyTranscoder::startTranscode(Job* job) {
+    job->stage = Transcoding;
+    job->outputPath = proxyPathFor(job->sourcePath);
+
+    // 缩到不高于 proxyHeight，H.264 + faststart，先写 .part 再改名
+    QStringList arguments;
+    arguments << "-nostdin" << "-y" << "-loglevel" << "error"
+              << "-i" << job->sourcePath
+              << "-vf" << QString("scale=-2:'min(%1,ih)'").arg(config.proxyHeight)
+              << "-c:v" << "libx264" << "-preset" << "veryfast" << "-crf" << "25"
+              << "-pix_fmt" << "yuv420p"
+              << "-c:a" << "aac" << "-b:a" << "128k"
+              << "-movflags" << "+faststart"
+              << "-threads" << QString::number(config.threadsPerJob)
+              << "-f" << "mp4"
+              << job->outputPath + ".part";
+
+    qDebug() << "ProxyTranscoder: transcoding" << QFileInfo(job->sourcePath).fileName();
+
+    if (!nicePath.isEmpty()) {
+        job->process->start(nicePath, QStringList() << "-n" << "10" << ffmpegPath << arguments);
+    } else {
+        job->process->start(ffmpegPath, arguments);
+    }
+}
+
+SourceProfile ProxyTranscoder::parseProbe(const QByteArray& output) const {
+    QJsonObject root = QJsonDocument::fromJson(output).object();
+    QJsonObject stream = root["streams"].toArray().first().toObject();
+    QJsonObject format = root["format"].toObject();
+
+    SourceProfile profile;
+    profile.codec = stream["codec_name"].toString();
+    profile.width = stream["width"].toInt();
+    profile.height = stream["height"].toInt();
+
+    // avg_frame_rate 形如 "30000/1001"
+    QStringList rate = stream["avg_frame_rate"].toString().split('/');
+    if (rate.size() == 2 && rate.at(1).toDouble() > 0) {
+        profile.frameRate = rate.at(0).toDouble() / rate.at(1).toDouble();
+    }
+
+    // 部分容器没有流码率，退回整体码率
+    profile.bitRate = stream["bit_rate"].toString().toLongLong();
+    if (profile.bitRate <= 0) {
+        profile.bitRate = format["bit_rate"].toString().toLongLong();
+    }
+    profile.durationMs = static_cast<qint64>(format["duration"].toString().toDouble() * 1000.0);
+    return profile;
+}
+
+ProxyTranscoder::Job* ProxyTranscoder::jobFor(QProcess* process) const {
+    for (Job* candidate : running) {
+        if (candidate->process == process) {
+            return candidate;
+        }
+    }
+    return nullptr;
+}
+
+void ProxyTranscoder::onProcessFinished(int exitCode, QProcess::ExitStatus status) {
+    QProcess* process = qobject_cast<QProcess*>(sender());
+    Job* job = jobFor(process);
+    if (!job) return;
+
+    bool ok = status == QProcess::NormalExit && exitCode == 0;
+    ProxyEntry& entry = entries[job->sourcePath];
+    QUrl sourceUrl = QUrl::fromLocalFile(job->sourcePath);
+
+    if (job->stage == Probing) {
+        entry.sourceKey = sourceKey(job->sourcePath);
+        entry.profile = ok ? parseProbe(process->readAllStandardOutput()) : SourceProfile();
+        entry.heavy = exceedsBudget(entry.profile);
+        saveMapping();
+
+        qDebug() << "ProxyTranscoder: probed" << sourceUrl.fileName() << entry.profile.codec
+                 << entry.profile.width << "x" << entry.profile.height << "@" << entry.profile.frameRate
+                 << entry.profile.bitRate / 1000 << "kbit/s" << (entry.heavy ? "-> proxy" : "");
+
+        if (entry.heavy && !entry.failed) {
+            startTranscode(job);
+            return;
+        }
+    } else {
+        QString partPath = job->outputPath + ".part";
+        if (ok && QFile::exists(partPath)) {
+            QFile::remove(job->outputPath);
+            QFile::rename(partPath, job->outputPath);
+            entry.proxyPath = job->outputPath;
+            entry.failed = false;
+            saveMapping();
+
+            qDebug() << "ProxyTranscoder: proxy ready for" << sourceUrl.fileName();
+            emit proxyReady(sourceUrl, QUrl::fromLocalFile(job->outputPath));
+        } else {
+            QFile::remove(partPath);
+            entry.failed = true;
+            saveMapping();
+
+            QString error = QString::fromLocal8Bit(process->readAllStandardError()).trimmed();
+            qDebug() << "ProxyTranscoder: transcode failed for" << sourceUrl.fileName() << error;
+            emit proxyFailed(sourceUrl, error);
+        }
+    }
+
+    finishJob(job);
+}
+
+// 其他错误（崩溃、被超时结束）之后仍会收到 finished，只有启动失败需要在这里收尾
+void ProxyTranscoder::onProcessError(QProcess::ProcessError error) {
+    if (error != QProcess::FailedToStart) return;
+
+    QProcess* process = qobject_cast<QProcess*>(sender());
+    Job* job = jobFor(process);
+    if (!job) return;
+
+    QString program = process->program();
+    QString message = process->errorString();
+    QUrl sourceUrl = QUrl::fromLocalFile(job->sourcePath);
+    qDebug() << "ProxyTranscoder:" << program << "failed to start for" << sourceUrl.fileName() << message;
+
+    // nice 不可用时不降优先级，直接重新转码
+    if (job->stage == Transcoding && !nicePath.isEmpty() && program == nicePath) {
+        nicePath.clear();
+        startTranscode(job);
+        return;
+    }
+
+    // 问题出在工具而不是文件：不把文件记为失败（装好工具后仍会转码），本次会话停用转码
+    if (program == ffprobePath) {
+        ffprobePath.clear();
+    } else {
+        ffmpegPath.clear();
+    }
+    if (job->stage == Transcoding) {
+        emit proxyFailed(sourceUrl, message);
+    }
+
+    finishJob(job);
+}
+
+void ProxyTranscoder::finishJob(Job* job) {
+    running.removeAll(job);
+    job->process->deleteLater();
+    delete job;
+    startNext();
+}
+
+void ProxyTranscoder::loadMapping() {
+    QFile file(mappingPath);
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    QJsonObject items = root["entries"].toObject();
+    for (auto it = items.constBegin(); it != items.constEnd(); ++it) {
+        QJsonObject object = it.value().toObject();
+        ProxyEntry entry;
+        entry.sourceKey = object["sourceKey"].toString();
+        entry.profile = SourceProfile::fromJson(object["profile"].toObject());
+        entry.heavy = object["heavy"].toBool();
+        entry.proxyPath = object["proxyPath"].toString();
+        entry.failed = object["failed"].toBool();
+        entries.insert(it.key(), entry);
+    }
+
+    qDebug() << "ProxyTranscoder: loaded" << entries.size() << "proxy mappings";
+}
+
+void ProxyTranscoder::saveMapping() const {
+    QJsonObject items;
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        QJsonObject object;
+        object["sourceKey"] = it->sourceKey;
+        object["profile"] = it->profile.toJson();
+        object["heavy"] = it->heavy;
+        object["proxyPath"] = it->proxyPath;
+        object["failed"] = it->failed;
+        items[it.key()] = object;
+    }
+
+    QJsonObject root;
+    root["version"] = 1;
+    root["entries"] = items;
+
+    QFile file(mappingPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "ProxyTranscoder: failed to write" << mappingPath;
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+}
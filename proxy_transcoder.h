@@ -0,0 +1,133 @@
+//
+// ProxyTranscoder - 后台代理转码
+// Iteration 4: 探测视频的解码开销，超出预算的文件在后台队列中转码为轻量代理，
+//              原文件到代理的映射持久化，播放时自动选择代理
+//
+
+#ifndef PROXY_TRANSCODER_H
+#define PROXY_TRANSCODER_H
+
+#include <QObject>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QProcess>
+#include <QUrl>
+
+// 源文件的视频参数（由 ffprobe 得到）
+struct SourceProfile {
+    QString codec;
+    int width;
+    int height;
+    double frameRate;
+    qint64 bitRate;      // bit/s
+    qint64 durationMs;
+
+    SourceProfile()
+        : width(0), height(0), frameRate(0.0), bitRate(0), durationMs(0) {}
+
+    bool isValid() const { return width > 0 && height > 0; }
+    double pixelRate() const { return double(width) * height * frameRate; }
+
+    QJsonObject toJson() const;
+    static SourceProfile fromJson(const QJsonObject& object);
+};
+
+// 解码预算与转码限制，保存在 QSettings("Tomeo", "ProxySettings")
+struct ProxyConfig {
+    bool enabled;
+    double maxPixelRate;     // 超过则转码，默认 1080p30
+    qint64 maxBitRate;       // bit/s，默认 20 Mbit/s
+    int proxyHeight;         // 代理最大高度
+    int maxConcurrentJobs;   // 同时运行的转码进程数
+    int threadsPerJob;       // 每个进程的编码线程数
+
+    ProxyConfig();
+
+    static ProxyConfig load();
+    void save() const;
+};
+
+class ProxyTranscoder : public QObject {
+    Q_OBJECT
+
+private:
+    // 一个源文件的记录：探测结果与代理文件
+    struct ProxyEntry {
+        QString sourceKey;      // 大小 + 修改时间，文件被替换后失效
+        SourceProfile profile;
+        bool heavy;
+        QString proxyPath;      // 为空表示还没有代理
+        bool failed;            // 转码失败，不再重试
+
+        ProxyEntry() : heavy(false), failed(false) {}
+    };
+
+    enum JobStage {
+        Probing,
+        Transcoding
+    };
+
+    struct Job {
+        QString sourcePath;
+        JobStage stage;
+        QProcess* process;
+        QString outputPath;
+    };
+
+    static ProxyTranscoder* instance;
+
+    ProxyConfig config;
+    QString ffmpegPath;
+    QString ffprobePath;
+    QString nicePath;
+    QString proxyDir;
+    QString mappingPath;
+
+    QHash<QString, ProxyEntry> entries;   // 源文件绝对路径 -> 记录
+    QList<QString> queue;                 // 等待处理的源文件
+    QList<Job*> running;
+
+    explicit ProxyTranscoder(QObject* parent = nullptr);
+
+    static QString sourceKey(const QString& path);
+    QString proxyPathFor(const QString& sourcePath) const;
+    bool isLegacyCodec(const QString& codec) const;
+    bool exceedsBudget(const SourceProfile& profile) const;
+    bool isQueuedOrRunning(const QString& sourcePath) const;
+
+    void startNext();
+    void startProbe(Job* job);
+    void startTranscode(Job* job);
+    void finishJob(Job* job);
+    Job* jobFor(QProcess* process) const;
+    SourceProfile parseProbe(const QByteArray& output) const;
+
+    void loadMapping();
+    void saveMapping() const;
+
+private slots:
+    void onProcessFinished(int exitCode, QProcess::ExitStatus status);
+    void onProcessError(QProcess::ProcessError error);
+
+public:
+    static ProxyTranscoder* getInstance();
+
+    bool isAvailable() const { return !ffmpegPath.isEmpty() && !ffprobePath.isEmpty(); }
+
+    // 排队探测；超出预算时在后台生成代理
+    void request(const QUrl& source);
+
+    // 有可用代理且原文件超出解码预算时返回代理，否则返回原文件
+    QUrl playbackUrl(const QUrl& source) const;
+    bool hasProxy(const QUrl& source) const;
+
+    void setConfig(const ProxyConfig& config);
+    ProxyConfig getConfig() const { return config; }
+
+signals:
+    void proxyReady(const QUrl& source, const QUrl& proxy);
+    void proxyFailed(const QUrl& source, const QString& error);
+};
+
+#endif // PROXY_TRANSCODER_H
@@ -0,0 +1,89 @@
+//
+// RankingEngine - 实现
+//
+
+#include "ranking_engine.h"
+#include <QtMath>
+#include <cmath>
+
+static const double MSecsPerHour = 3600.0 * 1000.0;
+
+double EngagementDecayPolicy::engagement(const VideoPost& post) const {
+    return likeWeight * post.likesCount +
+           commentWeight * post.commentsCount +
+           viewWeight * post.viewsCount;
+}
+
+RankingEngine::RankingEngine()
+    : policy(new EngagementDecayPolicy()) {
+}
+
+// 热度 (1 + engagement) * 2^(-age / halfLife) 在对数空间下的排序键
+double RankingEngine::rankKey(const VideoPost& post) const {
+    double hours = post.timestamp.isValid()
+                       ? post.timestamp.toMSecsSinceEpoch() / MSecsPerHour
+                       : 0.0;
+    double engagement = qMax(0.0, policy->engagement(post));
+    return std::log2(1.0 + engagement) + hours / policy->halfLifeHours();
+}
+
+void RankingEngine::setPolicy(RankingPolicy* newPolicy, const QVector<VideoPost>& posts) {
+    if (!newPolicy) return;
+    policy.reset(newPolicy);
+    rebuild(posts);
+}
+
+void RankingEngine::rebuild(const QVector<VideoPost>& posts) {
+    clear();
+    for (const VideoPost& post : posts) {
+        update(post);
+    }
+}
+
+void RankingEngine::update(const VideoPost& post) {
+    double key = rankKey(post);
+
+    auto it = keyById.find(post.postId);
+    if (it != keyById.end()) {
+        if (it.value() == key) return;
+        ranked.erase(Entry{it.value(), post.postId});
+        it.value() = key;
+    } else {
+        keyById.insert(post.postId, key);
+    }
+
+    ranked.insert(Entry{key, post.postId});
+}
+
+void RankingEngine::remove(const QString& postId) {
+    auto it = keyById.find(postId);
+    if (it == keyById.end()) return;
+
+    ranked.erase(Entry{it.value(), postId});
+    keyById.erase(it);
+}
+
+void RankingEngine::clear() {
+    ranked.clear();
+    keyById.clear();
+}
+
+QVector<QString> RankingEngine::topK(int k) const {
+    int count = k < 0 ? size() : qMin(k, size());
+
+    QVector<QString> ids;
+    ids.reserve(count);
+    for (auto it = ranked.begin(); it != ranked.end() && ids.size() < count; ++it) {
+        ids.append(it->postId);
+    }
+    return ids;
+}
+
+double RankingEngine::scoreAt(const QString& postId, qint64 atMSecs) const {
+    auto it = keyById.constFind(postId);
+    if (it == keyById.constEnd()) return 0.0;
+
+    // 把排序键还原为 (1 + engagement) * 2^(-age / halfLife)
+    double nowHours = atMSecs / MSecsPerHour;
+    return std::exp2(it.value() - nowHours / policy->halfLifeHours());
+}
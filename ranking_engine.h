@@ -0,0 +1,89 @@
+//
+// RankingEngine - 热门帖子排序引擎
+// Iteration 4: 按点赞/评论/观看和发布时间计算衰减热度，增量维护有序结构，支持 Top-K 查询
+//
+
+#ifndef RANKING_ENGINE_H
+#define RANKING_ENGINE_H
+
+#include <QHash>
+#include <QScopedPointer>
+#include <QString>
+#include <QVector>
+#include <set>
+#include "social_types.h"
+
+// 排序策略：热度 = (1 + engagement) * 2^(-age / halfLife)，+1 让零互动的帖子也按新旧排序
+// 引擎按其对数 log2(1 + engagement) + t / halfLife 排序，该值与当前时间无关，
+// 因此时间流逝不会改变相对顺序，也就不需要定期重排
+class RankingPolicy {
+public:
+    virtual ~RankingPolicy() {}
+
+    virtual QString name() const = 0;
+    virtual double engagement(const VideoPost& post) const = 0;
+    virtual double halfLifeHours() const = 0;
+};
+
+// 默认策略：评论权重高于点赞，观看只计少量
+class EngagementDecayPolicy : public RankingPolicy {
+private:
+    double likeWeight;
+    double commentWeight;
+    double viewWeight;
+    double halfLife;
+
+public:
+    explicit EngagementDecayPolicy(double likes = 1.0, double comments = 3.0,
+                                   double views = 0.1, double halfLifeHours = 24.0)
+        : likeWeight(likes), commentWeight(comments),
+        viewWeight(views), halfLife(halfLifeHours) {}
+
+    QString name() const override { return "engagement-decay"; }
+    double engagement(const VideoPost& post) const override;
+    double halfLifeHours() const override { return halfLife; }
+};
+
+class RankingEngine {
+private:
+    struct Entry {
+        double key;
+        QString postId;
+
+        // 降序：热度高的在前，同分按 postId 保证稳定
+        bool operator<(const Entry& other) const {
+            if (key != other.key) return key > other.key;
+            return postId < other.postId;
+        }
+    };
+
+    QScopedPointer<RankingPolicy> policy;
+    std::set<Entry> ranked;
+    QHash<QString, double> keyById;
+
+    double rankKey(const VideoPost& post) const;
+
+public:
+    RankingEngine();
+
+    // 更换策略需要用全部帖子重建（引擎接管 policy 的所有权）
+    void setPolicy(RankingPolicy* newPolicy, const QVector<VideoPost>& posts);
+    const RankingPolicy* getPolicy() const { return policy.data(); }
+
+    void rebuild(const QVector<VideoPost>& posts);
+
+    // 插入或更新单个帖子，O(log N)
+    void update(const VideoPost& post);
+    void remove(const QString& postId);
+    void clear();
+
+    // 热度最高的前 k 个帖子 ID（k < 0 表示全部）
+    QVector<QString> topK(int k) const;
+
+    // 帖子在 atMSecs 时刻的热度 (1 + engagement) * 2^(-age / halfLife)，即实际排序所用的值，恒为正
+    double scoreAt(const QString& postId, qint64 atMSecs) const;
+
+    int size() const { return static_cast<int>(ranked.size()); }
+};
+
+#endif // RANKING_ENGINE_H
@@ -1,24 +1,28 @@
 #include "record_dialog.h"
 #include "design_system.h"
+#include "dual_camera_source.h"
 #include <QDebug>
 #include <QMessageBox>
-#include <QDateTime>
-#include <QStandardPaths>
-#include <QDir>
+#include <QFile>
 
 RecordDialog::RecordDialog(QWidget* parent)
     : QDialog(parent),
     isRecording(false),
+    isEncoding(false),
     isFrontCamera(true),
+    isDualCamera(false),
     recordingSeconds(0),
-    maxRecordingSeconds(60),
-    camera(nullptr),
-    mediaRecorder(nullptr) {
+    maxRecordingSeconds(60) {
 
     setWindowTitle(tr("Record Video"));
     setModal(true);
     resize(600, 800);
 
+    pipeline = new RecordingPipeline(this);
+    colorFilter = ColorFilter::load();
+    pipeline->setFilter(colorFilter);
+    pipeline->setSource(createSource());
+
     setupUI();
     connectSignals();
     applyStyles();
@@ -28,13 +32,7 @@ RecordDialog::RecordDialog(QWidget* parent)
 }
 
 RecordDialog::~RecordDialog() {
-    if (camera) {
-        camera->stop();
-        delete camera;
-    }
-    if (mediaRecorder) {
-        delete mediaRecorder;
-    }
+    // pipeline 是子对象，析构时会丢弃未完成的录制并停止采集
 }
 
 void RecordDialog::setupUI() {
@@ -62,6 +60,14 @@ void RecordDialog::setupUI() {
     flashBtn->setCursor(Qt::PointingHandCursor);
     topLayout->addWidget(flashBtn);
 
+    dualCameraBtn = new QPushButton("⧉", topBar);
+    dualCameraBtn->setFixedSize(40, 40);
+    dualCameraBtn->setFont(QFont("Segoe UI Symbol", 18));
+    dualCameraBtn->setCursor(Qt::PointingHandCursor);
+    dualCameraBtn->setCheckable(true);
+    dualCameraBtn->setToolTip(tr("Record front and back cameras together"));
+    topLayout->addWidget(dualCameraBtn);
+
     switchCameraBtn = new QPushButton("🔄", topBar);
     switchCameraBtn->setFixedSize(40, 40);
     switchCameraBtn->setFont(QFont("Segoe UI Emoji", 18));
@@ -71,7 +77,7 @@ void RecordDialog::setupUI() {
     mainLayout->addWidget(topBar);
 
     // === 取景器区域 ===
-    viewfinderLabel = new QLabel(this);
+    viewfinderLabel = new ViewfinderWidget(this);
     viewfinderLabel->setAlignment(Qt::AlignCenter);
     viewfinderLabel->setStyleSheet(R"(
         QLabel {
@@ -86,6 +92,38 @@ void RecordDialog::setupUI() {
     // 这样计时器和底部栏就会自然排列在它下面
     mainLayout->addWidget(viewfinderLabel, 1);
 
+    // === 滤镜栏 ===
+    QWidget* filterBar = new QWidget(this);
+    filterBar->setFixedHeight(44);
+    QHBoxLayout* filterLayout = new QHBoxLayout(filterBar);
+    filterLayout->setContentsMargins(16, 4, 16, 4);
+    filterLayout->setSpacing(8);
+
+    filterBtn = new QPushButton(filterBar);
+    filterBtn->setFixedSize(110, 32);
+    filterBtn->setCursor(Qt::PointingHandCursor);
+    filterBtn->setToolTip(tr("Color filter"));
+    filterLayout->addWidget(filterBtn);
+
+    QLabel* exposureIcon = new QLabel("☀", filterBar);
+    exposureIcon->setToolTip(tr("Exposure"));
+    filterLayout->addWidget(exposureIcon);
+    exposureSlider = new QSlider(Qt::Horizontal, filterBar);
+    exposureSlider->setRange(-20, 20);
+    exposureSlider->setValue(qRound(colorFilter.getExposure() * 10));
+    filterLayout->addWidget(exposureSlider, 1);
+
+    QLabel* contrastIcon = new QLabel("◐", filterBar);
+    contrastIcon->setToolTip(tr("Contrast"));
+    filterLayout->addWidget(contrastIcon);
+    contrastSlider = new QSlider(Qt::Horizontal, filterBar);
+    contrastSlider->setRange(50, 150);
+    contrastSlider->setValue(qRound(colorFilter.getContrast() * 100));
+    filterLayout->addWidget(contrastSlider, 1);
+
+    filterBtn->setText(ColorFilter::presetName(colorFilter.getPreset()));
+    mainLayout->addWidget(filterBar);
+
     // === 录制信息栏 (计时器) ===
     QWidget* infoBar = new QWidget(this);
     // [修改] 增加固定高度，确保数字不会被底部遮挡
@@ -157,9 +195,17 @@ void RecordDialog::connectSignals() {
     connect(recordBtn, &QPushButton::clicked, this, &RecordDialog::onRecordClicked);
     connect(switchCameraBtn, &QPushButton::clicked, this, &RecordDialog::onSwitchCameraClicked);
     connect(flashBtn, &QPushButton::clicked, this, &RecordDialog::onFlashClicked);
+    connect(dualCameraBtn, &QPushButton::clicked, this, &RecordDialog::onDualCameraClicked);
+    connect(filterBtn, &QPushButton::clicked, this, &RecordDialog::onFilterClicked);
+    connect(exposureSlider, &QSlider::valueChanged, this, &RecordDialog::onFilterAdjusted);
+    connect(contrastSlider, &QSlider::valueChanged, this, &RecordDialog::onFilterAdjusted);
     connect(closeBtn, &QPushButton::clicked, this, &RecordDialog::onCloseClicked);
     connect(useVideoBtn, &QPushButton::clicked, this, &RecordDialog::onUseVideoClicked);
     connect(retakeBtn, &QPushButton::clicked, this, &RecordDialog::onRetakeClicked);
+
+    connect(pipeline, &RecordingPipeline::previewFrame, viewfinderLabel, &ViewfinderWidget::setFrame);
+    connect(pipeline, &RecordingPipeline::recordingFinished, this, &RecordDialog::onEncodingFinished);
+    connect(pipeline, &RecordingPipeline::sourceError, this, &RecordDialog::onSourceError);
 }
 
 void RecordDialog::applyStyles() {
@@ -186,6 +232,11 @@ void RecordDialog::applyStyles() {
 
     closeBtn->setStyleSheet(iconButtonStyle);
     flashBtn->setStyleSheet(iconButtonStyle);
+    dualCameraBtn->setStyleSheet(iconButtonStyle + QString(R"(
+        QPushButton:checked {
+            background-color: %1;
+        }
+    )").arg(DesignSystem::Colors::getPrimary().name()));
     switchCameraBtn->setStyleSheet(iconButtonStyle);
 
     updateRecordButton();
@@ -218,6 +269,36 @@ void RecordDialog::applyStyles() {
     )").arg(DesignSystem::Colors::getPrimary().name())
                                    .arg(DesignSystem::Colors::getPrimaryDark().name()));
 
+    filterBtn->setStyleSheet(QString(R"(
+        QPushButton {
+            background-color: rgba(255, 255, 255, 0.2);
+            border: none;
+            border-radius: 16px;
+            color: white;
+            font-weight: bold;
+        }
+        QPushButton:hover {
+            background-color: %1;
+        }
+    )").arg(DesignSystem::Colors::getPrimary().name()));
+
+    QString sliderStyle = QString(R"(
+        QSlider::groove:horizontal {
+            height: 4px;
+            background: %1;
+            border-radius: 2px;
+        }
+        QSlider::handle:horizontal {
+            background: white;
+            width: 12px;
+            height: 12px;
+            margin: -4px 0;
+            border-radius: 6px;
+        }
+    )").arg(DesignSystem::Colors::getDivider().name());
+    exposureSlider->setStyleSheet(sliderStyle);
+    contrastSlider->setStyleSheet(sliderStyle);
+
     progressBar->setStyleSheet(QString(R"(
         QProgressBar {
             background-color: rgba(255, 255, 255, 0.2);
@@ -269,24 +350,54 @@ void RecordDialog::showPreviewControls(bool show) {
     useVideoBtn->parentWidget()->setVisible(show);
 }
 
-void RecordDialog::simulateRecording() {
-    QString videosPath = "E:/Qt project/cw3/2811_cw3-master-release-lowres/test_videos";
-    QDir dir(videosPath);
-    if (!dir.exists()) {
-        dir.mkpath(".");
-    }
+void RecordDialog::setOutputDirectory(const QString& directory) {
+    pipeline->setOutputDirectory(directory);
+}
 
-    QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss");
-    recordedVideoPath = QString("%1/tomeo_video_%2.mp4")
-                            .arg(videosPath)
-                            .arg(timestamp);
+void RecordDialog::startPreview() {
+    if (!recordedVideoPath.isEmpty() || isEncoding) return;
 
-    qDebug() << "Simulated recording saved to:" << recordedVideoPath;
+    if (!pipeline->startPreview()) {
+        viewfinderLabel->clearFrame();
+        viewfinderLabel->setText(tr("📹\nCamera unavailable"));
+    }
 }
 
 void RecordDialog::showEvent(QShowEvent* event) {
     QDialog::showEvent(event);
-    qDebug() << "RecordDialog shown - attempting to initialize camera";
+    qDebug() << "RecordDialog shown - starting preview from" << pipeline->getSource()->name();
+    startPreview();
+}
+
+void RecordDialog::hideEvent(QHideEvent* event) {
+    if (event->spontaneous()) {
+        QDialog::hideEvent(event);
+        return;
+    }
+
+    // 对话框被复用：隐藏时释放相机，未完成的录制直接丢弃
+    if (isRecording) {
+        isRecording = false;
+        recordTimer->stop();
+        pipeline->discardRecording();
+        updateRecordButton();
+        switchCameraBtn->setEnabled(true);
+        dualCameraBtn->setEnabled(true);
+    }
+    pipeline->stopPreview();
+
+    // 录好但没有使用的视频不留在视频库里
+    if (result() != QDialog::Accepted && !recordedVideoPath.isEmpty()) {
+        QFile::remove(recordedVideoPath);
+    }
+    recordedVideoPath.clear();
+    recordingSeconds = 0;
+    updateTimer();
+    showPreviewControls(false);
+    viewfinderLabel->clearFrame();
+    viewfinderLabel->setText("📹");
+
+    QDialog::hideEvent(event);
 }
 
 void RecordDialog::closeEvent(QCloseEvent* event) {
@@ -305,6 +416,10 @@ void RecordDialog::closeEvent(QCloseEvent* event) {
 
         isRecording = false;
         recordTimer->stop();
+        pipeline->discardRecording();
+        updateRecordButton();
+        switchCameraBtn->setEnabled(true);
+        dualCameraBtn->setEnabled(true);
     }
 
     emit recordingCancelled();
@@ -312,18 +427,31 @@ void RecordDialog::closeEvent(QCloseEvent* event) {
 }
 
 void RecordDialog::onRecordClicked() {
+    if (isEncoding) return;
+
     if (!isRecording) {
         qDebug() << "=== Starting recording ===";
+        if (!pipeline->canRecord()) {
+            QMessageBox::warning(this, tr("Record Video"),
+                                 tr("Recording requires ffmpeg, which was not found on this system."));
+            return;
+        }
+        if (!pipeline->startRecording()) {
+            QMessageBox::warning(this, tr("Record Video"),
+                                 tr("Could not start recording to %1.").arg(pipeline->getOutputDirectory()));
+            return;
+        }
+
         isRecording = true;
         recordingSeconds = 0;
 
         updateRecordButton();
         updateTimer();
+        switchCameraBtn->setEnabled(false);
+        dualCameraBtn->setEnabled(false);
 
         recordTimer->start(1000);
 
-        viewfinderLabel->setText("🔴 REC");
-
     } else {
         qDebug() << "=== Stopping recording ===";
         onRecordingFinished();
@@ -331,13 +459,65 @@ void RecordDialog::onRecordClicked() {
 }
 
 void RecordDialog::onSwitchCameraClicked() {
+    if (isRecording || isEncoding) return;
+
     isFrontCamera = !isFrontCamera;
     qDebug() << "Camera switched to:" << (isFrontCamera ? "Front" : "Back");
+    viewfinderLabel->clearFrame();
     if (isFrontCamera) {
         viewfinderLabel->setText("📹\nFront Camera");
     } else {
         viewfinderLabel->setText("📹\nBack Camera");
     }
+
+    // 正在预览时 setSource 会自动启动新来源
+    pipeline->setSource(createSource());
+}
+
+void RecordDialog::onDualCameraClicked() {
+    if (isRecording || isEncoding) {
+        dualCameraBtn->setChecked(isDualCamera);
+        return;
+    }
+
+    isDualCamera = dualCameraBtn->isChecked();
+    qDebug() << "Dual camera mode:" << isDualCamera;
+    viewfinderLabel->clearFrame();
+    viewfinderLabel->setText(isDualCamera ? tr("📹\nFront + Back") : "📹");
+    pipeline->setSource(createSource());
+}
+
+void RecordDialog::onFilterClicked() {
+    // 按顺序切换预设；设置过 .cube 文件时才出现 Custom
+    ColorFilter::Preset next = ColorFilter::Preset((colorFilter.getPreset() + 1) % (ColorFilter::Custom + 1));
+    if (next == ColorFilter::Custom && colorFilter.getCustomLutPath().isEmpty()) {
+        next = ColorFilter::Original;
+    }
+    colorFilter.setPreset(next);
+    if (colorFilter.getPreset() != next) {
+        colorFilter.setPreset(ColorFilter::Original);   // .cube 文件读取失败
+    }
+    applyFilter();
+}
+
+void RecordDialog::onFilterAdjusted() {
+    colorFilter.setExposure(exposureSlider->value() / 10.0f);
+    colorFilter.setContrast(contrastSlider->value() / 100.0f);
+    applyFilter();
+}
+
+void RecordDialog::applyFilter() {
+    filterBtn->setText(ColorFilter::presetName(colorFilter.getPreset()));
+    pipeline->setFilter(colorFilter);
+    colorFilter.save();
+}
+
+FrameSource* RecordDialog::createSource() const {
+    FrameSource::Kind kind = FrameSource::loadKind();
+    if (isDualCamera) {
+        return new DualCameraSource(kind, isFrontCamera);
+    }
+    return FrameSource::create(kind, isFrontCamera);
 }
 
 void RecordDialog::onFlashClicked() {
@@ -353,17 +533,21 @@ void RecordDialog::onCloseClicked() {
 
 void RecordDialog::onUseVideoClicked() {
     qDebug() << "=== Use video clicked ===";
-    emit videoRecorded(recordedVideoPath, isFrontCamera);
+    emit videoRecorded(recordedVideoPath, isFrontCamera, isDualCamera);
     accept();
 }
 
 void RecordDialog::onRetakeClicked() {
     qDebug() << "=== Retake clicked ===";
+    if (!recordedVideoPath.isEmpty()) {
+        QFile::remove(recordedVideoPath);
+    }
     recordingSeconds = 0;
     recordedVideoPath.clear();
     updateTimer();
     showPreviewControls(false);
     viewfinderLabel->setText("📹");
+    startPreview();
 }
 
 void RecordDialog::onRecordTimerTimeout() {
@@ -381,11 +565,76 @@ void RecordDialog::onRecordingFinished() {
     qDebug() << "Duration:" << recordingSeconds << "seconds";
 
     isRecording = false;
+    isEncoding = true;
     recordTimer->stop();
 
     updateRecordButton();
-    simulateRecording();
+    recordBtn->setEnabled(false);
 
-    viewfinderLabel->setText(QString("✓\nRecorded\n%1s").arg(recordingSeconds));
+    // 编码器写完剩余帧后发出 recordingFinished -> onEncodingFinished
+    pipeline->stopRecording();
+    pipeline->stopPreview();
+    viewfinderLabel->clearFrame();
+    viewfinderLabel->setText(tr("Saving..."));
+}
+
+void RecordDialog::onEncodingFinished(bool ok, const QString& path, const QString& error) {
+    // 丢弃的录制也会回调，这里只处理正常停止的那一次
+    if (!isEncoding) return;
+    isEncoding = false;
+    recordBtn->setEnabled(true);
+    switchCameraBtn->setEnabled(true);
+    dualCameraBtn->setEnabled(true);
+
+    // 编码期间对话框已关闭，视为放弃
+    if (!isVisible()) {
+        if (ok) {
+            QFile::remove(path);
+        }
+        return;
+    }
+
+    if (!ok) {
+        qDebug() << "Recording failed:" << error;
+        QMessageBox::warning(this, tr("Record Video"),
+                             tr("The recording could not be saved.\n%1").arg(error));
+        recordingSeconds = 0;
+        updateTimer();
+        viewfinderLabel->setText("📹");
+        if (isVisible()) {
+            startPreview();
+        }
+        return;
+    }
+
+    recordedVideoPath = path;
+    RecordingStats stats = pipeline->stats();
+    qDebug() << "Recording saved to:" << path
+             << stats.framesEncoded << "frames encoded,"
+             << stats.droppedAtSource << "dropped at source,"
+             << stats.droppedAtEncoder << "dropped at encoder,"
+             << stats.framesDuplicated << "duplicated to hold the frame rate";
+    if (DualCameraSource* dual = qobject_cast<DualCameraSource*>(pipeline->getSource())) {
+        CompositeStats composite = dual->stats();
+        qDebug() << "Composite:" << composite.averageUs << "us avg," << composite.worstUs << "us worst,"
+                 << composite.framesOverBudget << "of" << composite.framesComposed << "over budget,"
+                 << composite.insetDropped << "inset frames dropped";
+    }
+
+    QString summary = QString("✓\nRecorded\n%1s").arg(recordingSeconds);
+    if (stats.droppedTotal() > 0) {
+        summary += tr("\n%1 frames dropped").arg(stats.droppedTotal());
+    }
+    viewfinderLabel->setText(summary);
     showPreviewControls(true);
 }
+
+void RecordDialog::onSourceError(const QString& message) {
+    qDebug() << "RecordDialog: frame source error" << message;
+    if (isRecording) {
+        onRecordingFinished();
+    }
+    pipeline->stopPreview();
+    viewfinderLabel->clearFrame();
+    viewfinderLabel->setText(tr("📹\n%1").arg(message));
+}
@@ -1,6 +1,7 @@
 //
 // RecordDialog - 视频录制对话框
-// 模拟相机录制功能
+// Iteration 4: 通过 RecordingPipeline 真实采集并编码到视频库目录，
+//              帧来源可以是相机或测试图案
 //
 
 #ifndef RECORD_DIALOG_H
@@ -12,43 +13,51 @@
 #include <QPushButton>
 #include <QLabel>
 #include <QTimer>
-#include <QCamera>
-#include <QCameraViewfinder>
-#include <QCameraImageCapture>
-#include <QMediaRecorder>
 #include <QProgressBar>
+#include <QSlider>
 #include <QCloseEvent>
 #include <QShowEvent>
+#include <QHideEvent>
 #include "social_types.h"
+#include "recording_pipeline.h"
+#include "viewfinder_widget.h"
 
 class RecordDialog : public QDialog {
     Q_OBJECT
 
 private:
     // UI组件
-    QLabel* viewfinderLabel;        // 取景器预览
+    ViewfinderWidget* viewfinderLabel;   // 取景器预览
     QPushButton* recordBtn;          // 录制按钮
     QPushButton* switchCameraBtn;    // 切换摄像头
     QPushButton* closeBtn;           // 关闭按钮
     QPushButton* flashBtn;           // 闪光灯
+    QPushButton* dualCameraBtn;      // 双摄（BeReal）模式
     QLabel* timerLabel;              // 录制时长
     QProgressBar* progressBar;       // 录制进度
 
+    // 滤镜栏
+    QPushButton* filterBtn;          // 切换 LUT 预设
+    QSlider* exposureSlider;         // 曝光，单位 0.1 档
+    QSlider* contrastSlider;         // 对比度，百分比
+
     // 底部操作按钮
     QPushButton* useVideoBtn;        // 使用视频
     QPushButton* retakeBtn;          // 重新录制
 
     // 录制状态
     bool isRecording;
-    bool isFrontCamera;
+    bool isEncoding;                 // 已停止录制，等待编码器写完文件
+    bool isFrontCamera;              // 双摄模式下表示主画面的朝向
+    bool isDualCamera;
     int recordingSeconds;
     int maxRecordingSeconds;
 
     QTimer* recordTimer;
 
-    // 相机相关（可选，如果系统支持）
-    QCamera* camera;
-    QMediaRecorder* mediaRecorder;
+    // 采集 -> 取景器 / 编码
+    RecordingPipeline* pipeline;
+    ColorFilter colorFilter;
 
     QString recordedVideoPath;
 
@@ -58,12 +67,13 @@ private:
     void updateRecordButton();
     void updateTimer();
     void showPreviewControls(bool show);
-
-    // 模拟录制（如果没有真实相机）
-    void simulateRecording();
+    void startPreview();
+    FrameSource* createSource() const;
+    void applyFilter();
 
 protected:
     void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
     void closeEvent(QCloseEvent* event) override;
 
 public:
@@ -72,19 +82,28 @@ public:
 
     QString getRecordedVideoPath() const { return recordedVideoPath; }
     bool isFrontCameraUsed() const { return isFrontCamera; }
+    bool isDualCameraUsed() const { return isDualCamera; }
+
+    // 录制文件保存目录（视频库目录）
+    void setOutputDirectory(const QString& directory);
 
 private slots:
     void onRecordClicked();
     void onSwitchCameraClicked();
+    void onDualCameraClicked();
+    void onFilterClicked();
+    void onFilterAdjusted();
     void onFlashClicked();
     void onCloseClicked();
     void onUseVideoClicked();
     void onRetakeClicked();
     void onRecordTimerTimeout();
     void onRecordingFinished();
+    void onEncodingFinished(bool ok, const QString& path, const QString& error);
+    void onSourceError(const QString& message);
 
 signals:
-    void videoRecorded(const QString& videoPath, bool isFrontCamera);
+    void videoRecorded(const QString& videoPath, bool isFrontCamera, bool isBeReal);
     void recordingCancelled();
 };
 
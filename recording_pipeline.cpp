@@ -0,0 +1,179 @@
+//
+// RecordingPipeline - 实现
+//
+
+#include "recording_pipeline.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QMutexLocker>
+#include <QStandardPaths>
+
+RecordingPipeline::RecordingPipeline(QObject* parent)
+    : QObject(parent),
+    source(nullptr),
+    outputDirectory(defaultOutputDirectory()),
+    frameSize(DefaultWidth, DefaultHeight),
+    framesPerSecond(DefaultFramesPerSecond),
+    previewing(false),
+    recording(false),
+    framesCaptured(0) {
+
+    encoder = new FrameEncoder(this);
+    connect(encoder, &FrameEncoder::finished, this, &RecordingPipeline::recordingFinished);
+
+    filterThread = new QThread(this);
+    filterThread->setObjectName("RecordingFilter");
+    filterWorker = new QObject();
+    filterWorker->moveToThread(filterThread);
+    filterThread->start();
+}
+
+RecordingPipeline::~RecordingPipeline() {
+    if (recording) {
+        discardRecording();
+    }
+    stopPreview();
+
+    filterThread->quit();
+    filterThread->wait();
+    delete filterWorker;
+}
+
+QString RecordingPipeline::defaultOutputDirectory() {
+    return QStandardPaths::writableLocation(QStandardPaths::MoviesLocation) + "/Tomeo";
+}
+
+void RecordingPipeline::setSource(FrameSource* newSource) {
+    bool wasPreviewing = previewing;
+    stopPreview();
+
+    delete source;
+    source = newSource;
+
+    if (source) {
+        source->setParent(this);
+        // 帧排队到调色线程，来源线程和界面线程都不做逐像素处理；
+        // 记下来源，旧来源残留在队列里的帧不会被算到新来源头上
+        FrameSource* from = source;
+        connect(source, &FrameSource::frameCaptured, filterWorker,
+                [this, from](const QImage& frame, qint64 timestampUs) {
+                    filterFrame(from, frame, timestampUs);
+                });
+        connect(source, &FrameSource::error,
+                this, &RecordingPipeline::sourceError);
+        qDebug() << "RecordingPipeline: source" << source->name();
+    }
+
+    if (wasPreviewing) {
+        startPreview();
+    }
+}
+
+void RecordingPipeline::setFilter(const ColorFilter& filter) {
+    colorFilter = filter;
+
+    QSharedPointer<const ColorFilter> compiled;
+    if (!colorFilter.isIdentity()) {
+        compiled.reset(new ColorFilter(colorFilter));
+    }
+
+    QMutexLocker locker(&filterMutex);
+    activeFilter = compiled;
+}
+
+void RecordingPipeline::setOutputDirectory(const QString& directory) {
+    outputDirectory = directory.isEmpty() ? defaultOutputDirectory() : directory;
+}
+
+bool RecordingPipeline::startPreview() {
+    if (!source) return false;
+    if (previewing) return true;
+
+    previewing = source->start(frameSize, framesPerSecond);
+    return previewing;
+}
+
+void RecordingPipeline::stopPreview() {
+    if (!previewing) return;
+
+    source->stop();
+    previewing = false;
+
+    // 排在后面的空调用返回时，已入队的帧都调完色并交回了本线程
+    QMetaObject::invokeMethod(filterWorker, []() {}, Qt::BlockingQueuedConnection);
+}
+
+bool RecordingPipeline::startRecording() {
+    if (recording || !previewing) return false;
+
+    QDir dir(outputDirectory);
+    if (!dir.exists() && !dir.mkpath(".")) {
+        qDebug() << "RecordingPipeline: cannot create" << outputDirectory;
+        return false;
+    }
+
+    QString timestamp = QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss");
+    QString path = dir.absoluteFilePath(QString("tomeo_video_%1.mp4").arg(timestamp));
+
+    if (!encoder->start(path, frameSize, framesPerSecond, EncoderQueueFrames)) {
+        return false;
+    }
+
+    framesCaptured = 0;
+    source->resetDropped();
+    recording = true;
+    return true;
+}
+
+void RecordingPipeline::stopRecording() {
+    if (!recording) return;
+    recording = false;
+    encoder->finish();
+}
+
+void RecordingPipeline::discardRecording() {
+    if (!recording) return;
+    recording = false;
+    encoder->abort();
+}
+
+RecordingStats RecordingPipeline::stats() const {
+    RecordingStats result;
+    result.framesCaptured = framesCaptured;
+    result.framesEncoded = encoder->encodedCount();
+    result.droppedAtSource = source ? source->droppedCount() : 0;
+    result.droppedAtEncoder = encoder->droppedCount();
+    result.framesDuplicated = encoder->duplicatedCount();
+    return result;
+}
+
+// 调色线程：队列事件还引用着来源的帧，原地调色前会复制一份（1080p 约 8MB，远小于 LUT 本身的开销）
+void RecordingPipeline::filterFrame(FrameSource* from, QImage frame, qint64 timestampUs) {
+    QSharedPointer<const ColorFilter> active;
+    {
+        QMutexLocker locker(&filterMutex);
+        active = activeFilter;
+    }
+    if (active) {
+        active->apply(frame);
+    }
+
+    QMetaObject::invokeMethod(this, [this, from, frame, timestampUs]() {
+        onFrameFiltered(from, frame, timestampUs);
+    }, Qt::QueuedConnection);
+}
+
+// 同一帧（共享数据）同时送往取景器和编码队列；时间戳决定它在输出中的帧位。
+// 在途计数到这里才释放，界面线程卡顿时来源照样会丢帧
+void RecordingPipeline::onFrameFiltered(FrameSource* from, const QImage& frame, qint64 timestampUs) {
+    if (from != source) return;
+
+    if (recording) {
+        framesCaptured++;
+        encoder->submit(frame, timestampUs);
+    }
+    emit previewFrame(frame);
+
+    source->frameConsumed();
+}
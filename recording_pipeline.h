@@ -0,0 +1,97 @@
+//
+// RecordingPipeline - 录制管线
+// Iteration 4: 帧来源 -> 调色 -> 取景器 / 编码器。同一个 QImage 同时交给取景器显示和编码队列，
+//              调色和编码各在独立线程进行，各环节丢帧分别计数
+//
+
+#ifndef RECORDING_PIPELINE_H
+#define RECORDING_PIPELINE_H
+
+#include <QObject>
+#include <QImage>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QSize>
+#include <QThread>
+#include "color_filter.h"
+#include "frame_source.h"
+#include "frame_encoder.h"
+
+struct RecordingStats {
+    int framesCaptured;      // 到达管线的帧
+    int framesEncoded;
+    int droppedAtSource;     // 取景器/管线落后，来源处丢弃
+    int droppedAtEncoder;    // 编码队列已满
+    int framesDuplicated;    // 为保持恒定帧率重复写出的帧
+
+    RecordingStats()
+        : framesCaptured(0), framesEncoded(0), droppedAtSource(0), droppedAtEncoder(0),
+        framesDuplicated(0) {}
+
+    int droppedTotal() const { return droppedAtSource + droppedAtEncoder; }
+};
+
+class RecordingPipeline : public QObject {
+    Q_OBJECT
+
+private:
+    FrameSource* source;
+    FrameEncoder* encoder;
+    ColorFilter colorFilter;
+    QString outputDirectory;
+    QSize frameSize;
+    int framesPerSecond;
+    bool previewing;
+    bool recording;
+    int framesCaptured;
+
+    // 调色线程；来源的帧先排队到这里调色，再回到本对象所在线程分发
+    QThread* filterThread;
+    QObject* filterWorker;
+    QMutex filterMutex;
+    QSharedPointer<const ColorFilter> activeFilter;    // 为空表示不调色
+
+    void filterFrame(FrameSource* from, QImage frame, qint64 timestampUs);
+    void onFrameFiltered(FrameSource* from, const QImage& frame, qint64 timestampUs);
+
+public:
+    explicit RecordingPipeline(QObject* parent = nullptr);
+    ~RecordingPipeline();
+
+    // 默认录制参数；编码队列最多积压 8 帧（30fps 下约 0.27 秒）
+    static const int DefaultWidth = 1280;
+    static const int DefaultHeight = 720;
+    static const int DefaultFramesPerSecond = 30;
+    static const int EncoderQueueFrames = 8;
+
+    static QString defaultOutputDirectory();
+
+    // 接管 source 的所有权；正在预览时自动切换
+    void setSource(FrameSource* source);
+    FrameSource* getSource() const { return source; }
+
+    // 调色同时作用于取景器和录制结果，切换来源后保持；从下一帧开始生效
+    void setFilter(const ColorFilter& filter);
+    ColorFilter getFilter() const { return colorFilter; }
+
+    void setOutputDirectory(const QString& directory);
+    QString getOutputDirectory() const { return outputDirectory; }
+
+    bool startPreview();
+    void stopPreview();
+
+    bool canRecord() const { return encoder->isAvailable(); }
+    bool isRecording() const { return recording; }
+    bool startRecording();
+    void stopRecording();      // 编码完成后发出 recordingFinished
+    void discardRecording();
+
+    RecordingStats stats() const;
+
+signals:
+    void previewFrame(const QImage& frame);
+    void recordingFinished(bool ok, const QString& path, const QString& error);
+    void sourceError(const QString& message);
+};
+
+#endif // RECORDING_PIPELINE_H
@@ -0,0 +1,521 @@
+//
+// SearchIndex - 实现
+//
+
+#include "search_index.h"
+#include "social_manager.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <algorithm>
+#include <cstring>
+
+static const char* BenchmarkFlag = "--benchmark-search";
+
+// 模糊匹配只对足够长的词启用
+static const int MinFuzzyTokenLength = 3;
+
+// 精确命中相对前缀命中的加分
+static const float ExactMatchBoost = 1.5f;
+static const float FuzzyMatchPenalty = 0.5f;
+
+SearchIndex::SearchIndex(QObject* parent)
+    : QObject(parent) {
+}
+
+float SearchIndex::fieldWeight(Field field) {
+    switch (field) {
+    case TitleField:   return 3.0f;
+    case AuthorField:  return 2.0f;
+    case TagField:     return 2.0f;
+    case CaptionField: return 1.0f;
+    case CommentField: return 0.5f;
+    }
+    return 1.0f;
+}
+
+QString SearchIndex::documentKey(SearchDocument::Kind kind, const QString& key) {
+    return (kind == SearchDocument::Clip ? "clip:" : "post:") + key;
+}
+
+// 词首加 '^' 后的不重复二元组；分词结果只含字母数字，'^' 不会与词内字符混淆
+QStringList SearchIndex::termGrams(const QString& term) {
+    QString padded = QChar('^') + term;
+    QStringList grams;
+    for (int i = 0; i + 2 <= padded.size(); i++) {
+        QString gram = padded.mid(i, 2);
+        if (!grams.contains(gram)) {
+            grams << gram;
+        }
+    }
+    return grams;
+}
+
+static bool isIdeographic(QChar c) {
+    QChar::Script script = c.script();
+    return script == QChar::Script_Han || script == QChar::Script_Hiragana ||
+           script == QChar::Script_Katakana || script == QChar::Script_Hangul;
+}
+
+// 按字母数字切词并转小写；中日韩字符逐字成词
+QStringList SearchIndex::tokenize(const QString& text) {
+    QStringList tokens;
+    QString current;
+    QString folded = text.toCaseFolded();
+
+    for (QChar c : folded) {
+        if (isIdeographic(c)) {
+            if (!current.isEmpty()) {
+                tokens << current;
+                current.clear();
+            }
+            tokens << QString(c);
+        } else if (c.isLetterOrNumber()) {
+            current.append(c);
+        } else if (!current.isEmpty()) {
+            tokens << current;
+            current.clear();
+        }
+    }
+
+    if (!current.isEmpty()) {
+        tokens << current;
+    }
+    return tokens;
+}
+
+// 带上限的编辑距离：超过 maxDistance 时提前返回 maxDistance + 1
+int SearchIndex::boundedEditDistance(const QString& a, const QString& b, int maxDistance) {
+    int n = a.size();
+    int m = b.size();
+    if (qAbs(n - m) > maxDistance) return maxDistance + 1;
+
+    QVector<int> previous(m + 1);
+    QVector<int> current(m + 1);
+    for (int j = 0; j <= m; j++) previous[j] = j;
+
+    for (int i = 1; i <= n; i++) {
+        current[0] = i;
+        int rowMin = current[0];
+        for (int j = 1; j <= m; j++) {
+            int cost = a.at(i - 1) == b.at(j - 1) ? 0 : 1;
+            current[j] = std::min({previous[j] + 1, current[j - 1] + 1, previous[j - 1] + cost});
+            rowMin = std::min(rowMin, current[j]);
+        }
+        if (rowMin > maxDistance) return maxDistance + 1;
+        previous.swap(current);
+    }
+
+    return previous[m];
+}
+
+int SearchIndex::ensureDocument(SearchDocument::Kind kind, const QString& key) {
+    QString docKey = documentKey(kind, key);
+    auto it = docIdByKey.constFind(docKey);
+    if (it != docIdByKey.constEnd()) {
+        documents[it.value()].alive = true;
+        return it.value();
+    }
+
+    SearchDocument doc;
+    doc.kind = kind;
+    doc.key = key;
+    documents.append(doc);
+    documentTerms.append(QVector<QString>());
+
+    int docId = documents.size() - 1;
+    docIdByKey.insert(docKey, docId);
+    return docId;
+}
+
+// 摘掉文档的全部倒排条目，重新索引前调用，避免同一文档的权重重复累加
+void SearchIndex::removeDocumentPostings(int docId) {
+    for (const QString& term : documentTerms.at(docId)) {
+        auto it = postings.find(term);
+        if (it == postings.end()) continue;
+
+        QVector<Posting>& list = it.value();
+        auto posting = std::lower_bound(list.begin(), list.end(), docId,
+                                        [](const Posting& p, int id) { return p.docId < id; });
+        if (posting != list.end() && posting->docId == docId) {
+            list.erase(posting);
+        }
+        if (list.isEmpty()) {
+            postings.erase(it);
+        }
+    }
+    documentTerms[docId].clear();
+}
+
+void SearchIndex::addText(int docId, const QString& text, Field field) {
+    float weight = fieldWeight(field);
+    for (const QString& term : tokenize(text)) {
+        addTerm(docId, term, weight);
+    }
+}
+
+// 倒排表按 docId 有序；新文档追加在末尾，评论等后续更新用二分插入
+void SearchIndex::addTerm(int docId, const QString& term, float weight) {
+    QVector<Posting>& list = postings[term];
+    if (list.isEmpty()) {
+        registerTerm(term);
+    }
+
+    if (list.isEmpty() || list.last().docId < docId) {
+        list.append(Posting{docId, weight});
+        documentTerms[docId].append(term);
+        return;
+    }
+
+    auto it = std::lower_bound(list.begin(), list.end(), docId,
+                               [](const Posting& p, int id) { return p.docId < id; });
+    if (it != list.end() && it->docId == docId) {
+        it->weight += weight;
+    } else {
+        list.insert(it, Posting{docId, weight});
+        documentTerms[docId].append(term);
+    }
+}
+
+void SearchIndex::registerTerm(const QString& term) {
+    if (termIds.contains(term)) return;
+
+    int termId = vocabulary.size();
+    vocabulary.append(term);
+    termIds.insert(term, termId);
+    for (const QString& gram : termGrams(term)) {
+        termsByGram[gram].append(termId);
+    }
+}
+
+void SearchIndex::indexClips(const std::vector<TheButtonInfo>& clips) {
+    for (const TheButtonInfo& clip : clips) {
+        if (!clip.url) continue;
+
+        QString path = clip.url->toLocalFile();
+        int docId = ensureDocument(SearchDocument::Clip, path);
+        removeDocumentPostings(docId);
+        addText(docId, clip.title, TitleField);
+        addText(docId, QFileInfo(path).fileName(), TitleField);
+    }
+
+    qDebug() << "SearchIndex: indexed" << clips.size() << "clips,"
+             << termCount() << "terms";
+}
+
+void SearchIndex::indexPost(const VideoPost& post) {
+    // 已索引的帖子（如重新拉取）先摘掉旧条目再整篇重建
+    int docId = ensureDocument(SearchDocument::Post, post.postId);
+    removeDocumentPostings(docId);
+
+    addText(docId, post.caption, CaptionField);
+    addText(docId, post.author.username, AuthorField);
+    addText(docId, post.author.displayName, AuthorField);
+    for (const QString& tag : post.tags) {
+        addText(docId, tag, TagField);
+    }
+    if (post.videoUrl.isLocalFile()) {
+        addText(docId, QFileInfo(post.videoUrl.toLocalFile()).fileName(), TitleField);
+    }
+    for (const Comment& comment : post.comments) {
+        addText(docId, comment.content, CommentField);
+        addText(docId, comment.author.username, CommentField);
+    }
+}
+
+void SearchIndex::indexComment(const QString& postId, const Comment& comment) {
+    int docId = ensureDocument(SearchDocument::Post, postId);
+    addText(docId, comment.content, CommentField);
+    addText(docId, comment.author.username, CommentField);
+}
+
+// 删除时摘掉倒排条目；docId 保留并打墓碑标记，同一帖子再次出现时复用
+void SearchIndex::removePost(const QString& postId) {
+    auto it = docIdByKey.constFind(documentKey(SearchDocument::Post, postId));
+    if (it != docIdByKey.constEnd()) {
+        removeDocumentPostings(it.value());
+        documents[it.value()].alive = false;
+    }
+}
+
+void SearchIndex::clear() {
+    documents.clear();
+    documentTerms.clear();
+    docIdByKey.clear();
+    postings.clear();
+    vocabulary.clear();
+    termIds.clear();
+    termsByGram.clear();
+}
+
+bool SearchIndex::matchToken(const QString& token, QVector<float>& scores) const {
+    float* score = scores.data();
+    bool matched = false;
+
+    // 前缀匹配：在有序词典中从 token 开始向后扫描，展开全部前缀词，不截断召回
+    for (auto it = postings.lowerBound(token);
+         it != postings.constEnd() && it.key().startsWith(token); ++it) {
+        float boost = it.key().size() == token.size() ? ExactMatchBoost : 1.0f;
+        for (const Posting& posting : it.value()) {
+            score[posting.docId] += posting.weight * boost;
+        }
+        matched = true;
+    }
+
+    // 没有前缀命中时再做模糊匹配（拼写错误）
+    if (!matched && token.size() >= MinFuzzyTokenLength) {
+        matched = matchFuzzy(token, scores);
+    }
+    return matched;
+}
+
+bool SearchIndex::matchFuzzy(const QString& token, QVector<float>& scores) const {
+    int maxDistance = token.size() >= 7 ? 2 : 1;
+
+    // 一次编辑最多破坏两个二元组，所以编辑距离在范围内的词至少共享这么多个；
+    // 只有过了这道筛选的词才计算编辑距离，不再逐个比较首字母相同的整段词典
+    QStringList grams = termGrams(token);
+    int required = grams.size() - 2 * maxDistance;
+
+    QHash<int, int> shared;
+    for (const QString& gram : grams) {
+        auto bucket = termsByGram.constFind(gram);
+        if (bucket == termsByGram.constEnd()) continue;
+        for (int termId : bucket.value()) {
+            shared[termId]++;
+        }
+    }
+
+    float* score = scores.data();
+    bool matched = false;
+    for (auto it = shared.constBegin(); it != shared.constEnd(); ++it) {
+        if (it.value() < required) continue;
+
+        const QString& term = vocabulary.at(it.key());
+        auto list = postings.constFind(term);
+        if (list == postings.constEnd()) continue;      // 所在文档都已删除
+
+        // 同时允许把词典词的前缀当作匹配对象（边输入边纠错）；前缀的二元组是整词的子集，筛选依然成立
+        QString candidate = term.size() > token.size() + maxDistance
+                                ? term.left(token.size())
+                                : term;
+        if (qAbs(candidate.size() - token.size()) > maxDistance) continue;
+        if (boundedEditDistance(token, candidate, maxDistance) > maxDistance) continue;
+
+        for (const Posting& posting : list.value()) {
+            score[posting.docId] += posting.weight * FuzzyMatchPenalty;
+        }
+        matched = true;
+    }
+    return matched;
+}
+
+bool SearchIndex::scoreQuery(const QString& query, QVector<float>& total) const {
+    QStringList tokens = tokenize(query);
+    if (tokens.isEmpty()) return false;
+
+    // 分数按 docId 放在连续数组里累加，求交集只需线性扫描一遍，不经过哈希表。
+    // 权重都为正，0 表示未命中；某个词没命中的文档此后一直保持 0
+    total.fill(0.0f, documents.size());
+    QVector<float> tokenScores(documents.size(), 0.0f);
+    for (int i = 0; i < tokens.size(); i++) {
+        if (i > 0) tokenScores.fill(0.0f);
+        if (!matchToken(tokens.at(i), tokenScores)) return false;
+
+        if (i == 0) {
+            total.swap(tokenScores);
+            continue;
+        }
+        float* sum = total.data();
+        const float* part = tokenScores.constData();
+        for (int docId = 0; docId < total.size(); docId++) {
+            sum[docId] = sum[docId] > 0.0f && part[docId] > 0.0f ? sum[docId] + part[docId] : 0.0f;
+        }
+    }
+    return true;
+}
+
+QVector<SearchResult> SearchIndex::search(const QString& query, int limit) const {
+    QVector<SearchResult> results;
+    QVector<float> total;
+    if (!scoreQuery(query, total)) return results;
+
+    const float* sum = total.constData();
+    for (int docId = 0; docId < total.size(); docId++) {
+        if (sum[docId] <= 0.0f || !documents.at(docId).alive) continue;
+
+        SearchResult result;
+        result.kind = documents.at(docId).kind;
+        result.key = documents.at(docId).key;
+        result.score = sum[docId];
+        results.append(result);
+    }
+
+    // 只对前 limit 个做部分排序
+    int count = std::min(limit, static_cast<int>(results.size()));
+    std::partial_sort(results.begin(), results.begin() + count, results.end(),
+                      [](const SearchResult& a, const SearchResult& b) {
+                          return a.score > b.score;
+                      });
+    results.resize(count);
+    return results;
+}
+
+void SearchIndex::matchKeys(const QString& query, QSet<QString>& clipKeys, QSet<QString>& postKeys) const {
+    clipKeys.clear();
+    postKeys.clear();
+
+    QVector<float> total;
+    if (!scoreQuery(query, total)) return;
+
+    const float* sum = total.constData();
+    for (int docId = 0; docId < total.size(); docId++) {
+        if (sum[docId] <= 0.0f || !documents.at(docId).alive) continue;
+
+        const SearchDocument& document = documents.at(docId);
+        (document.kind == SearchDocument::Clip ? clipKeys : postKeys).insert(document.key);
+    }
+}
+
+void SearchIndex::attachToSocialManager() {
+    SocialManager* socialManager = SocialManager::getInstance();
+
+    for (const VideoPost& post : socialManager->getAllPosts()) {
+        indexPost(post);
+    }
+
+    connect(socialManager, &SocialManager::postAdded,
+            this, &SearchIndex::onPostAdded);
+    connect(socialManager, &SocialManager::postDeleted,
+            this, &SearchIndex::onPostDeleted);
+    connect(socialManager, &SocialManager::commentAdded,
+            this, &SearchIndex::onCommentAdded);
+    connect(socialManager, &SocialManager::postReplaced,
+            this, &SearchIndex::onPostReplaced);
+
+    qDebug() << "SearchIndex: indexed" << socialManager->getAllPosts().size()
+             << "posts," << termCount() << "terms";
+}
+
+void SearchIndex::onPostAdded(const VideoPost& post) {
+    indexPost(post);
+}
+
+// indexPost 会先摘掉旧条目，被替换的评论不会残留在索引里
+void SearchIndex::onPostReplaced(const VideoPost& post) {
+    indexPost(post);
+}
+
+void SearchIndex::onPostDeleted(const QString& postId) {
+    removePost(postId);
+}
+
+void SearchIndex::onCommentAdded(const QString& postId, const Comment& comment) {
+    indexComment(postId, comment);
+}
+
+bool SearchIndex::isBenchmarkMode(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], BenchmarkFlag, std::strlen(BenchmarkFlag)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int SearchIndex::runBenchmark(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("Tomeo");
+
+    // --benchmark-search[=N]，默认 10 万条帖子
+    int postCount = 100000;
+    for (int i = 1; i < argc; i++) {
+        QString argument = QString::fromLocal8Bit(argv[i]);
+        QString prefix = QString(BenchmarkFlag) + "=";
+        if (argument.startsWith(prefix) && argument.mid(prefix.size()).toInt() > 0) {
+            postCount = argument.mid(prefix.size()).toInt();
+        }
+    }
+
+    static const int Runs = 50;
+    static const double QueryBudgetMs = 1.0;
+    static const int VocabularySize = 20000;
+    static const int UserCount = 2000;
+
+    // 固定种子的合成语料：音节拼成的词，每条帖子 8 词标题、2 个标签、作者和 2 条评论
+    quint32 state = 20240601u;
+    auto next = [&state](int bound) {
+        state = state * 1664525u + 1013904223u;
+        return int((state >> 8) % quint32(bound));
+    };
+    static const char* Syllables[] = {"ka", "lo", "mi", "ra", "ne", "to", "su", "vi",
+                                      "da", "pe", "zu", "ho", "ba", "ge", "fi", "wo"};
+    QStringList words;
+    for (int i = 0; i < VocabularySize; i++) {
+        QString word;
+        int syllables = 2 + next(3);
+        for (int j = 0; j < syllables; j++) {
+            word += Syllables[next(16)];
+        }
+        words << word;
+    }
+
+    SearchIndex index;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < postCount; i++) {
+        VideoPost post;
+        post.postId = QString("post_%1").arg(i);
+        post.author.username = QString("user%1").arg(next(UserCount));
+        post.author.displayName = words.at(next(UserCount));
+        QStringList caption;
+        for (int j = 0; j < 8; j++) {
+            caption << words.at(next(VocabularySize));
+        }
+        post.caption = caption.join(' ');
+        post.tags << words.at(next(VocabularySize)) << words.at(next(VocabularySize));
+        for (int j = 0; j < 2; j++) {
+            Comment comment;
+            comment.author.username = QString("user%1").arg(next(UserCount));
+            comment.content = words.at(next(VocabularySize)) + " " + words.at(next(VocabularySize));
+            post.comments.append(comment);
+        }
+        index.indexPost(post);
+    }
+    qDebug().noquote() << QString("Search benchmark: %1 posts, %2 terms, indexed in %3 ms, budget %4 ms per query")
+                              .arg(postCount).arg(index.termCount())
+                              .arg(timer.elapsed()).arg(QueryBudgetMs, 0, 'f', 1);
+
+    // 拼写错误：把一个长词中间的字母换成语料里没有的 'x'
+    QString typo = words.at(7);
+    typo[typo.size() / 2] = QChar('x');
+
+    QStringList queries;
+    queries << "k"                                        // 单字母前缀，展开最多
+            << "kalo"                                     // 普通前缀
+            << words.at(42)                               // 精确词
+            << words.at(42) + " " + words.at(43).left(3)  // 两个词求交
+            << typo                                       // 模糊匹配
+            << "qqqq";                                    // 无结果
+    for (const QString& query : queries) {
+        qint64 totalNs = 0;
+        qint64 worstNs = 0;
+        int hits = 0;
+        for (int run = 0; run < Runs; run++) {
+            timer.restart();
+            hits = index.search(query).size();
+            qint64 elapsed = timer.nsecsElapsed();
+            totalNs += elapsed;
+            worstNs = qMax(worstNs, elapsed);
+        }
+        double averageMs = totalNs / 1e6 / Runs;
+        qDebug().noquote() << QString("  %1 avg %2 ms worst %3 ms, %4 results %5")
+                                  .arg("\"" + query + "\"", -28)
+                                  .arg(averageMs, 7, 'f', 3)
+                                  .arg(worstNs / 1e6, 7, 'f', 3)
+                                  .arg(hits)
+                                  .arg(averageMs <= QueryBudgetMs ? "" : "(over budget)");
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+//
+// SearchIndex - 全文搜索倒排索引
+// Iteration 4: 索引视频标题/文件名、帖子标题、标签、作者和评论，支持前缀与模糊匹配。
+//              --benchmark-search[=N] 用 N 条合成帖子测量建索引和查询耗时
+//
+
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+
+#include <QObject>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <vector>
+#include "social_types.h"
+#include "the_button.h"
+
+// 被索引的条目
+struct SearchDocument {
+    enum Kind {
+        Clip,   // 本地视频（key 为本地文件路径）
+        Post    // 社交帖子（key 为 postId）
+    };
+
+    Kind kind;
+    QString key;
+    bool alive;
+
+    SearchDocument()
+        : kind(Clip), alive(true) {}
+};
+
+struct SearchResult {
+    SearchDocument::Kind kind;
+    QString key;
+    float score;
+
+    SearchResult()
+        : kind(SearchDocument::Clip), score(0) {}
+};
+
+class SearchIndex : public QObject {
+    Q_OBJECT
+
+public:
+    // 字段权重
+    enum Field {
+        TitleField,
+        AuthorField,
+        TagField,
+        CaptionField,
+        CommentField
+    };
+
+private:
+    struct Posting {
+        int docId;
+        float weight;
+    };
+
+    QVector<SearchDocument> documents;
+    QVector<QVector<QString>> documentTerms;   // docId -> 该文档出现过的词，重建或删除时摘除倒排条目
+    QHash<QString, int> docIdByKey;            // "kind:key" -> docId
+    QMap<QString, QVector<Posting>> postings;  // 有序词典，支持前缀范围查找
+
+    // 模糊匹配用的二元组索引（词首加 '^'），词只登记一次，倒排表为空的词查询时跳过
+    QVector<QString> vocabulary;
+    QHash<QString, int> termIds;
+    QHash<QString, QVector<int>> termsByGram;
+
+    static float fieldWeight(Field field);
+    static QString documentKey(SearchDocument::Kind kind, const QString& key);
+    static QStringList termGrams(const QString& term);
+
+    int ensureDocument(SearchDocument::Kind kind, const QString& key);
+    void removeDocumentPostings(int docId);
+    void addText(int docId, const QString& text, Field field);
+    void addTerm(int docId, const QString& term, float weight);
+    void registerTerm(const QString& term);
+
+    // 单个查询词的分数累加到按 docId 下标的数组，没有任何命中时返回 false
+    bool matchToken(const QString& token, QVector<float>& scores) const;
+    bool matchFuzzy(const QString& token, QVector<float>& scores) const;
+    // 所有查询词的分数之和（AND），未全部命中的文档为 0；没有任何命中时返回 false
+    bool scoreQuery(const QString& query, QVector<float>& total) const;
+
+public:
+    explicit SearchIndex(QObject* parent = nullptr);
+
+    static QStringList tokenize(const QString& text);
+    static int boundedEditDistance(const QString& a, const QString& b, int maxDistance);
+
+    // 建立/更新索引
+    void indexClips(const std::vector<TheButtonInfo>& clips);
+    void indexPost(const VideoPost& post);
+    void indexComment(const QString& postId, const Comment& comment);
+    void removePost(const QString& postId);
+    void clear();
+
+    // 所有查询词都需命中（AND），按分数降序
+    QVector<SearchResult> search(const QString& query, int limit = 200) const;
+    // 与 search 命中相同，但只返回各类的 key 集合，不排序（用于过滤界面）
+    void matchKeys(const QString& query, QSet<QString>& clipKeys, QSet<QString>& postKeys) const;
+
+    int documentCount() const { return documents.size(); }
+    int termCount() const { return postings.size(); }
+
+    // 连接 SocialManager 的变更信号，增量更新
+    void attachToSocialManager();
+
+    static bool isBenchmarkMode(int argc, char* argv[]);
+    static int runBenchmark(int argc, char* argv[]);
+
+private slots:
+    void onPostAdded(const VideoPost& post);
+    void onPostReplaced(const VideoPost& post);
+    void onPostDeleted(const QString& postId);
+    void onCommentAdded(const QString& postId, const Comment& comment);
+};
+
+#endif // SEARCH_INDEX_H
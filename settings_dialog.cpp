@@ -4,6 +4,7 @@
 
 #include "settings_dialog.h"
 #include "design_system.h"
+#include "gl_video_widget.h"
 #include <QDebug>
 
 SettingsDialog::SettingsDialog(QWidget* parent)
@@ -77,6 +78,23 @@ void SettingsDialog::setupUI() {
     autoPlayCheckBox->setChecked(true);
     playbackLayout->addWidget(autoPlayCheckBox);
 
+    QLabel* videoOutputLabel = new QLabel(tr("Video output:"), playbackGroup);
+    videoOutputLabel->setFont(DesignSystem::Typography::getBody());
+    playbackLayout->addWidget(videoOutputLabel);
+
+    videoOutputComboBox = new QComboBox(playbackGroup);
+    videoOutputComboBox->addItem(tr("Standard"), VideoOutput::Standard);
+    videoOutputComboBox->addItem(tr("OpenGL (accelerated)"), VideoOutput::OpenGL);
+    videoOutputComboBox->setFont(DesignSystem::Typography::getBody());
+    videoOutputComboBox->setMinimumHeight(DesignSystem::Dimensions::ButtonHeight);
+    playbackLayout->addWidget(videoOutputComboBox);
+
+    diagnosticsButton = new QPushButton(tr("Video Diagnostics..."), playbackGroup);
+    diagnosticsButton->setFont(DesignSystem::Typography::getButton());
+    diagnosticsButton->setMinimumHeight(DesignSystem::Dimensions::ButtonHeightSmall);
+    diagnosticsButton->setCursor(Qt::PointingHandCursor);
+    playbackLayout->addWidget(diagnosticsButton);
+
     mainLayout->addWidget(playbackGroup);
 
     mainLayout->addStretch();
@@ -122,6 +140,12 @@ void SettingsDialog::connectSignals() {
             this, &SettingsDialog::onCancelClicked);
     connect(applyButton, &QPushButton::clicked,
             this, &SettingsDialog::onApplyClicked);
+    connect(videoOutputComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [this](int index) {
+                selectedVideoOutput = videoOutputComboBox->itemData(index).toInt();
+            });
+    connect(diagnosticsButton, &QPushButton::clicked,
+            this, &SettingsDialog::diagnosticsRequested);
 }
 
 void SettingsDialog::applyStyles() {
@@ -210,6 +234,7 @@ void SettingsDialog::applyStyles() {
 
     okButton->setStyleSheet(buttonStyle);
     applyButton->setStyleSheet(buttonStyle);
+    diagnosticsButton->setStyleSheet(buttonStyle);
 
     QString cancelButtonStyle = QString(R"(
         QPushButton {
@@ -245,6 +270,11 @@ void SettingsDialog::loadCurrentSettings() {
     darkModeEnabled = themeManager->isDarkTheme();
     darkModeCheckBox->setChecked(darkModeEnabled);
 
+    // 加载视频输出方式
+    selectedVideoOutput = VideoOutput::loadMode();
+    videoOutputComboBox->setCurrentIndex(
+        videoOutputComboBox->findData(selectedVideoOutput));
+
     qDebug() << "Settings loaded - Language:" << languageManager->getLanguageName()
              << "Dark Mode:" << darkModeEnabled;
 }
@@ -288,6 +318,13 @@ void SettingsDialog::onApplyClicked() {
         qDebug() << "Theme changed to:" << (darkModeEnabled ? "Dark" : "Light");
     }
 
+    // 应用视频输出方式
+    if (selectedVideoOutput != VideoOutput::loadMode()) {
+        VideoOutput::saveMode(static_cast<VideoOutput::Mode>(selectedVideoOutput));
+        emit videoOutputChanged(selectedVideoOutput);
+        qDebug() << "Video output changed to:" << selectedVideoOutput;
+    }
+
     emit settingsApplied();
 
     qDebug() << "Settings applied successfully";
@@ -25,6 +25,8 @@ private:
     QComboBox* languageComboBox;
     QCheckBox* darkModeCheckBox;
     QCheckBox* autoPlayCheckBox;
+    QComboBox* videoOutputComboBox;
+    QPushButton* diagnosticsButton;
     QPushButton* okButton;
     QPushButton* cancelButton;
     QPushButton* applyButton;
@@ -36,6 +38,7 @@ private:
     // 临时设置
     LanguageManager::Language selectedLanguage;
     bool darkModeEnabled;
+    int selectedVideoOutput;
 
     void setupUI();
     void connectSignals();
@@ -54,6 +57,8 @@ private slots:
 
 signals:
     void settingsApplied();
+    void videoOutputChanged(int mode);
+    void diagnosticsRequested();
 };
 
 #endif // SETTINGS_DIALOG_H
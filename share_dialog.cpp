@@ -4,6 +4,7 @@
 
 #include "share_dialog.h"
 #include "design_system.h"
+#include "image_decode_pool.h"
 #include <QDebug>
 #include <QMessageBox>
 
@@ -162,6 +163,9 @@ void ShareDialog::setupUI() {
 }
 
 void ShareDialog::connectSignals() {
+    connect(ImageDecodePool::getInstance(), &ImageDecodePool::imageDecoded,
+            this, &ShareDialog::onThumbnailDecoded);
+
     // 平台选择
     connect(platformGroup,
 #if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
@@ -293,13 +297,18 @@ void ShareDialog::updatePostPreview() {
     // 更新作者信息
     authorLabel->setText(QString("@%1").arg(post.author.username));
 
-    // 更新缩略图
-    if (!post.thumbnail.isNull()) {
-        postPreviewLabel->setPixmap(post.thumbnail.scaled(
-            480, 200,
-            Qt::KeepAspectRatio,
-            Qt::SmoothTransformation
-            ));
+    // 更新缩略图（文件缩略图按预览尺寸解码，完成前显示占位）
+    QPixmap preview;
+    if (!post.thumbnailPath.isEmpty()) {
+        QSize previewSize(480, 200);
+        qreal dpr = devicePixelRatioF();
+        if (!ImageDecodePool::getInstance()->fetch(post.thumbnailPath, previewSize, dpr, &preview)) {
+            pendingThumbnailKey = ImageDecodePool::cacheKey(post.thumbnailPath, previewSize, dpr);
+        }
+    }
+
+    if (!preview.isNull()) {
+        postPreviewLabel->setPixmap(preview);
     } else {
         postPreviewLabel->setText("📹");
         postPreviewLabel->setStyleSheet(QString(R"(
@@ -318,6 +327,15 @@ void ShareDialog::updatePostPreview() {
     captionLabel->setText(caption);
 }
 
+void ShareDialog::onThumbnailDecoded(const QString& key, const QPixmap& pixmap) {
+    if (key != pendingThumbnailKey) return;
+    pendingThumbnailKey.clear();
+
+    if (!pixmap.isNull()) {
+        postPreviewLabel->setPixmap(pixmap);
+    }
+}
+
 void ShareDialog::onPlatformSelected(int id) {
     // 根据ID设置平台名称
     switch (id) {
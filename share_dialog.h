@@ -43,6 +43,7 @@ private:
     QPushButton* cancelButton;
 
     QString selectedPlatform;
+    QString pendingThumbnailKey;   // 等待解码完成的预览图
 
     void setupUI();
     void connectSignals();
@@ -59,6 +60,7 @@ private slots:
     void onPlatformSelected(int id);
     void onShareClicked();
     void onCancelClicked();
+    void onThumbnailDecoded(const QString& key, const QPixmap& pixmap);
 
 signals:
     void shareConfirmed(const QString& postId, const QString& platform, const QString& comment);
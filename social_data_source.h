@@ -0,0 +1,48 @@
+//
+// SocialDataSource - 社交数据来源接口
+// Iteration 4: 帖子/评论/好友的异步获取，可替换为模拟服务或网络后端
+//
+
+#ifndef SOCIAL_DATA_SOURCE_H
+#define SOCIAL_DATA_SOURCE_H
+
+#include <QObject>
+#include <QJsonArray>
+#include <QString>
+#include <QVector>
+#include "social_types.h"
+
+// 一页帖子；nextCursor 为空表示没有更多
+struct SocialPostPage {
+    QVector<VideoPost> posts;
+    QString cursor;
+    QString nextCursor;
+};
+
+// 所有请求立即返回请求编号，结果通过信号异步返回（在数据源所在线程）
+class SocialDataSource : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SocialDataSource(QObject* parent = nullptr) : QObject(parent) {}
+    virtual ~SocialDataSource() {}
+
+    virtual QString name() const = 0;
+
+    // cursor 为空表示第一页；limit <= 0 使用数据源的默认页大小
+    virtual quint64 fetchPosts(const QString& cursor, int limit) = 0;
+    virtual quint64 fetchComments(const QString& postId) = 0;
+    virtual quint64 fetchFriends() = 0;
+
+    // 上传一批本地变更（点赞/评论），结果按条返回服务端的权威状态
+    virtual quint64 postMutations(const QJsonArray& mutations) = 0;
+
+signals:
+    void postsFetched(quint64 requestId, const SocialPostPage& page);
+    void commentsFetched(quint64 requestId, const QString& postId, const QVector<Comment>& comments);
+    void friendsFetched(quint64 requestId, const QVector<UserInfo>& friends);
+    void mutationsPosted(quint64 requestId, const QJsonArray& results);
+    void requestFailed(quint64 requestId, const QString& error);
+};
+
+#endif // SOCIAL_DATA_SOURCE_H
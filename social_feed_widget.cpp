@@ -6,16 +6,74 @@
 #include "social_manager.h"
 #include "design_system.h"
 #include "share_dialog.h"
+#include "inline_playback_pool.h"
+#include "window_visibility_watcher.h"
+#include "mutation_queue.h"
 #include <QDebug>
+#include <QScrollBar>
+#include <algorithm>
+
+// 热门页只展示排名最前的帖子
+static const int HotFeedLimit = 50;
+
+// 缩略图区域至少 60% 可见才自动播放；滚动停止 150ms 后再分配播放器
+static const double AutoplayVisibleFraction = 0.6;
+static const int AutoplaySettleMs = 150;
+
+// 服务端拒绝变更的提示显示时长
+static const int SyncNoticeMs = 4000;
 
 SocialFeedWidget::SocialFeedWidget(QWidget* parent)
     : QWidget(parent),
-    currentFilter(AllPosts) {
+    currentFilter(AllPosts),
+    pendingQueryId(0) {
+
+    inlinePool = new InlinePlaybackPool(InlinePlaybackPool::loadCapacity(), this);
+    autoplayTimer = new QTimer(this);
+    autoplayTimer->setSingleShot(true);
+    autoplayTimer->setInterval(AutoplaySettleMs);
+    connect(autoplayTimer, &QTimer::timeout, this, &SocialFeedWidget::updateAutoplay);
+
+    windowWatcher = new WindowVisibilityWatcher(this);
+    connect(windowWatcher, &WindowVisibilityWatcher::presentedChanged,
+            this, &SocialFeedWidget::updateAutoplay);
 
     setupUI();
     connectSignals();
     applyStyles();
+
+    connect(SocialManager::getInstance(), &SocialManager::postsQueried,
+            this, &SocialFeedWidget::onPostsQueried);
+
+    // 滚动到接近底部时预取下一页
+    connect(scrollArea->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &SocialFeedWidget::onScrollPositionChanged);
+    connect(scrollArea->verticalScrollBar(), &QScrollBar::rangeChanged,
+            this, &SocialFeedWidget::onScrollPositionChanged);
+    // 滚动或内容高度变化后重新挑选自动播放的卡片
+    connect(scrollArea->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &SocialFeedWidget::scheduleAutoplayUpdate);
+    connect(scrollArea->verticalScrollBar(), &QScrollBar::rangeChanged,
+            this, &SocialFeedWidget::scheduleAutoplayUpdate);
     loadPosts();
+
+    // 缩略图在后台加载，完成后刷新已创建的 Feed
+    connect(SocialManager::getInstance(), &SocialManager::thumbnailsLoaded,
+            this, &SocialFeedWidget::refreshFeed);
+
+    // 帖子变更按事件循环合并后统一处理，批量导入时只刷新一次
+    connect(SocialManager::getInstance(), &SocialManager::postsChanged,
+            this, &SocialFeedWidget::onPostsChanged);
+
+    syncNoticeTimer = new QTimer(this);
+    syncNoticeTimer->setSingleShot(true);
+    syncNoticeTimer->setInterval(SyncNoticeMs);
+    connect(syncNoticeTimer, &QTimer::timeout, this, &SocialFeedWidget::updateSyncStatus);
+
+    MutationQueue* queue = MutationQueue::getInstance();
+    connect(queue, &MutationQueue::pendingCountChanged, this, &SocialFeedWidget::updateSyncStatus);
+    connect(queue, &MutationQueue::mutationRejected, this, &SocialFeedWidget::onMutationRejected);
+    updateSyncStatus();
 }
 
 void SocialFeedWidget::setupUI() {
@@ -63,6 +121,11 @@ void SocialFeedWidget::setupUI() {
 
     filterLayout->addStretch();
 
+    syncStatusLabel = new QLabel(filterWidget);
+    syncStatusLabel->setFont(DesignSystem::Typography::getCaption());
+    syncStatusLabel->hide();
+    filterLayout->addWidget(syncStatusLabel);
+
     mainLayout->addWidget(filterWidget);
 
     // 添加分隔线
@@ -147,30 +210,42 @@ void SocialFeedWidget::applyStyles() {
     // 空状态标签
     emptyStateLabel->setStyleSheet(QString("color: %1;")
                                        .arg(DesignSystem::Colors::getTextSecondary().name()));
+    syncStatusLabel->setStyleSheet(QString("color: %1;")
+                                       .arg(DesignSystem::Colors::getTextSecondary().name()));
 }
 
 void SocialFeedWidget::loadPosts() {
-    clearPosts();
-
+    // 查询在社交工作线程执行，结果回来后再重建卡片
     SocialManager* socialManager = SocialManager::getInstance();
-    QVector<VideoPost> posts;
+    pendingQueryId = socialManager->queryPosts(currentFilter,
+                                               currentFilter == HotPosts ? HotFeedLimit : -1);
+}
 
-    // 根据过滤类型加载帖子
-    switch (currentFilter) {
-    case AllPosts:
-        posts = socialManager->getAllPosts();
-        break;
-    case HotPosts:
-        posts = socialManager->getHotPosts();
-        break;
-    case FriendsPosts:
-        posts = socialManager->getFriendsPosts();
-        break;
+void SocialFeedWidget::onPostsQueried(quint64 requestId, SocialFilter filter,
+                                      const QVector<QString>& postIds) {
+    // 过滤切换或再次刷新后，旧请求的结果直接丢弃
+    if (requestId != pendingQueryId) return;
+    pendingQueryId = 0;
+
+    SocialSnapshotPtr snapshot = SocialManager::getInstance()->snapshot();
+    QVector<VideoPost> posts;
+    posts.reserve(postIds.size());
+    for (const QString& postId : postIds) {
+        const VideoPost* post = snapshot->findPost(postId);
+        if (post) {
+            posts.append(*post);
+        }
     }
 
+    showPosts(filter, posts);
+}
+
+void SocialFeedWidget::showPosts(SocialFilter filter, const QVector<VideoPost>& posts) {
+    clearPosts();
+
     if (posts.isEmpty()) {
         QString message;
-        if (currentFilter == FriendsPosts) {
+        if (filter == FriendsPosts) {
             message = tr("Your friends haven't posted any videos yet.\nAdd more friends!");
         } else {
             message = tr("No content available");
@@ -181,36 +256,61 @@ void SocialFeedWidget::loadPosts() {
 
     emptyStateLabel->hide();
 
-    // 创建帖子卡片
+    // 创建帖子卡片（布局本身顶部对齐，不再追加 stretch）
     for (const VideoPost& post : posts) {
-        VideoPostCard* card = new VideoPostCard(post, contentWidget);
-
-        // 连接信号
-        connect(card, &VideoPostCard::playRequested,
-                this, &SocialFeedWidget::onPostPlayRequested);
-        connect(card, &VideoPostCard::likeToggled,
-                this, &SocialFeedWidget::onPostLikeToggled);
-        connect(card, &VideoPostCard::commentRequested,
-                this, &SocialFeedWidget::onPostCommentRequested);
-        connect(card, &VideoPostCard::shareRequested,
-                this, &SocialFeedWidget::onPostShareRequested);
-
-        contentLayout->addWidget(card, 0, Qt::AlignHCenter);
-        postCards.append(card);
+        appendCard(post);
     }
 
-    contentLayout->addStretch();
+    // 重建后保留当前的搜索过滤
+    applyPostFilter();
+    scheduleAutoplayUpdate();
+
+    qDebug() << "Loaded" << posts.size() << "posts for filter:" << filter;
+}
+
+void SocialFeedWidget::appendCard(const VideoPost& post) {
+    VideoPostCard* card = new VideoPostCard(post, contentWidget);
+
+    // 连接信号
+    connect(card, &VideoPostCard::playRequested,
+            this, &SocialFeedWidget::onPostPlayRequested);
+    connect(card, &VideoPostCard::likeToggled,
+            this, &SocialFeedWidget::onPostLikeToggled);
+    connect(card, &VideoPostCard::commentRequested,
+            this, &SocialFeedWidget::onPostCommentRequested);
+    connect(card, &VideoPostCard::shareRequested,
+            this, &SocialFeedWidget::onPostShareRequested);
+
+    contentLayout->addWidget(card, 0, Qt::AlignHCenter);
+    postCards.append(card);
+    cardPosts.append(post);
+}
+
+// 接近底部时提前请求下一页，内容不足一屏时也继续加载
+void SocialFeedWidget::onScrollPositionChanged() {
+    if (currentFilter != AllPosts || pendingQueryId != 0) return;
+
+    SocialManager* socialManager = SocialManager::getInstance();
+    if (!socialManager->hasMorePosts()) return;
 
-    qDebug() << "Loaded" << posts.size() << "posts for filter:" << currentFilter;
+    QScrollBar* scrollBar = scrollArea->verticalScrollBar();
+    int prefetchDistance = scrollArea->viewport()->height() * 3 / 2;
+    if (scrollBar->maximum() - scrollBar->value() <= prefetchDistance) {
+        socialManager->loadMorePosts();
+    }
 }
 
 void SocialFeedWidget::clearPosts() {
+    // 先收回播放器输出，再删除卡片
+    inlinePool->detachAll();
+
     // 删除所有帖子卡片
     for (VideoPostCard* card : postCards) {
         contentLayout->removeWidget(card);
         card->deleteLater();
     }
     postCards.clear();
+    cardPosts.clear();
 }
 
 void SocialFeedWidget::showEmptyState(const QString& message) {
@@ -218,6 +318,99 @@ void SocialFeedWidget::showEmptyState(const QString& message) {
     emptyStateLabel->show();
 }
 
+void SocialFeedWidget::applyPostFilter() {
+    if (postCards.isEmpty()) return;
+
+    contentWidget->setUpdatesEnabled(false);
+
+    int visibleCount = 0;
+    for (int i = 0; i < postCards.size(); i++) {
+        bool matches = !postFilter || postFilter(cardPosts.at(i));
+        // 只在状态变化时切换，避免无谓的布局失效
+        if (postCards.at(i)->isHidden() == matches) {
+            postCards.at(i)->setVisible(matches);
+        }
+        if (matches) visibleCount++;
+    }
+
+    if (visibleCount == 0) {
+        showEmptyState(tr("No posts match your search"));
+    } else {
+        emptyStateLabel->hide();
+    }
+
+    contentWidget->setUpdatesEnabled(true);
+    scheduleAutoplayUpdate();
+}
+
+void SocialFeedWidget::scheduleAutoplayUpdate() {
+    // 连续滚动时不断重启计时器，快速滑过的卡片不会打开解码器
+    if (inlinePool->getCapacity() > 0) {
+        autoplayTimer->start();
+    }
+}
+
+double SocialFeedWidget::visibleFraction(VideoPostCard* card) const {
+    QWidget* host = card->inlineVideoHost();
+    if (card->isHidden() || host->height() <= 0) return 0.0;
+
+    QWidget* viewport = scrollArea->viewport();
+    QRect hostRect(host->mapTo(viewport, QPoint(0, 0)), host->size());
+    QRect visible = hostRect.intersected(viewport->rect());
+    if (visible.isEmpty()) return 0.0;
+
+    return double(visible.width()) * visible.height() /
+           (double(hostRect.width()) * hostRect.height());
+}
+
+void SocialFeedWidget::updateAutoplay() {
+    if (!isVisible() || !windowWatcher->isPresented()) {
+        inlinePool->detachAll();
+        return;
+    }
+
+    // 按可见比例排序，最靠前的几张卡片获得播放器
+    QVector<QPair<double, VideoPostCard*>> candidates;
+    for (VideoPostCard* card : postCards) {
+        double fraction = visibleFraction(card);
+        if (fraction >= AutoplayVisibleFraction) {
+            candidates.append(qMakePair(fraction, card));
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const QPair<double, VideoPostCard*>& a, const QPair<double, VideoPostCard*>& b) {
+                         return a.first > b.first;
+                     });
+
+    QVector<VideoPostCard*> wanted;
+    for (const auto& candidate : candidates) {
+        wanted.append(candidate.second);
+    }
+    inlinePool->assign(wanted);
+}
+
+void SocialFeedWidget::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    scheduleAutoplayUpdate();
+}
+
+void SocialFeedWidget::hideEvent(QHideEvent* event) {
+    QWidget::hideEvent(event);
+    // 切到其他页面时立即释放所有解码器
+    autoplayTimer->stop();
+    inlinePool->detachAll();
+}
+
+void SocialFeedWidget::setPostFilter(const PostPredicate& predicate) {
+    postFilter = predicate;
+    applyPostFilter();
+}
+
+void SocialFeedWidget::clearPostFilter() {
+    postFilter = PostPredicate();
+    applyPostFilter();
+}
+
 void SocialFeedWidget::setFilter(SocialFilter filter) {
     if (currentFilter != filter) {
         currentFilter = filter;
@@ -302,3 +495,73 @@ void SocialFeedWidget::onShareConfirmed(const QString& postId, const QString& pl
     // 这里可以添加实际的分享逻辑
     // 例如：记录分享次数，发送到服务器等
 }
+
+void SocialFeedWidget::onPostsChanged(const SocialChangeSet& changes) {
+    SocialManager* socialManager = SocialManager::getInstance();
+
+    // 好友列表变化后好友页的内容整体变了，重新查询
+    if (changes.friendsChanged && currentFilter == FriendsPosts) {
+        loadPosts();
+        return;
+    }
+
+    // 分页追加的帖子直接接在末尾；其他增删整体重建一次
+    if (changes.hasStructuralChanges()) {
+        bool appendOnly = currentFilter == AllPosts && pendingQueryId == 0 &&
+                          changes.deletedPostIds.isEmpty();
+
+        SocialSnapshotPtr snapshot = socialManager->snapshot();
+        for (const VideoPost& post : changes.addedPosts) {
+            if (!appendOnly) break;
+            appendOnly = snapshot->indexById.value(post.postId, -1) >= cardPosts.size();
+        }
+
+        if (!appendOnly) {
+            loadPosts();
+            return;
+        }
+
+        contentWidget->setUpdatesEnabled(false);
+        emptyStateLabel->hide();
+        for (const VideoPost& post : changes.addedPosts) {
+            const VideoPost* current = snapshot->findPost(post.postId);
+            if (current) {
+                appendCard(*current);
+            }
+        }
+        applyPostFilter();
+        contentWidget->setUpdatesEnabled(true);
+    }
+
+    contentWidget->setUpdatesEnabled(false);
+
+    for (int i = 0; i < postCards.size(); i++) {
+        if (!changes.updatedPostIds.contains(cardPosts.at(i).postId)) continue;
+
+        VideoPost post = socialManager->getPost(cardPosts.at(i).postId);
+        if (post.postId.isEmpty()) continue;
+
+        cardPosts[i] = post;
+        postCards.at(i)->setPost(post);
+    }
+
+    contentWidget->setUpdatesEnabled(true);
+}
+
+void SocialFeedWidget::updateSyncStatus() {
+    // 拒绝提示显示期间不覆盖
+    if (syncNoticeTimer->isActive()) return;
+
+    int count = MutationQueue::getInstance()->pendingCount();
+    syncStatusLabel->setText(tr("%n change(s) waiting to sync", "", count));
+    syncStatusLabel->setVisible(count > 0);
+}
+
+void SocialFeedWidget::onMutationRejected(const QString& postId, const QString& type) {
+    Q_UNUSED(postId);
+
+    syncStatusLabel->setText(type == "comment" ? tr("Comment was not accepted and has been removed")
+                                               : tr("Like was not accepted and has been undone"));
+    syncStatusLabel->show();
+    syncNoticeTimer->start();
+}
@@ -12,14 +12,23 @@
 #include <QPushButton>
 #include <QButtonGroup>
 #include <QLabel>
+#include <QTimer>
+#include <functional>
 #include "social_types.h"
 #include "video_post_card.h"
+#include "social_manager.h"
 
 class ShareDialog;
+class InlinePlaybackPool;
+class WindowVisibilityWatcher;
 
 class SocialFeedWidget : public QWidget {
     Q_OBJECT
 
+public:
+    // 搜索过滤谓词：返回 true 的帖子保持显示
+    typedef std::function<bool(const VideoPost&)> PostPredicate;
+
 private:
     // 过滤标签页
     QButtonGroup* filterButtonGroup;
@@ -34,24 +43,51 @@ private:
 
     // 当前过滤类型
     SocialFilter currentFilter;
+    quint64 pendingQueryId;   // 最近一次后台查询，旧结果到达时忽略
 
-    // 帖子卡片列表
+    // 帖子卡片列表（cardPosts 与 postCards 一一对应）
     QVector<VideoPostCard*> postCards;
+    QVector<VideoPost> cardPosts;
+
+    // 当前搜索过滤，为空表示不过滤
+    PostPredicate postFilter;
+
+    // 内联自动播放：滚动停下后才重新分配播放器
+    InlinePlaybackPool* inlinePool;
+    QTimer* autoplayTimer;
+    WindowVisibilityWatcher* windowWatcher;   // 窗口最小化/被遮挡时停止预览
 
     // 空状态
     QLabel* emptyStateLabel;
 
+    // 离线队列状态：待上传数，服务端拒绝时短暂显示提示
+    QLabel* syncStatusLabel;
+    QTimer* syncNoticeTimer;
+
     void setupUI();
     void connectSignals();
     void applyStyles();
     void loadPosts();
+    void showPosts(SocialFilter filter, const QVector<VideoPost>& posts);
+    void appendCard(const VideoPost& post);
     void clearPosts();
     void showEmptyState(const QString& message);
+    void applyPostFilter();
+    void scheduleAutoplayUpdate();
+    double visibleFraction(VideoPostCard* card) const;
+
+protected:
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
 
 public:
     explicit SocialFeedWidget(QWidget* parent = nullptr);
 
     void setFilter(SocialFilter filter);
+
+    // 只切换已有卡片的显示/隐藏，不重建控件
+    void setPostFilter(const PostPredicate& predicate);
+    void clearPostFilter();
     void refreshFeed();
     void updateTheme();
 
@@ -62,6 +98,12 @@ private slots:
     void onPostCommentRequested(const QString& postId);
     void onPostShareRequested(const QString& postId);
     void onShareConfirmed(const QString& postId, const QString& platform, const QString& comment);
+    void onPostsChanged(const SocialChangeSet& changes);
+    void onScrollPositionChanged();
+    void onPostsQueried(quint64 requestId, SocialFilter filter, const QVector<QString>& postIds);
+    void updateAutoplay();
+    void updateSyncStatus();
+    void onMutationRejected(const QString& postId, const QString& type);
 
 signals:
     void videoPlayRequested(const VideoPost& post);
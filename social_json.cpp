@@ -0,0 +1,131 @@
+//
+// SocialJson - 实现
+//
+
+#include "social_json.h"
+
+namespace SocialJson {
+
+QJsonObject userToJson(const UserInfo& user) {
+    QJsonObject object;
+    object["userId"] = user.userId;
+    object["username"] = user.username;
+    object["displayName"] = user.displayName;
+    object["bio"] = user.bio;
+    object["followersCount"] = user.followersCount;
+    object["followingCount"] = user.followingCount;
+    object["isFriend"] = user.isFriend;
+    return object;
+}
+
+UserInfo userFromJson(const QJsonObject& object) {
+    UserInfo user;
+    user.userId = object["userId"].toString();
+    user.username = object["username"].toString();
+    user.displayName = object["displayName"].toString();
+    user.bio = object["bio"].toString();
+    user.followersCount = object["followersCount"].toInt();
+    user.followingCount = object["followingCount"].toInt();
+    user.isFriend = object["isFriend"].toBool();
+    return user;
+}
+
+QJsonObject commentToJson(const Comment& comment) {
+    QJsonObject object;
+    object["commentId"] = comment.commentId;
+    object["author"] = userToJson(comment.author);
+    object["content"] = comment.content;
+    object["timestamp"] = comment.timestamp.toString(Qt::ISODateWithMs);
+    object["likesCount"] = comment.likesCount;
+    object["isLiked"] = comment.isLiked;
+    return object;
+}
+
+Comment commentFromJson(const QJsonObject& object) {
+    Comment comment;
+    comment.commentId = object["commentId"].toString();
+    comment.author = userFromJson(object["author"].toObject());
+    comment.content = object["content"].toString();
+    comment.timestamp = QDateTime::fromString(object["timestamp"].toString(), Qt::ISODateWithMs);
+    comment.likesCount = object["likesCount"].toInt();
+    comment.isLiked = object["isLiked"].toBool();
+    return comment;
+}
+
+QJsonObject postToJson(const VideoPost& post) {
+    QJsonObject object;
+    object["postId"] = post.postId;
+    object["author"] = userToJson(post.author);
+    object["videoUrl"] = post.videoUrl.toString();
+    object["caption"] = post.caption;
+    object["timestamp"] = post.timestamp.toString(Qt::ISODateWithMs);
+    object["likesCount"] = post.likesCount;
+    object["commentsCount"] = post.commentsCount;
+    object["viewsCount"] = post.viewsCount;
+    object["isLiked"] = post.isLiked;
+    object["isFrontCamera"] = post.isFrontCamera;
+    object["isBeRealMoment"] = post.isBeRealMoment;
+
+    QJsonArray tags;
+    for (const QString& tag : post.tags) {
+        tags.append(tag);
+    }
+    object["tags"] = tags;
+
+    QJsonArray comments;
+    for (const Comment& comment : post.comments) {
+        comments.append(commentToJson(comment));
+    }
+    object["comments"] = comments;
+    return object;
+}
+
+VideoPost postFromJson(const QJsonObject& object) {
+    VideoPost post;
+    post.postId = object["postId"].toString();
+    post.author = userFromJson(object["author"].toObject());
+    post.videoUrl = QUrl(object["videoUrl"].toString());
+    post.caption = object["caption"].toString();
+    post.timestamp = QDateTime::fromString(object["timestamp"].toString(), Qt::ISODateWithMs);
+    post.likesCount = object["likesCount"].toInt();
+    post.commentsCount = object["commentsCount"].toInt();
+    post.viewsCount = object["viewsCount"].toInt();
+    post.isLiked = object["isLiked"].toBool();
+    post.isFrontCamera = object["isFrontCamera"].toBool();
+    post.isBeRealMoment = object["isBeRealMoment"].toBool();
+
+    for (const QJsonValue& tag : object["tags"].toArray()) {
+        post.tags.append(tag.toString());
+    }
+    post.comments = commentsFromJson(object["comments"].toArray());
+    return post;
+}
+
+QVector<VideoPost> postsFromJson(const QJsonArray& array) {
+    QVector<VideoPost> posts;
+    posts.reserve(array.size());
+    for (const QJsonValue& value : array) {
+        posts.append(postFromJson(value.toObject()));
+    }
+    return posts;
+}
+
+QVector<Comment> commentsFromJson(const QJsonArray& array) {
+    QVector<Comment> comments;
+    comments.reserve(array.size());
+    for (const QJsonValue& value : array) {
+        comments.append(commentFromJson(value.toObject()));
+    }
+    return comments;
+}
+
+QVector<UserInfo> usersFromJson(const QJsonArray& array) {
+    QVector<UserInfo> users;
+    users.reserve(array.size());
+    for (const QJsonValue& value : array) {
+        users.append(userFromJson(value.toObject()));
+    }
+    return users;
+}
+
+}
@@ -0,0 +1,30 @@
+//
+// SocialJson - 社交数据与 JSON 的互相转换
+// Iteration 4: 供模拟社交服务和网络客户端共用（头像/缩略图等图片不参与序列化）
+//
+
+#ifndef SOCIAL_JSON_H
+#define SOCIAL_JSON_H
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include "social_types.h"
+
+namespace SocialJson {
+
+QJsonObject userToJson(const UserInfo& user);
+UserInfo userFromJson(const QJsonObject& object);
+
+QJsonObject commentToJson(const Comment& comment);
+Comment commentFromJson(const QJsonObject& object);
+
+QJsonObject postToJson(const VideoPost& post);
+VideoPost postFromJson(const QJsonObject& object);
+
+QVector<VideoPost> postsFromJson(const QJsonArray& array);
+QVector<Comment> commentsFromJson(const QJsonArray& array);
+QVector<UserInfo> usersFromJson(const QJsonArray& array);
+
+}
+
+#endif // SOCIAL_JSON_H
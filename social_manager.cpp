@@ -3,18 +3,39 @@
 //
 
 #include "social_manager.h"
+#include "startup_profiler.h"
 #include <QDebug>
 #include <QRandomGenerator>
 #include <QDir>
 #include <QFileInfo>
 #include <QImageReader>
+#include <QTimer>
+#include <QCoreApplication>
+#include <QMutexLocker>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 #include <algorithm>
 
 SocialManager* SocialManager::instance = nullptr;
 
+// 最后一次变更后多久写盘
+static const int SaveDelayMs = 2000;
+
 SocialManager::SocialManager(QObject* parent)
     : QObject(parent),
-    settings(nullptr) {
+    settings(nullptr),
+    workerThread(nullptr),
+    worker(nullptr),
+    lastQueryId(0),
+    saveTimer(nullptr),
+    snapshotDirty(true),
+    snapshotVersion(0),
+    postIndexDirty(true),
+    batchDepth(0),
+    flushScheduled(false),
+    dataSource(nullptr),
+    pendingPostsRequest(0),
+    morePostsAvailable(false) {
 
     settings = new QSettings("BeRealVideo", "Social", this);
 
@@ -27,26 +48,143 @@ SocialManager::SocialManager(QObject* parent)
     currentUser.followingCount = 189;
 
     // 生成模拟数据
-    generateMockData();
+    {
+        StartupPhase phase("SocialManager::generateMockData");
+        generateMockData();
+    }
+
+    qRegisterMetaType<SocialFilter>("SocialFilter");
+    qRegisterMetaType<QVector<QString>>("QVector<QString>");
+    qRegisterMetaType<SocialSnapshotPtr>("SocialSnapshotPtr");
+
+    // 工作线程：结果以排队信号回到 GUI 线程
+    workerThread = new QThread(this);
+    workerThread->setObjectName("SocialWorker");
+    worker = new SocialWorker();
+    worker->moveToThread(workerThread);
+    connect(workerThread, &QThread::finished, worker, &QObject::deleteLater);
+    connect(worker, &SocialWorker::queryFinished, this, &SocialManager::postsQueried);
+    connect(worker, &SocialWorker::dataLoaded, this, &SocialManager::onDataLoaded);
+    workerThread->start();
+
+    saveTimer = new QTimer(this);
+    saveTimer->setSingleShot(true);
+    saveTimer->setInterval(SaveDelayMs);
+    connect(saveTimer, &QTimer::timeout, this, &SocialManager::saveData);
+
+    // 先写出最后的变更，再停工作线程（排队的保存会在线程退出前执行）
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+            saveTimer->stop();
+            if (!dataSource) {
+                saveData();
+            }
+            shutdownWorker();
+        });
+    }
+
+    publishSnapshot();
+    SocialSnapshotPtr initial = snapshot();
+    SocialWorker* w = worker;
+    QMetaObject::invokeMethod(worker, [w, initial]() {
+        w->rebuildRanking(initial);
+    }, Qt::QueuedConnection);
+
+    // 恢复上次保存的数据；结果回到事件循环时若已设置外部数据源会被忽略
+    loadData();
 
     qDebug() << "SocialManager initialized";
 }
 
 SocialManager* SocialManager::getInstance() {
+    static QMutex instanceMutex;
+    QMutexLocker locker(&instanceMutex);
     if (instance == nullptr) {
         instance = new SocialManager();
     }
     return instance;
 }
 
+void SocialManager::shutdownWorker() {
+    if (!workerThread || !workerThread->isRunning()) return;
+
+    // 排队中的保存等任务会先执行完
+    workerThread->quit();
+    workerThread->wait();
+}
+
+// 只在 GUI 线程调用；隐式共享使得发布只复制容器头，
+// 代价推迟到发布后第一次写 allPosts 时的分离（O(N)），发布频率因此限制为每轮事件循环最多一次
+void SocialManager::publishSnapshot() const {
+    indexOfPost(QString());  // 确保 postIndex 是最新的
+
+    SocialSnapshot* next = new SocialSnapshot();
+    next->version = ++snapshotVersion;
+    next->currentUser = currentUser;
+    next->posts = allPosts;
+    next->friends = friends;
+    next->indexById = postIndex;
+
+    QMutexLocker locker(&snapshotMutex);
+    currentSnapshot = SocialSnapshotPtr(next);
+    snapshotDirty = false;
+}
+
+SocialSnapshotPtr SocialManager::snapshot() const {
+    // GUI 线程总能读到自己刚写入的数据；其他线程读到最近一次发布的版本
+    if (QThread::currentThread() == thread() && snapshotDirty) {
+        publishSnapshot();
+    }
+
+    QMutexLocker locker(&snapshotMutex);
+    return currentSnapshot;
+}
+
+quint64 SocialManager::queryPosts(SocialFilter filter, int limit) {
+    quint64 requestId = ++lastQueryId;
+    SocialSnapshotPtr current = snapshot();
+    SocialWorker* w = worker;
+
+    QMetaObject::invokeMethod(worker, [w, requestId, filter, limit, current]() {
+        w->runQuery(requestId, filter, limit, current);
+    }, Qt::QueuedConnection);
+
+    return requestId;
+}
+
 // 🔥 新增：加载真实的视频缩略图
 void SocialManager::loadRealThumbnails(const QString& videoDir) {
     qDebug() << "Loading real thumbnails from:" << videoDir;
+    applyThumbnails(scanThumbnails(videoDir, allPosts.size()));
+}
+
+void SocialManager::loadRealThumbnailsAsync(const QString& videoDir) {
+    qDebug() << "Loading real thumbnails in background from:" << videoDir;
+
+    QFutureWatcher<QVector<ThumbnailResult>>* watcher =
+        new QFutureWatcher<QVector<ThumbnailResult>>(this);
+    // 分析模式下 trace 要等扫描阶段记录完才写出
+    StartupProfiler::beginBackgroundTask();
+    connect(watcher, &QFutureWatcher<QVector<ThumbnailResult>>::finished, this, [this, watcher]() {
+        applyThumbnails(watcher->result());
+        watcher->deleteLater();
+        emit thumbnailsLoaded();
+        StartupProfiler::endBackgroundTask();
+    });
+    watcher->setFuture(QtConcurrent::run(&SocialManager::scanThumbnails,
+                                         videoDir, allPosts.size()));
+}
+
+// 只做文件扫描和图片解码，不访问成员，可在工作线程运行
+QVector<SocialManager::ThumbnailResult> SocialManager::scanThumbnails(const QString& videoDir,
+                                                                       int maxCount) {
+    StartupPhase phase("SocialManager::scanThumbnails");
+    QVector<ThumbnailResult> results;
 
     QDir dir(videoDir);
     if (!dir.exists()) {
         qDebug() << "Video directory does not exist:" << videoDir;
-        return;
+        return results;
     }
 
     // 获取所有视频文件及其缩略图
@@ -56,29 +194,28 @@ void SocialManager::loadRealThumbnails(const QString& videoDir) {
 
     if (videoFiles.isEmpty()) {
         qDebug() << "No video files found in:" << videoDir;
-        return;
+        return results;
     }
 
     qDebug() << "Found" << videoFiles.size() << "video files";
 
     // 为每个帖子尝试加载对应的缩略图
-    int postIndex = 0;
     for (const QFileInfo& videoFile : videoFiles) {
-        if (postIndex >= allPosts.size()) {
+        if (results.size() >= maxCount) {
             break;  // 已经有足够的帖子了
         }
 
+        ThumbnailResult result;
         QString thumbnailPath = videoFile.absolutePath() + "/" +
                                 videoFile.completeBaseName() + ".png";
 
         if (QFile::exists(thumbnailPath)) {
+            // 只读文件头确认可解码；像素由卡片按显示尺寸在 ImageDecodePool 中解码
             QImageReader imageReader(thumbnailPath);
-            QImage image = imageReader.read();
 
-            if (!image.isNull()) {
-                allPosts[postIndex].thumbnail = QPixmap::fromImage(image);
-                allPosts[postIndex].videoUrl = QUrl::fromLocalFile(videoFile.absoluteFilePath());
-                qDebug() << "Loaded thumbnail for post" << postIndex << ":" << thumbnailPath;
+            if (imageReader.canRead()) {
+                result.thumbnailPath = thumbnailPath;
+                result.videoUrl = QUrl::fromLocalFile(videoFile.absoluteFilePath());
             } else {
                 qDebug() << "Failed to load thumbnail:" << thumbnailPath;
             }
@@ -86,9 +223,29 @@ void SocialManager::loadRealThumbnails(const QString& videoDir) {
             qDebug() << "Thumbnail not found:" << thumbnailPath;
         }
 
+        results.append(result);
+    }
+
+    return results;
+}
+
+void SocialManager::applyThumbnails(const QVector<ThumbnailResult>& results) {
+    int postIndex = 0;
+    for (const ThumbnailResult& result : results) {
+        if (postIndex >= allPosts.size()) {
+            break;
+        }
+
+        if (!result.thumbnailPath.isEmpty()) {
+            allPosts[postIndex].thumbnailPath = result.thumbnailPath;
+            allPosts[postIndex].videoUrl = result.videoUrl;
+            qDebug() << "Loaded thumbnail for post" << postIndex << ":" << result.videoUrl.fileName();
+        }
+
         postIndex++;
     }
 
+    markSnapshotDirty();
     qDebug() << "Loaded thumbnails for" << postIndex << "posts";
 }
 
@@ -153,8 +310,17 @@ void SocialManager::generateMockData() {
     qDebug() << "Generated" << allPosts.size() << "mock posts";
 }
 
+UserInfo SocialManager::getCurrentUser() const {
+    return snapshot()->currentUser;
+}
+
+QVector<UserInfo> SocialManager::getFriends() const {
+    return snapshot()->friends;
+}
+
 void SocialManager::setCurrentUser(const UserInfo& user) {
     currentUser = user;
+    markSnapshotDirty();
     qDebug() << "Current user set to:" << user.username;
 }
 
@@ -170,6 +336,7 @@ void SocialManager::addFriend(const UserInfo& user) {
 
     if (!alreadyExists) {
         friends.append(user);
+        markFriendsChanged();
         emit friendAdded(user);
         qDebug() << "Friend added:" << user.username;
     }
@@ -179,6 +346,7 @@ void SocialManager::removeFriend(const QString& userId) {
     for (int i = 0; i < friends.size(); i++) {
         if (friends[i].userId == userId) {
             friends.removeAt(i);
+            markFriendsChanged();
             emit friendRemoved(userId);
             qDebug() << "Friend removed:" << userId;
             break;
@@ -187,44 +355,307 @@ void SocialManager::removeFriend(const QString& userId) {
 }
 
 QVector<VideoPost> SocialManager::getAllPosts() const {
-    return allPosts;
+    return snapshot()->posts;
 }
 
-QVector<VideoPost> SocialManager::getHotPosts() const {
-    // 按点赞数排序返回热门帖子
-    QVector<VideoPost> hotPosts = allPosts;
-    std::sort(hotPosts.begin(), hotPosts.end(),
-              [](const VideoPost& a, const VideoPost& b) {
-                  return a.likesCount > b.likesCount;
-              });
+QVector<VideoPost> SocialManager::getHotPosts(int limit) const {
+    // 排序由工作线程维护，这里只取前 limit 个；可能比刚发生的互动晚一轮事件循环
+    SocialSnapshotPtr current = snapshot();
+    QVector<VideoPost> hotPosts;
+    for (const QString& postId : worker->hotPostIds(limit)) {
+        const VideoPost* post = current->findPost(postId);
+        if (post) {
+            hotPosts.append(*post);
+        }
+    }
     return hotPosts;
 }
 
+int SocialManager::indexOfPost(const QString& postId) const {
+    if (postIndexDirty) {
+        postIndex.clear();
+        postIndex.reserve(allPosts.size());
+        for (int i = 0; i < allPosts.size(); i++) {
+            postIndex.insert(allPosts.at(i).postId, i);
+        }
+        postIndexDirty = false;
+    }
+    return postIndex.value(postId, -1);
+}
+
+void SocialManager::beginBatch() {
+    batchDepth++;
+}
+
+void SocialManager::endBatch() {
+    if (batchDepth == 0) return;
+
+    batchDepth--;
+    if (batchDepth == 0) {
+        scheduleFlush();
+    }
+}
+
+void SocialManager::markPostUpdated(const QString& postId) {
+    markSnapshotDirty();
+    pendingChanges.updatedPostIds.insert(postId);
+    scheduleFlush();
+}
+
+void SocialManager::markFriendsChanged() {
+    markSnapshotDirty();
+    pendingChanges.friendsChanged = true;
+    scheduleFlush();
+}
+
+// 同一轮事件循环内的多次变更只排队一次
+void SocialManager::scheduleFlush() {
+    if (batchDepth > 0 || flushScheduled || pendingChanges.isEmpty()) return;
+
+    flushScheduled = true;
+    QTimer::singleShot(0, this, &SocialManager::flushChanges);
+}
+
+void SocialManager::flushChanges() {
+    flushScheduled = false;
+
+    // 定时器触发时又开启了新的批次，等批次结束再发
+    if (batchDepth > 0 || pendingChanges.isEmpty()) return;
+
+    SocialChangeSet changes = pendingChanges;
+    pendingChanges = SocialChangeSet();
+
+    qDebug() << "Social changes:" << changes.addedPosts.size() << "added,"
+             << changes.deletedPostIds.size() << "deleted,"
+             << changes.updatedPostIds.size() << "updated"
+             << (changes.friendsChanged ? "(friends changed)" : "");
+
+    // 先发布快照再通知，监听者读取到的数据与变更集一致
+    publishSnapshot();
+    SocialSnapshotPtr current = snapshot();
+    SocialWorker* w = worker;
+    QMetaObject::invokeMethod(worker, [w, current, changes]() {
+        w->applyChanges(current, changes);
+    }, Qt::QueuedConnection);
+
+    // 外部数据源是权威数据，本地只保存内置数据的修改
+    if (!dataSource) {
+        saveTimer->start();
+    }
+
+    emit postsChanged(changes);
+}
+
+void SocialManager::setDataSource(SocialDataSource* source) {
+    if (!source || source == dataSource) return;
+
+    if (dataSource) {
+        dataSource->deleteLater();
+    }
+    dataSource = source;
+    dataSource->setParent(this);
+    saveTimer->stop();
+
+    connect(dataSource, &SocialDataSource::postsFetched, this, &SocialManager::onPostsFetched);
+    connect(dataSource, &SocialDataSource::commentsFetched, this, &SocialManager::onCommentsFetched);
+    connect(dataSource, &SocialDataSource::friendsFetched, this, &SocialManager::onFriendsFetched);
+    connect(dataSource, &SocialDataSource::requestFailed, this, &SocialManager::onSourceRequestFailed);
+
+    // 丢弃内置数据：postDeleted 让搜索索引摘掉旧帖子，其他监听者通过变更集得知
+    friends.clear();
+    markFriendsChanged();
+    replaceAllPosts(QVector<VideoPost>());
+
+    qDebug() << "Social data source set to:" << dataSource->name();
+    emit dataSourceChanged(dataSource);
+
+    nextPostsCursor.clear();
+    morePostsAvailable = true;
+    pendingPostsRequest = 0;
+    dataSource->fetchFriends();
+    loadMorePosts();
+}
+
+// 同一时间只有一个分页请求在途
+bool SocialManager::loadMorePosts() {
+    if (!dataSource || !morePostsAvailable || pendingPostsRequest != 0) return false;
+
+    pendingPostsRequest = dataSource->fetchPosts(nextPostsCursor, -1);
+    return true;
+}
+
+void SocialManager::refreshComments(const QString& postId) {
+    if (dataSource) {
+        dataSource->fetchComments(postId);
+    }
+}
+
+void SocialManager::reconcilePost(const QString& postId, int likesCount,
+                                  int commentsCount, bool isLiked) {
+    int index = indexOfPost(postId);
+    if (index < 0) return;
+
+    VideoPost& post = allPosts[index];
+    if (post.likesCount == likesCount && post.commentsCount == commentsCount &&
+        post.isLiked == isLiked) {
+        return;
+    }
+
+    qDebug() << "Reconciled post" << postId << "likes" << post.likesCount << "->" << likesCount
+             << "comments" << post.commentsCount << "->" << commentsCount;
+    post.likesCount = likesCount;
+    post.commentsCount = commentsCount;
+    post.isLiked = isLiked;
+    markPostUpdated(postId);
+}
+
+void SocialManager::mergeFetchedPosts(const QVector<VideoPost>& posts) {
+    indexOfPost(QString());  // 确保 postIndex 是最新的
+
+    for (const VideoPost& post : posts) {
+        if (postIndex.contains(post.postId)) continue;
+
+        postIndex.insert(post.postId, allPosts.size());
+        allPosts.append(post);
+        pendingChanges.addedPosts.append(post);
+        emit postAdded(post);
+    }
+
+    markSnapshotDirty();
+    scheduleFlush();
+}
+
+void SocialManager::replaceAllPosts(const QVector<VideoPost>& posts) {
+    indexOfPost(QString());  // 确保 postIndex 是最新的
+
+    QSet<QString> keptIds;
+    for (const VideoPost& post : posts) {
+        keptIds.insert(post.postId);
+    }
+    QHash<QString, int> previousIndex = postIndex;
+
+    for (const VideoPost& post : allPosts) {
+        if (keptIds.contains(post.postId)) continue;
+        pendingChanges.updatedPostIds.remove(post.postId);
+        pendingChanges.deletedPostIds.insert(post.postId);
+        emit postDeleted(post.postId);
+    }
+
+    allPosts = posts;
+    postIndexDirty = true;
+    markSnapshotDirty();
+
+    // 仍然存在的帖子按更新处理，监听者原地刷新卡片，搜索索引按新内容重建
+    for (const VideoPost& post : posts) {
+        if (previousIndex.contains(post.postId)) {
+            pendingChanges.updatedPostIds.insert(post.postId);
+            emit postReplaced(post);
+        } else {
+            pendingChanges.deletedPostIds.remove(post.postId);
+            pendingChanges.addedPosts.append(post);
+            emit postAdded(post);
+        }
+    }
+    scheduleFlush();
+}
+
+void SocialManager::onPostsFetched(quint64 requestId, const SocialPostPage& page) {
+    if (requestId != pendingPostsRequest) return;
+    pendingPostsRequest = 0;
+
+    nextPostsCursor = page.nextCursor;
+    morePostsAvailable = !page.nextCursor.isEmpty();
+    mergeFetchedPosts(page.posts);
+
+    qDebug() << "Fetched" << page.posts.size() << "posts from" << dataSource->name()
+             << (morePostsAvailable ? "(more available)" : "(end of feed)");
+}
+
+void SocialManager::onCommentsFetched(quint64 requestId, const QString& postId,
+                                      const QVector<Comment>& comments) {
+    Q_UNUSED(requestId);
+
+    int index = indexOfPost(postId);
+    if (index < 0) return;
+
+    allPosts[index].comments = comments;
+    allPosts[index].commentsCount = comments.size();
+    markPostUpdated(postId);
+    emit postReplaced(allPosts.at(index));
+}
+
+void SocialManager::onFriendsFetched(quint64 requestId, const QVector<UserInfo>& fetchedFriends) {
+    Q_UNUSED(requestId);
+
+    friends = fetchedFriends;
+    markFriendsChanged();
+    qDebug() << "Fetched" << friends.size() << "friends from" << dataSource->name();
+}
+
+void SocialManager::onSourceRequestFailed(quint64 requestId, const QString& error) {
+    // 分页请求失败时允许再次调用 loadMorePosts 重试
+    if (requestId == pendingPostsRequest) {
+        pendingPostsRequest = 0;
+    }
+
+    qDebug() << "Social data source request" << requestId << "failed:" << error;
+    emit dataSourceError(error);
+}
+
+void SocialManager::onDataLoaded(const SocialSnapshotPtr& loaded) {
+    // 外部数据源是权威数据，本地保存的副本只在离线（内置数据）时使用
+    if (dataSource) {
+        qDebug() << "Ignoring saved social data: data source" << dataSource->name() << "is active";
+        return;
+    }
+
+    SocialBatch batch(this);
+    currentUser = loaded->currentUser;
+    friends = loaded->friends;
+    markFriendsChanged();
+    replaceAllPosts(loaded->posts);
+    qDebug() << "Restored" << allPosts.size() << "posts and" << friends.size() << "friends";
+}
+
+void SocialManager::setHotRankingPolicy(RankingPolicy* policy) {
+    if (!policy) return;
+
+    qDebug() << "Hot ranking policy set to:" << policy->name();
+    SocialSnapshotPtr current = snapshot();
+    SocialWorker* w = worker;
+    QMetaObject::invokeMethod(worker, [w, policy, current]() {
+        w->setRankingPolicy(policy, current);
+    }, Qt::QueuedConnection);
+}
+
 QVector<VideoPost> SocialManager::getFriendsPosts() const {
     // 只返回好友的帖子
+    SocialSnapshotPtr current = snapshot();
+    QSet<QString> friendIds;
+    for (const UserInfo& friendUser : current->friends) {
+        friendIds.insert(friendUser.userId);
+    }
+
     QVector<VideoPost> friendsPosts;
-    for (const VideoPost& post : allPosts) {
-        for (const UserInfo& friendUser : friends) {
-            if (post.author.userId == friendUser.userId) {
-                friendsPosts.append(post);
-                break;
-            }
+    for (const VideoPost& post : current->posts) {
+        if (friendIds.contains(post.author.userId)) {
+            friendsPosts.append(post);
         }
     }
     return friendsPosts;
 }
 
 VideoPost SocialManager::getPost(const QString& postId) const {
-    for (const VideoPost& post : allPosts) {
-        if (post.postId == postId) {
-            return post;
-        }
-    }
-    return VideoPost();
+    const VideoPost* post = snapshot()->findPost(postId);
+    return post ? *post : VideoPost();
 }
 
 void SocialManager::addPost(const VideoPost& post) {
     allPosts.prepend(post);  // 添加到开头
+    postIndexDirty = true;
+    markSnapshotDirty();
+    pendingChanges.addedPosts.append(post);
+    scheduleFlush();
     emit postAdded(post);
     qDebug() << "Post added:" << post.postId;
 }
@@ -233,6 +664,11 @@ void SocialManager::deletePost(const QString& postId) {
     for (int i = 0; i < allPosts.size(); i++) {
         if (allPosts[i].postId == postId) {
             allPosts.removeAt(i);
+            postIndexDirty = true;
+            markSnapshotDirty();
+            pendingChanges.updatedPostIds.remove(postId);
+            pendingChanges.deletedPostIds.insert(postId);
+            scheduleFlush();
             emit postDeleted(postId);
             qDebug() << "Post deleted:" << postId;
             break;
@@ -246,6 +682,7 @@ void SocialManager::likePost(const QString& postId) {
             if (!allPosts[i].isLiked) {
                 allPosts[i].isLiked = true;
                 allPosts[i].likesCount++;
+                markPostUpdated(postId);
                 emit postLiked(postId, true);
                 qDebug() << "Post liked:" << postId;
             }
@@ -260,6 +697,7 @@ void SocialManager::unlikePost(const QString& postId) {
             if (allPosts[i].isLiked) {
                 allPosts[i].isLiked = false;
                 allPosts[i].likesCount--;
+                markPostUpdated(postId);
                 emit postLiked(postId, false);
                 qDebug() << "Post unliked:" << postId;
             }
@@ -273,6 +711,7 @@ void SocialManager::addComment(const QString& postId, const Comment& comment) {
         if (allPosts[i].postId == postId) {
             allPosts[i].comments.append(comment);
             allPosts[i].commentsCount++;
+            markPostUpdated(postId);
             emit commentAdded(postId, comment);
             qDebug() << "Comment added to post:" << postId;
             break;
@@ -287,6 +726,7 @@ void SocialManager::deleteComment(const QString& postId, const QString& commentI
                 if (allPosts[i].comments[j].commentId == commentId) {
                     allPosts[i].comments.removeAt(j);
                     allPosts[i].commentsCount--;
+                    markPostUpdated(postId);
                     qDebug() << "Comment deleted:" << commentId;
                     break;
                 }
@@ -310,6 +750,7 @@ void SocialManager::likeComment(const QString& postId, const QString& commentId)
                         allPosts[i].comments[j].likesCount--;
                         qDebug() << "Comment unliked:" << commentId;
                     }
+                    markPostUpdated(postId);
                     break;
                 }
             }
@@ -324,11 +765,17 @@ void SocialManager::setReminderSettings(const DailyReminderSettings& settings) {
 }
 
 void SocialManager::saveData() {
-    // TODO: 实现数据持久化
-    qDebug() << "Saving social data...";
+    // 在工作线程写出当前快照，不阻塞 UI
+    SocialSnapshotPtr current = snapshot();
+    SocialWorker* w = worker;
+    QMetaObject::invokeMethod(worker, [w, current]() {
+        w->save(current);
+    }, Qt::QueuedConnection);
 }
 
 void SocialManager::loadData() {
-    // TODO: 实现数据加载
-    qDebug() << "Loading social data...";
+    SocialWorker* w = worker;
+    QMetaObject::invokeMethod(worker, [w]() {
+        w->load();
+    }, Qt::QueuedConnection);
 }
@@ -1,6 +1,8 @@
 //
 // SocialManager - 社交功能管理器（添加缩略图加载功能）
 // Iteration 3: 管理用户、帖子、评论等社交数据
+// Iteration 4: 写操作只在 GUI 线程进行；读取走不可变快照（任意线程安全），
+//              排序、查询和持久化在后台工作线程执行
 //
 
 #ifndef SOCIAL_MANAGER_H
@@ -9,7 +11,14 @@
 #include <QObject>
 #include <QVector>
 #include <QSettings>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QThread>
+#include <QTimer>
 #include "social_types.h"
+#include "social_worker.h"
+#include "social_data_source.h"
 
 class SocialManager : public QObject {
     Q_OBJECT
@@ -23,26 +32,81 @@ private:
     DailyReminderSettings reminderSettings; // 提醒设置
     QSettings* settings;
 
+    // 后台线程：热门排序、帖子查询、持久化
+    QThread* workerThread;
+    SocialWorker* worker;
+    quint64 lastQueryId;
+    QTimer* saveTimer;      // 变更后延迟保存，连续操作只写一次
+
+    // 读快照：写操作标记为脏，GUI 线程读取时或每轮事件循环结束时重新发布
+    mutable QMutex snapshotMutex;
+    mutable SocialSnapshotPtr currentSnapshot;
+    mutable bool snapshotDirty;
+    mutable quint64 snapshotVersion;
+    void publishSnapshot() const;
+    void markSnapshotDirty() { snapshotDirty = true; }
+    void shutdownWorker();
+
+    // postId -> allPosts 下标，增删帖子后惰性重建
+    mutable QHash<QString, int> postIndex;
+    mutable bool postIndexDirty;
+    int indexOfPost(const QString& postId) const;
+
+    // 批量变更：批内只累积，批结束后在下一轮事件循环发出一次 postsChanged
+    SocialChangeSet pendingChanges;
+    int batchDepth;
+    bool flushScheduled;
+    void markPostUpdated(const QString& postId);
+    void markFriendsChanged();
+    void scheduleFlush();
+    void flushChanges();
+
+    // 外部数据源（为空时使用内置模拟数据）
+    SocialDataSource* dataSource;
+    QString nextPostsCursor;
+    quint64 pendingPostsRequest;
+    bool morePostsAvailable;
+    void mergeFetchedPosts(const QVector<VideoPost>& posts);
+
+    // 整体替换帖子列表：按 postId 对比，分别记为新增、删除或更新并发出对应信号（用于初始化搜索索引等）
+    void replaceAllPosts(const QVector<VideoPost>& posts);
+
     explicit SocialManager(QObject* parent = nullptr);
     void generateMockData();  // 生成模拟数据
 
+    // 缩略图扫描结果（只记录文件路径，解码交给 ImageDecodePool）
+    struct ThumbnailResult {
+        QUrl videoUrl;
+        QString thumbnailPath;
+    };
+    static QVector<ThumbnailResult> scanThumbnails(const QString& videoDir, int maxCount);
+    void applyThumbnails(const QVector<ThumbnailResult>& results);
+
 public:
-    // 单例模式
+    // 单例模式（线程安全；首次调用必须在 GUI 线程）
     static SocialManager* getInstance();
 
+    // 当前数据的只读快照，可在任意线程调用
+    SocialSnapshotPtr snapshot() const;
+
+    // 在工作线程执行查询，结果通过 postsQueried 返回；返回请求编号
+    quint64 queryPosts(SocialFilter filter, int limit = -1);
+
     // 🔥 新增：加载真实视频缩略图
     void loadRealThumbnails(const QString& videoDir);
+    // 在后台线程扫描缩略图文件，完成后发出 thumbnailsLoaded
+    void loadRealThumbnailsAsync(const QString& videoDir);
 
     // 用户管理
-    UserInfo getCurrentUser() const { return currentUser; }
+    UserInfo getCurrentUser() const;
     void setCurrentUser(const UserInfo& user);
-    QVector<UserInfo> getFriends() const { return friends; }
+    QVector<UserInfo> getFriends() const;
     void addFriend(const UserInfo& user);
     void removeFriend(const QString& userId);
 
     // 帖子管理
     QVector<VideoPost> getAllPosts() const;
-    QVector<VideoPost> getHotPosts() const;
+    QVector<VideoPost> getHotPosts(int limit = -1) const;
     QVector<VideoPost> getFriendsPosts() const;
     VideoPost getPost(const QString& postId) const;
     void addPost(const VideoPost& post);
@@ -55,11 +119,31 @@ public:
     void deleteComment(const QString& postId, const QString& commentId);
     void likeComment(const QString& postId, const QString& commentId);
 
+    // 切换数据源（接管所有权）：清空内置数据并异步加载好友和第一页帖子
+    void setDataSource(SocialDataSource* source);
+    SocialDataSource* getDataSource() const { return dataSource; }
+    bool loadMorePosts();
+    bool hasMorePosts() const { return morePostsAvailable; }
+    void refreshComments(const QString& postId);
+
+    // 以服务端返回的权威状态覆盖本地计数（变更队列对账用）
+    void reconcilePost(const QString& postId, int likesCount, int commentsCount, bool isLiked);
+
+    // 批量操作（可嵌套）；也可用 SocialBatch 自动配对
+    void beginBatch();
+    void endBatch();
+
+    // 替换热门排序策略（接管所有权）
+    void setHotRankingPolicy(RankingPolicy* policy);
+
     // 提醒设置
     DailyReminderSettings getReminderSettings() const { return reminderSettings; }
     void setReminderSettings(const DailyReminderSettings& settings);
 
-    // 数据持久化
+    // 数据持久化：在工作线程读写 AppDataLocation/social_data.json；
+    // 加载完成后替换当前数据（已设置外部数据源时忽略）。
+    // 启动时自动加载，变更后延迟保存，退出前再保存一次；使用外部数据源时不保存
+
     void saveData();
     void loadData();
 
@@ -68,8 +152,37 @@ signals:
     void postDeleted(const QString& postId);
     void postLiked(const QString& postId, bool isLiked);
     void commentAdded(const QString& postId, const Comment& comment);
+    // 帖子内容被整体替换（如重新拉取评论），需要按新内容重建的监听者用它
+    void postReplaced(const VideoPost& post);
     void friendAdded(const UserInfo& user);
     void friendRemoved(const QString& userId);
+    void thumbnailsLoaded();
+
+    // 合并后的变更集，每轮事件循环最多一次
+    void postsChanged(const SocialChangeSet& changes);
+
+    void dataSourceError(const QString& error);
+    void dataSourceChanged(SocialDataSource* source);
+
+    // queryPosts 的结果（postId 列表，按查询顺序）
+    void postsQueried(quint64 requestId, SocialFilter filter, const QVector<QString>& postIds);
+
+private slots:
+    void onPostsFetched(quint64 requestId, const SocialPostPage& page);
+    void onCommentsFetched(quint64 requestId, const QString& postId, const QVector<Comment>& comments);
+    void onFriendsFetched(quint64 requestId, const QVector<UserInfo>& fetchedFriends);
+    void onSourceRequestFailed(quint64 requestId, const QString& error);
+    void onDataLoaded(const SocialSnapshotPtr& loaded);
+};
+
+// RAII：作用域内的变更合并为一次通知
+class SocialBatch {
+private:
+    SocialManager* manager;
+
+public:
+    explicit SocialBatch(SocialManager* m) : manager(m) { manager->beginBatch(); }
+    ~SocialBatch() { manager->endBatch(); }
 };
 
 #endif // SOCIAL_MANAGER_H
@@ -11,13 +11,15 @@
 #include <QPixmap>
 #include <QVector>
 #include <QUrl>
+#include <QHash>
+#include <QSet>
+#include <QMetaType>
 
 // 用户信息
 struct UserInfo {
     QString userId;           // 用户ID
     QString username;         // 用户名
     QString displayName;      // 显示名称
-    QPixmap avatar;          // 头像
     QString bio;             // 个人简介
     int followersCount;      // 粉丝数
     int followingCount;      // 关注数
@@ -57,7 +59,7 @@ struct VideoPost {
     QString postId;              // 帖子ID
     UserInfo author;             // 作者信息
     QUrl videoUrl;              // 视频URL
-    QPixmap thumbnail;          // 缩略图
+    QString thumbnailPath;      // 缩略图文件，由 ImageDecodePool 按显示尺寸解码（帖子本身不持有图片，可跨线程复制）
     QString caption;            // 标题/描述
     QDateTime timestamp;        // 发布时间
     int likesCount;             // 点赞数
@@ -114,4 +116,42 @@ struct DailyReminderSettings {
         vibrationEnabled(true) {}
 };
 
+// 一轮事件循环内累积的帖子变更，合并成一次通知
+struct SocialChangeSet {
+    QVector<VideoPost> addedPosts;
+    QSet<QString> deletedPostIds;
+    QSet<QString> updatedPostIds;   // 点赞/评论等互动变化
+    bool friendsChanged;            // 好友列表变化，影响好友过滤的结果
+
+    SocialChangeSet() : friendsChanged(false) {}
+
+    bool isEmpty() const {
+        return addedPosts.isEmpty() && deletedPostIds.isEmpty() && updatedPostIds.isEmpty() &&
+               !friendsChanged;
+    }
+    bool hasStructuralChanges() const {
+        return !addedPosts.isEmpty() || !deletedPostIds.isEmpty();
+    }
+};
+
+// 社交数据的只读快照：发布后不再修改，可在任意线程读取
+// 容器都是隐式共享的，发布本身只复制容器头；但发布后 GUI 线程第一次写帖子时
+// allPosts 会分离，逐个复制 N 个帖子（帖子内的字符串等仍只增加引用计数），即每次发布后一次 O(N)
+struct SocialSnapshot {
+    quint64 version;
+    UserInfo currentUser;
+    QVector<VideoPost> posts;
+    QVector<UserInfo> friends;
+    QHash<QString, int> indexById;   // postId -> posts 下标
+
+    SocialSnapshot() : version(0) {}
+
+    const VideoPost* findPost(const QString& postId) const {
+        auto it = indexById.constFind(postId);
+        return it != indexById.constEnd() ? &posts.at(it.value()) : nullptr;
+    }
+};
+
+Q_DECLARE_METATYPE(SocialFilter)
+
 #endif // SOCIAL_TYPES_H
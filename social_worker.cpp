@@ -0,0 +1,165 @@
+//
+// SocialWorker - 实现
+//
+
+#include "social_worker.h"
+#include "social_json.h"
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QSet>
+#include <QStandardPaths>
+
+SocialWorker::SocialWorker(QObject* parent)
+    : QObject(parent) {
+    storagePath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) +
+                  "/social_data.json";
+}
+
+void SocialWorker::rebuildRanking(const SocialSnapshotPtr& snapshot) {
+    QMutexLocker locker(&rankingMutex);
+    ranking.rebuild(snapshot->posts);
+}
+
+// 只更新变化的帖子，每个 O(log N)
+void SocialWorker::applyChanges(const SocialSnapshotPtr& snapshot, const SocialChangeSet& changes) {
+    QMutexLocker locker(&rankingMutex);
+
+    for (const VideoPost& post : changes.addedPosts) {
+        if (!changes.deletedPostIds.contains(post.postId)) {
+            ranking.update(post);
+        }
+    }
+    for (const QString& postId : changes.deletedPostIds) {
+        ranking.remove(postId);
+    }
+    for (const QString& postId : changes.updatedPostIds) {
+        const VideoPost* post = snapshot->findPost(postId);
+        if (post) {
+            ranking.update(*post);
+        }
+    }
+}
+
+void SocialWorker::setRankingPolicy(RankingPolicy* policy, const SocialSnapshotPtr& snapshot) {
+    QMutexLocker locker(&rankingMutex);
+    ranking.setPolicy(policy, snapshot->posts);
+}
+
+void SocialWorker::runQuery(quint64 requestId, SocialFilter filter, int limit,
+                            const SocialSnapshotPtr& snapshot) {
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<QString> postIds;
+
+    switch (filter) {
+    case AllPosts:
+        for (const VideoPost& post : snapshot->posts) {
+            if (limit >= 0 && postIds.size() >= limit) break;
+            postIds.append(post.postId);
+        }
+        break;
+    case HotPosts:
+        postIds = hotPostIds(limit);
+        break;
+    case FriendsPosts: {
+        QSet<QString> friendIds;
+        for (const UserInfo& friendUser : snapshot->friends) {
+            friendIds.insert(friendUser.userId);
+        }
+        for (const VideoPost& post : snapshot->posts) {
+            if (limit >= 0 && postIds.size() >= limit) break;
+            if (friendIds.contains(post.author.userId)) {
+                postIds.append(post.postId);
+            }
+        }
+        break;
+    }
+    }
+
+    qDebug() << "Social query" << requestId << "filter" << filter << "->"
+             << postIds.size() << "posts in" << timer.nsecsElapsed() / 1000 << "us";
+    emit queryFinished(requestId, filter, postIds);
+}
+
+void SocialWorker::save(const SocialSnapshotPtr& snapshot) {
+    QElapsedTimer timer;
+    timer.start();
+
+    // 缩略图路径是本地数据，不属于 SocialJson 的网络格式，单独写入
+    QJsonArray posts;
+    for (const VideoPost& post : snapshot->posts) {
+        QJsonObject object = SocialJson::postToJson(post);
+        if (!post.thumbnailPath.isEmpty()) {
+            object["thumbnailPath"] = post.thumbnailPath;
+        }
+        posts.append(object);
+    }
+    QJsonArray friends;
+    for (const UserInfo& friendUser : snapshot->friends) {
+        friends.append(SocialJson::userToJson(friendUser));
+    }
+
+    QJsonObject root;
+    root["currentUser"] = SocialJson::userToJson(snapshot->currentUser);
+    root["posts"] = posts;
+    root["friends"] = friends;
+
+    // 先写临时文件再替换，避免中途退出留下半个文件
+    QDir().mkpath(QFileInfo(storagePath).absolutePath());
+    QString tempPath = storagePath + ".tmp";
+    QFile file(tempPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "SocialWorker: failed to write" << tempPath;
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.close();
+
+    QFile::remove(storagePath);
+    QFile::rename(tempPath, storagePath);
+    qDebug() << "Saved social data (snapshot" << snapshot->version << "," << posts.size()
+             << "posts) in" << timer.elapsed() << "ms";
+}
+
+void SocialWorker::load() {
+    QFile file(storagePath);
+    if (!file.open(QIODevice::ReadOnly)) return;
+
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+    if (error.error != QJsonParseError::NoError || !document.isObject()) {
+        qDebug() << "SocialWorker: ignoring unreadable" << storagePath << "-" << error.errorString();
+        return;
+    }
+
+    QJsonObject root = document.object();
+    SocialSnapshot* loaded = new SocialSnapshot();
+    loaded->currentUser = SocialJson::userFromJson(root["currentUser"].toObject());
+    loaded->friends = SocialJson::usersFromJson(root["friends"].toArray());
+
+    QJsonArray posts = root["posts"].toArray();
+    loaded->posts.reserve(posts.size());
+    for (const QJsonValue& value : posts) {
+        VideoPost post = SocialJson::postFromJson(value.toObject());
+        if (post.postId.isEmpty() || loaded->indexById.contains(post.postId)) continue;
+
+        post.thumbnailPath = value.toObject()["thumbnailPath"].toString();
+        loaded->indexById.insert(post.postId, loaded->posts.size());
+        loaded->posts.append(post);
+    }
+
+    qDebug() << "Loaded social data:" << loaded->posts.size() << "posts,"
+             << loaded->friends.size() << "friends";
+    emit dataLoaded(SocialSnapshotPtr(loaded));
+}
+
+QVector<QString> SocialWorker::hotPostIds(int limit) const {
+    QMutexLocker locker(&rankingMutex);
+    return ranking.topK(limit);
+}
@@ -0,0 +1,50 @@
+//
+// SocialWorker - 社交数据后台工作对象
+// Iteration 4: 在独立线程上维护热门排序、执行帖子查询和持久化，UI 线程只读快照
+//
+
+#ifndef SOCIAL_WORKER_H
+#define SOCIAL_WORKER_H
+
+#include <QObject>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+#include "social_types.h"
+#include "ranking_engine.h"
+
+typedef QSharedPointer<const SocialSnapshot> SocialSnapshotPtr;
+Q_DECLARE_METATYPE(SocialSnapshotPtr)
+
+// 快照不含图片，可以在工作线程读取和释放；
+// 查询结果以 postId 列表返回，由 UI 线程从快照取出帖子
+class SocialWorker : public QObject {
+    Q_OBJECT
+
+private:
+    mutable QMutex rankingMutex;   // 保护 ranking，供其他线程同步读取 Top-K
+    RankingEngine ranking;
+    QString storagePath;           // 持久化文件，AppDataLocation/social_data.json
+
+public:
+    explicit SocialWorker(QObject* parent = nullptr);
+
+    // 以下函数在工作线程中调用（通过排队调用投递）
+    void rebuildRanking(const SocialSnapshotPtr& snapshot);
+    void applyChanges(const SocialSnapshotPtr& snapshot, const SocialChangeSet& changes);
+    void setRankingPolicy(RankingPolicy* policy, const SocialSnapshotPtr& snapshot);
+    void runQuery(quint64 requestId, SocialFilter filter, int limit,
+                  const SocialSnapshotPtr& snapshot);
+    void save(const SocialSnapshotPtr& snapshot);
+    void load();        // 结果通过 dataLoaded 返回，文件不存在或损坏时不发出
+
+    // 任意线程可调用
+    QVector<QString> hotPostIds(int limit) const;
+
+signals:
+    void queryFinished(quint64 requestId, SocialFilter filter, const QVector<QString>& postIds);
+    void dataLoaded(const SocialSnapshotPtr& snapshot);
+};
+
+#endif // SOCIAL_WORKER_H
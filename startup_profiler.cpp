@@ -0,0 +1,248 @@
+//
+// StartupProfiler - 实现
+//
+
+#include "startup_profiler.h"
+#include <QApplication>
+#include <QAtomicInt>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+#include <cstring>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+const char* StartupProfiler::CommandLineFlag = "--profile-startup";
+const char* StartupProfiler::DefaultTracePath = "startup_trace.json";
+
+namespace {
+
+struct TraceEvent {
+    QString name;
+    qint64 wallStartUs;
+    qint64 wallDurUs;
+    qint64 cpuDurUs;
+    int tid;
+};
+
+bool profilingEnabled = false;
+QString tracePath;
+QElapsedTimer processTimer;
+QAtomicInt backgroundTasks(0);
+
+// 后台任务迟迟不结束时最多再等这么久，避免分析模式卡住
+const qint64 BackgroundWaitLimitMs = 30000;
+
+QMutex eventsMutex;
+QVector<TraceEvent> events;
+QHash<Qt::HANDLE, int> threadIds;
+
+// 将线程句柄映射为 trace 中的小整数，主线程为 1
+int traceThreadId() {
+    Qt::HANDLE handle = QThread::currentThreadId();
+    if (!threadIds.contains(handle)) {
+        threadIds.insert(handle, threadIds.size() + 1);
+    }
+    return threadIds.value(handle);
+}
+
+// 首次 Paint 事件后排队退出，保证首帧已经提交
+class FirstPaintWatcher : public QObject {
+private:
+    qint64 wallStart;
+    qint64 cpuStart;
+    bool seen;
+
+public:
+    explicit FirstPaintWatcher(QObject* parent)
+        : QObject(parent),
+        wallStart(StartupProfiler::wallMicros()),
+        cpuStart(StartupProfiler::cpuMicros()),
+        seen(false) {}
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override {
+        if (!seen && event->type() == QEvent::Paint) {
+            seen = true;
+            QTimer::singleShot(0, this, [this]() {
+                StartupProfiler::record("show -> first paint", wallStart,
+                                        StartupProfiler::wallMicros(), cpuStart,
+                                        StartupProfiler::cpuMicros());
+                waitTimer.start();
+                finishWhenIdle();
+            });
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+private:
+    QElapsedTimer waitTimer;
+
+    // 后台阶段在其他线程记录，全部结束后再写 trace
+    void finishWhenIdle() {
+        if (backgroundTasks.loadAcquire() > 0 && waitTimer.elapsed() < BackgroundWaitLimitMs) {
+            QTimer::singleShot(10, this, [this]() { finishWhenIdle(); });
+            return;
+        }
+        if (backgroundTasks.loadAcquire() > 0) {
+            qDebug() << "Startup trace: background tasks still running, writing partial trace";
+        }
+        StartupProfiler::writeTrace();
+        QApplication::quit();
+    }
+};
+
+}
+
+bool StartupProfiler::enableFromArguments(int argc, char* argv[]) {
+    size_t flagLength = std::strlen(CommandLineFlag);
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], CommandLineFlag, flagLength) != 0) continue;
+
+        const char* rest = argv[i] + flagLength;
+        if (*rest == '\0') {
+            tracePath = DefaultTracePath;
+        } else if (*rest == '=') {
+            tracePath = QString::fromLocal8Bit(rest + 1);
+        } else {
+            continue;
+        }
+
+        profilingEnabled = true;
+        processTimer.start();
+        return true;
+    }
+    return false;
+}
+
+bool StartupProfiler::isEnabled() {
+    return profilingEnabled;
+}
+
+qint64 StartupProfiler::wallMicros() {
+    return profilingEnabled ? processTimer.nsecsElapsed() / 1000 : 0;
+}
+
+// std::clock() 在 MSVC 上是墙钟、在 Linux 上是整个进程的 CPU，都不能用于单个阶段
+qint64 StartupProfiler::cpuMicros() {
+    if (!profilingEnabled) return 0;
+#if defined(Q_OS_WIN)
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) return 0;
+    ULARGE_INTEGER kernelTime, userTime;
+    kernelTime.LowPart = kernel.dwLowDateTime;
+    kernelTime.HighPart = kernel.dwHighDateTime;
+    userTime.LowPart = user.dwLowDateTime;
+    userTime.HighPart = user.dwHighDateTime;
+    // FILETIME 单位为 100 纳秒
+    return static_cast<qint64>((kernelTime.QuadPart + userTime.QuadPart) / 10);
+#else
+    timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0) return 0;
+    return static_cast<qint64>(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+#endif
+}
+
+void StartupProfiler::beginBackgroundTask() {
+    if (profilingEnabled) backgroundTasks.ref();
+}
+
+void StartupProfiler::endBackgroundTask() {
+    if (profilingEnabled) backgroundTasks.deref();
+}
+
+void StartupProfiler::record(const QString& name, qint64 wallStartUs, qint64 wallEndUs,
+                             qint64 cpuStartUs, qint64 cpuEndUs) {
+    if (!profilingEnabled) return;
+
+    QMutexLocker locker(&eventsMutex);
+    TraceEvent event;
+    event.name = name;
+    event.wallStartUs = wallStartUs;
+    event.wallDurUs = wallEndUs - wallStartUs;
+    event.cpuDurUs = cpuEndUs - cpuStartUs;
+    event.tid = traceThreadId();
+    events.append(event);
+}
+
+void StartupProfiler::finishAfterFirstPaint(QWidget* window) {
+    if (!profilingEnabled || !window) return;
+    window->installEventFilter(new FirstPaintWatcher(window));
+}
+
+bool StartupProfiler::writeTrace() {
+    if (!profilingEnabled) return false;
+
+    QJsonArray traceEvents;
+    {
+        QMutexLocker locker(&eventsMutex);
+        for (const TraceEvent& event : events) {
+            QJsonObject args;
+            args["cpu_ms"] = event.cpuDurUs / 1000.0;
+            args["wall_ms"] = event.wallDurUs / 1000.0;
+
+            QJsonObject object;
+            object["name"] = event.name;
+            object["cat"] = "startup";
+            object["ph"] = "X";
+            object["ts"] = static_cast<double>(event.wallStartUs);
+            object["dur"] = static_cast<double>(event.wallDurUs);
+            object["pid"] = 1;
+            object["tid"] = event.tid;
+            object["args"] = args;
+            traceEvents.append(object);
+
+            qDebug().noquote() << QString("[startup] %1: wall %2 ms, cpu %3 ms")
+                                      .arg(event.name, -32)
+                                      .arg(event.wallDurUs / 1000.0, 0, 'f', 2)
+                                      .arg(event.cpuDurUs / 1000.0, 0, 'f', 2);
+        }
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(tracePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "Failed to write startup trace:" << tracePath;
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+
+    qDebug() << "Startup trace written to:" << tracePath;
+    return true;
+}
+
+StartupPhase::StartupPhase(const QString& phaseName)
+    : name(phaseName),
+    wallStart(StartupProfiler::wallMicros()),
+    cpuStart(StartupProfiler::cpuMicros()),
+    active(StartupProfiler::isEnabled()) {
+}
+
+StartupPhase::~StartupPhase() {
+    finish();
+}
+
+void StartupPhase::finish() {
+    if (!active) return;
+
+    active = false;
+    StartupProfiler::record(name, wallStart, StartupProfiler::wallMicros(),
+                            cpuStart, StartupProfiler::cpuMicros());
+}
@@ -0,0 +1,54 @@
+//
+// StartupProfiler - 启动阶段性能分析
+// Iteration 4: --profile-startup 模式下记录各阶段的墙钟/CPU 时间，
+//              首帧绘制后写出 Chrome Trace 格式的 JSON 并退出
+//
+
+#ifndef STARTUP_PROFILER_H
+#define STARTUP_PROFILER_H
+
+#include <QString>
+#include <QWidget>
+
+class StartupProfiler {
+public:
+    static const char* CommandLineFlag;      // --profile-startup[=path]
+    static const char* DefaultTracePath;
+
+    // 解析命令行，返回是否启用（必须在 QApplication 之前调用）
+    static bool enableFromArguments(int argc, char* argv[]);
+    static bool isEnabled();
+
+    // 墙钟：自进程计时起点以来的时间；CPU：当前线程已用的 CPU 时间（只用于求差）
+    static qint64 wallMicros();
+    static qint64 cpuMicros();
+
+    // 启动期间的后台任务（如缩略图扫描）；写 trace 前等它们结束（线程安全）
+    static void beginBackgroundTask();
+    static void endBackgroundTask();
+
+    // 记录一个完整阶段（线程安全）
+    static void record(const QString& name, qint64 wallStartUs, qint64 wallEndUs,
+                       qint64 cpuStartUs, qint64 cpuEndUs);
+
+    // 窗口首次绘制完成后写出 trace 并退出应用
+    static void finishAfterFirstPaint(QWidget* window);
+    static bool writeTrace();
+};
+
+// RAII 计时：析构或调用 finish() 时记录阶段；未启用分析时不做任何事
+class StartupPhase {
+private:
+    QString name;
+    qint64 wallStart;
+    qint64 cpuStart;
+    bool active;
+
+public:
+    explicit StartupPhase(const QString& phaseName);
+    ~StartupPhase();
+
+    void finish();
+};
+
+#endif // STARTUP_PROFILER_H
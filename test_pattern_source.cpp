@@ -0,0 +1,110 @@
+//
+// TestPatternSource - 实现
+//
+
+#include "test_pattern_source.h"
+#include <QDebug>
+#include <QPainter>
+#include <utility>
+
+TestPatternSource::TestPatternSource(bool front, QObject* parent)
+    : FrameSource(parent),
+    frontFacing(front),
+    frameIndex(0) {
+
+    thread = new QThread(this);
+    thread->setObjectName(front ? "TestPatternFront" : "TestPatternBack");
+
+    timer = new QTimer();
+    timer->setTimerType(Qt::PreciseTimer);
+    timer->moveToThread(thread);
+    connect(timer, &QTimer::timeout, timer, [this]() { generateFrame(); });
+}
+
+TestPatternSource::~TestPatternSource() {
+    stop();
+    delete timer;
+}
+
+QString TestPatternSource::name() const {
+    return frontFacing ? "Test pattern (front)" : "Test pattern (back)";
+}
+
+bool TestPatternSource::start(const QSize& size, int framesPerSecond) {
+    if (thread->isRunning()) return true;
+
+    frameSize = size;
+    frameIndex = 0;
+    background = QImage();
+
+    thread->start();
+    int interval = 1000 / qMax(1, framesPerSecond);
+    QMetaObject::invokeMethod(timer, [this, interval]() {
+        clock.start();
+        timer->start(interval);
+    }, Qt::QueuedConnection);
+
+    qDebug() << "TestPatternSource started:" << name() << frameSize << framesPerSecond << "fps";
+    return true;
+}
+
+void TestPatternSource::stop() {
+    if (!thread->isRunning()) return;
+
+    QMetaObject::invokeMethod(timer, [this]() { timer->stop(); }, Qt::BlockingQueuedConnection);
+    thread->quit();
+    thread->wait();
+}
+
+// 前后两路用不同的色调区分，合成画中画时一眼能看出哪路在上面
+void TestPatternSource::renderBackground() {
+    static const QColor Bars[] = {
+        QColor(235, 235, 235), QColor(235, 235, 16), QColor(16, 235, 235), QColor(16, 235, 16),
+        QColor(235, 16, 235), QColor(235, 16, 16), QColor(16, 16, 235)
+    };
+    static const int BarCount = 7;
+
+    background = QImage(frameSize, QImage::Format_RGB32);
+    QPainter painter(&background);
+
+    int barWidth = (frameSize.width() + BarCount - 1) / BarCount;
+    for (int i = 0; i < BarCount; i++) {
+        QColor color = Bars[frontFacing ? i : BarCount - 1 - i];
+        painter.fillRect(i * barWidth, 0, barWidth, frameSize.height(), color);
+    }
+
+    // 底部灰阶，便于检查滤镜和曝光
+    int rampTop = frameSize.height() * 3 / 4;
+    for (int x = 0; x < frameSize.width(); x++) {
+        int level = x * 255 / qMax(1, frameSize.width() - 1);
+        painter.setPen(QColor(level, level, level));
+        painter.drawLine(x, rampTop, x, frameSize.height());
+    }
+}
+
+void TestPatternSource::generateFrame() {
+    if (frameSize.isEmpty()) return;
+    if (background.isNull()) renderBackground();
+
+    QImage frame = background.copy();
+    QPainter painter(&frame);
+
+    // 方块每 4 秒横穿一次画面，用来肉眼检查丢帧和卡顿
+    int box = frameSize.height() / 6;
+    qint64 elapsedMs = clock.elapsed();
+    int travel = qMax(1, frameSize.width() - box);
+    int x = int((elapsedMs % 4000) * travel / 4000);
+    painter.fillRect(x, (frameSize.height() - box) / 2, box, box, Qt::black);
+
+    QFont font = painter.font();
+    font.setPixelSize(qMax(12, frameSize.height() / 18));
+    painter.setFont(font);
+    painter.setPen(Qt::black);
+    painter.drawText(QRect(0, 0, frameSize.width(), frameSize.height() / 4),
+                     Qt::AlignCenter,
+                     QString("%1  #%2").arg(frontFacing ? "FRONT" : "BACK").arg(frameIndex));
+    painter.end();
+
+    frameIndex++;
+    deliver(std::move(frame), clock.nsecsElapsed() / 1000);
+}
@@ -0,0 +1,41 @@
+//
+// TestPatternSource - 合成测试图案帧来源
+// Iteration 4: 在独立线程中按帧率生成彩条 + 移动方块 + 帧号，
+//              没有相机的环境（CI、无头测试）也能走完整的录制流程
+//
+
+#ifndef TEST_PATTERN_SOURCE_H
+#define TEST_PATTERN_SOURCE_H
+
+#include "frame_source.h"
+#include <QElapsedTimer>
+#include <QThread>
+#include <QTimer>
+
+class TestPatternSource : public FrameSource {
+    Q_OBJECT
+
+private:
+    bool frontFacing;
+    QThread* thread;
+    QTimer* timer;              // 属于工作线程
+
+    // 以下只在工作线程中访问
+    QSize frameSize;
+    QImage background;          // 预先绘制的彩条，每帧复制一次
+    qint64 frameIndex;
+    QElapsedTimer clock;
+
+    void renderBackground();
+    void generateFrame();
+
+public:
+    explicit TestPatternSource(bool frontFacing, QObject* parent = nullptr);
+    ~TestPatternSource();
+
+    QString name() const override;
+    bool start(const QSize& size, int framesPerSecond) override;
+    void stop() override;
+};
+
+#endif // TEST_PATTERN_SOURCE_H
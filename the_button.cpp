@@ -16,7 +16,10 @@ TheButton::TheButton(QWidget* parent)
     isHovered(false),
     infoOverlay(nullptr),
     titleLabel(nullptr),
-    durationLabel(nullptr) {
+    durationLabel(nullptr),
+    previewLabel(nullptr),
+    previewTimer(nullptr),
+    previewFrame(0) {
 
     // 设置图标大小（默认值）
     setIconSize(QSize(200, 110));
@@ -36,6 +39,9 @@ TheButton::TheButton(QWidget* parent)
     // 设置动画
     setupAnimation();
 
+    // 悬停预览（先创建，保证在信息覆盖层下面）
+    setupPreview();
+
     // 设置信息覆盖层
     setupInfoOverlay();
 
@@ -44,6 +50,7 @@ TheButton::TheButton(QWidget* parent)
 }
 
 void TheButton::init(TheButtonInfo* i) {
+    stopPreview();
     info = i;
 
     if (info && info->icon) {
@@ -59,6 +66,9 @@ void TheButton::init(TheButtonInfo* i) {
         if (info->fileSize > 0) {
             tooltip += "\n" + tr("Size: ") + formatFileSize(info->fileSize);
         }
+        if (info->hasProblem()) {
+            tooltip += "\n" + tr("Warning: ") + info->problem;
+        }
 
         setToolTip(tooltip);
         setAccessibleName(info->title.isEmpty() ?
@@ -74,6 +84,11 @@ void TheButton::init(TheButtonInfo* i) {
             durationLabel->setVisible(true);
         }
     }
+
+    // 后台预先生成悬停预览；已有磁盘缓存的只检查文件是否存在，悬停时再读取
+    if (info && info->url) {
+        HoverPreviewManager::getInstance()->requestPreview(*info->url);
+    }
 }
 
 void TheButton::setupAnimation() {
@@ -82,6 +97,63 @@ void TheButton::setupAnimation() {
     hoverAnimation->setEasingCurve(QEasingCurve::InOutQuad);
 }
 
+void TheButton::setupPreview() {
+    previewLabel = new QLabel(this);
+    previewLabel->setScaledContents(true);
+    previewLabel->setAttribute(Qt::WA_TransparentForMouseEvents);
+    previewLabel->hide();
+
+    previewTimer = new QTimer(this);
+    connect(previewTimer, &QTimer::timeout, this, &TheButton::showNextPreviewFrame);
+
+    connect(HoverPreviewManager::getInstance(), &HoverPreviewManager::previewReady,
+            this, &TheButton::onPreviewReady);
+}
+
+void TheButton::startPreview() {
+    if (!info || !info->url) return;
+
+    HoverPreviewManager* manager = HoverPreviewManager::getInstance();
+    preview = manager->getPreview(*info->url);
+    if (!preview.isValid()) {
+        // 不在内存中：有磁盘缓存时立即读入，否则插队生成；就绪后若仍在悬停则开始播放
+        manager->requestPreview(*info->url, true);
+        return;
+    }
+
+    // 覆盖图标区域（与按钮 padding 一致）
+    previewLabel->setGeometry(4, 4, width() - 8, height() - 8);
+    previewFrame = 0;
+    showNextPreviewFrame();
+    previewLabel->show();
+    previewTimer->start(preview.frameIntervalMs);
+}
+
+void TheButton::stopPreview() {
+    if (previewTimer) {
+        previewTimer->stop();
+    }
+    if (previewLabel) {
+        previewLabel->hide();
+        previewLabel->clear();
+    }
+    preview = HoverPreview();
+}
+
+void TheButton::showNextPreviewFrame() {
+    if (!preview.isValid()) return;
+
+    // 帧只有几 KB，逐帧解码比常驻解码后的图片更省内存
+    previewLabel->setPixmap(QPixmap::fromImage(preview.frameAt(previewFrame)));
+    previewFrame = (previewFrame + 1) % preview.frameCount();
+}
+
+void TheButton::onPreviewReady(const QUrl& url) {
+    if (isHovered && info && info->url && *info->url == url && !previewTimer->isActive()) {
+        startPreview();
+    }
+}
+
 void TheButton::setupInfoOverlay() {
     // 创建覆盖层容器
     infoOverlay = new QLabel(this);
@@ -171,6 +243,8 @@ void TheButton::applyStyles() {
 }
 
 void TheButton::updateSize(int width, int height) {
+    if (size() == QSize(width, height)) return;
+
     setIconSize(QSize(width - 8, height - 8));
     setFixedSize(width, height);
 
@@ -206,6 +280,9 @@ void TheButton::enterEvent(QEvent* event) {
     if (infoOverlay && info && !info->title.isEmpty()) {
         infoOverlay->show();
     }
+
+    // 播放预览循环
+    startPreview();
 }
 
 void TheButton::leaveEvent(QEvent* event) {
@@ -224,6 +301,8 @@ void TheButton::leaveEvent(QEvent* event) {
     if (infoOverlay) {
         infoOverlay->hide();
     }
+
+    stopPreview();
 }
 
 void TheButton::focusInEvent(QFocusEvent* event) {
@@ -242,6 +321,9 @@ void TheButton::resizeEvent(QResizeEvent* event) {
     if (infoOverlay) {
         infoOverlay->setGeometry(0, 0, width(), height());
     }
+    if (previewLabel) {
+        previewLabel->setGeometry(4, 4, width() - 8, height() - 8);
+    }
 }
 
 void TheButton::setHoverOpacity(qreal opacity) {
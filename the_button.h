@@ -14,6 +14,9 @@
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QResizeEvent>
+#include <QTimer>
+#include <QVector>
+#include "hover_preview_manager.h"
 
 class TheButtonInfo {
 public:
@@ -22,12 +25,16 @@ public:
     QString title;      // 视频标题
     qint64 duration;    // 视频时长（毫秒）
     qint64 fileSize;    // 文件大小（字节）
+    QVector<qint64> keyframesMs;   // 关键帧时间表（MP4/MOV 扫描时解析）
+    QString problem;    // 扫描时发现的截断/损坏，为空表示正常
 
     // 构造函数
     TheButtonInfo(QUrl* url, QIcon* icon, QString title = "",
                   qint64 duration = 0, qint64 fileSize = 0)
         : url(url), icon(icon), title(title),
         duration(duration), fileSize(fileSize) {}
+
+    bool hasProblem() const { return !problem.isEmpty(); }
 };
 
 class TheButton : public QPushButton {
@@ -45,8 +52,17 @@ private:
     QLabel* titleLabel;
     QLabel* durationLabel;
 
+    // 悬停预览循环（在信息覆盖层下方逐帧播放）
+    QLabel* previewLabel;
+    QTimer* previewTimer;
+    HoverPreview preview;
+    int previewFrame;
+
     void setupAnimation();
     void setupInfoOverlay();
+    void setupPreview();
+    void startPreview();
+    void stopPreview();
     void applyStyles();
     void updateSize(int width, int height);
     QString formatDuration(qint64 milliseconds) const;
@@ -77,6 +93,8 @@ public:
 
 private slots:
     void clicked();
+    void showNextPreviewFrame();
+    void onPreviewReady(const QUrl& url);
 
 signals:
     void jumpTo(TheButtonInfo*);
@@ -4,7 +4,12 @@
 
 #include "the_player.h"
 #include "playback_controls.h"
+#include "trickplay_manager.h"
+#include "playback_rate_controller.h"
+#include "proxy_transcoder.h"
+#include "media_session_pool.h"
 #include <QDebug>
+#include <QSettings>
 
 ThePlayer::ThePlayer(QWidget* parent)
     : QMediaPlayer(parent),
@@ -14,11 +19,21 @@ ThePlayer::ThePlayer(QWidget* parent)
     currentVideoIndex(0),
     autoRepeat(true),
     shuffleEnabled(false),
-    updateCount(0) {
+    updateCount(0),
+    hiddenPolicy(loadHiddenPolicy()),
+    outputVisible(true),
+    resumeWhenVisible(false),
+    restartWhenVisible(false),
+    videoDetached(false) {
 
     // 设置默认音量
     setVolume(70);
 
+    // 倍速控制（丢帧统计 + 自动降速）
+    rateController = new PlaybackRateController(this, this);
+    connect(rateController, &PlaybackRateController::rateAdjusted,
+            this, &ThePlayer::onRateAdjusted);
+
     // 连接内部信号
     connect(this, &QMediaPlayer::stateChanged,
             this, &ThePlayer::playStateChanged);
@@ -28,6 +43,8 @@ ThePlayer::ThePlayer(QWidget* parent)
             this, &ThePlayer::onDurationChanged);
     connect(this, QOverload<QMediaPlayer::Error>::of(&QMediaPlayer::error),
             this, &ThePlayer::onError);
+    connect(this, &QMediaPlayer::currentMediaChanged,
+            this, &ThePlayer::onCurrentMediaChanged);
 
     // 创建shuffle计时器（默认禁用）
     shuffleTimer = new QTimer(this);
@@ -39,6 +56,14 @@ void ThePlayer::setContent(std::vector<TheButton*>* b, std::vector<TheButtonInfo
     buttons = b;
     infos = i;
 
+    // 后台为整个视频库生成拖动预览图，并为超出解码预算的文件生成播放代理
+    for (const TheButtonInfo& info : *infos) {
+        if (info.url) {
+            TrickplayManager::getInstance()->requestSheet(*info.url);
+            ProxyTranscoder::getInstance()->request(*info.url);
+        }
+    }
+
     if (!buttons->empty() && !infos->empty()) {
         // 播放第一个视频
         jumpToIndex(0);
@@ -62,6 +87,8 @@ void ThePlayer::setControls(PlaybackControls* ctrl) {
                 this, &ThePlayer::seekToPosition);
         connect(controls, &PlaybackControls::volumeChanged,
                 this, &ThePlayer::changeVolume);
+        connect(controls, &PlaybackControls::playbackSpeedChanged,
+                this, &ThePlayer::setPlaybackRate);
 
         // 初始化控制栏状态
         controls->setVolume(volume());
@@ -119,10 +146,14 @@ void ThePlayer::playStateChanged(QMediaPlayer::State ms) {
         }
         emit playbackStateChanged(false);
 
-        // 如果启用了自动重复,重新播放
+        // 如果启用了自动重复,重新播放；没人在看时等画面可见再重播
         if (autoRepeat) {
-            setPosition(0);
-            play();
+            if (!outputVisible && hiddenPolicy == PauseWhenHidden) {
+                restartWhenVisible = true;
+            } else {
+                setPosition(0);
+                play();
+            }
         }
         break;
     }
@@ -141,6 +172,84 @@ void ThePlayer::onDurationChanged(qint64 duration) {
     qDebug() << "Video duration:" << duration << "ms";
 }
 
+void ThePlayer::onCurrentMediaChanged(const QMediaContent& media) {
+    // 同时覆盖视频库和社交帖子两种播放来源；播放代理时预览图仍按原文件生成
+    if (controls) {
+        QUrl url = media.request().url();
+        if (!currentSource.isEmpty() &&
+            url == ProxyTranscoder::getInstance()->playbackUrl(currentSource)) {
+            url = currentSource;
+        }
+        controls->setPreviewSource(url);
+    }
+}
+
+// 原文件超出解码预算且代理已生成时，自动改为播放代理。
+// 视频库和社交帖子都在这一条常驻管线上重新加载，不经过会话池；
+// 加载耗时交给会话池单独计时，不算作复用
+void ThePlayer::playSource(const QUrl& source) {
+    currentSource = source;
+    QUrl target = ProxyTranscoder::getInstance()->playbackUrl(source);
+
+    MediaSessionPool::getInstance()->trackResident(this, target);
+    setMedia(target);
+
+    if (outputVisible || hiddenPolicy == AudioOnlyWhenHidden) {
+        play();
+    } else {
+        resumeWhenVisible = true;
+    }
+}
+
+ThePlayer::HiddenPolicy ThePlayer::loadHiddenPolicy() {
+    QSettings settings("Tomeo", "PlaybackSettings");
+    return settings.value("keepAudioWhenHidden", false).toBool() ?
+               AudioOnlyWhenHidden : PauseWhenHidden;
+}
+
+void ThePlayer::saveHiddenPolicy(HiddenPolicy policy) {
+    QSettings settings("Tomeo", "PlaybackSettings");
+    settings.setValue("keepAudioWhenHidden", policy == AudioOnlyWhenHidden);
+}
+
+// 暂停的管线保持已加载状态，恢复时不需要重新打开文件
+void ThePlayer::setOutputVisible(bool visible) {
+    if (visible == outputVisible) return;
+    outputVisible = visible;
+
+    if (!visible) {
+        if (state() != QMediaPlayer::PlayingState) return;
+
+        if (hiddenPolicy == PauseWhenHidden) {
+            resumeWhenVisible = true;
+            pause();
+            qDebug() << "Playback suspended: output not visible";
+        } else {
+            videoDetached = true;
+            emit videoOutputWanted(false);
+            qDebug() << "Video output detached, audio continues";
+        }
+        return;
+    }
+
+    if (videoDetached) {
+        videoDetached = false;
+        emit videoOutputWanted(true);
+    }
+
+    if (restartWhenVisible) {
+        setPosition(0);
+        play();
+    } else if (resumeWhenVisible) {
+        play();
+    }
+    if (restartWhenVisible || resumeWhenVisible) {
+        qDebug() << "Playback resumed: output visible";
+    }
+    resumeWhenVisible = false;
+    restartWhenVisible = false;
+}
+
 void ThePlayer::onError(QMediaPlayer::Error error) {
     qDebug() << "Player error:" << errorString();
     qDebug() << "Error code:" << error;
@@ -163,8 +272,7 @@ void ThePlayer::jumpTo(TheButtonInfo* button) {
     }
 
     // 设置媒体并播放
-    setMedia(*button->url);
-    play();
+    playSource(*button->url);
 
     emit videoChanged(currentVideoIndex);
 }
@@ -180,13 +288,16 @@ void ThePlayer::jumpToIndex(int index) {
 
     qDebug() << "Jumping to index:" << index;
 
-    setMedia(*info->url);
-    play();
+    playSource(*info->url);
 
     emit videoChanged(currentVideoIndex);
 }
 
 void ThePlayer::togglePlayPause() {
+    // 用户操作优先于自动恢复
+    resumeWhenVisible = false;
+    restartWhenVisible = false;
+
     if (state() == QMediaPlayer::PlayingState) {
         pause();
         qDebug() << "Paused";
@@ -256,6 +367,14 @@ void ThePlayer::toggleMute() {
 }
 
 void ThePlayer::setPlaybackRate(qreal rate) {
-    QMediaPlayer::setPlaybackRate(rate);
+    rateController->setRequestedRate(rate);
     qDebug() << "Playback rate set to:" << rate;
 }
+
+void ThePlayer::onRateAdjusted(qreal requested, qreal effective) {
+    qDebug() << "Playback rate limited from" << requested << "to" << effective;
+
+    if (controls) {
+        controls->setEffectiveSpeed(requested, effective);
+    }
+}
@@ -12,21 +12,39 @@
 #include "the_button.h"
 
 class PlaybackControls;
+class PlaybackRateController;
 
 class ThePlayer : public QMediaPlayer {
     Q_OBJECT
 
+public:
+    // 画面不可见时的处理方式
+    enum HiddenPolicy {
+        PauseWhenHidden,        // 暂停，解码完全停止
+        AudioOnlyWhenHidden     // 继续播放声音，摘下视频输出
+    };
+
 private:
     std::vector<TheButtonInfo>* infos;
     std::vector<TheButton*>* buttons;
     QTimer* shuffleTimer;
     PlaybackControls* controls;
+    PlaybackRateController* rateController;
+
+    QUrl currentSource;   // 原始文件；实际播放的可能是代理
 
     int currentVideoIndex;
     bool autoRepeat;
     bool shuffleEnabled;
     long updateCount;
 
+    // 可见性：不可见时暂停或只保留音频，重新可见时立即恢复
+    HiddenPolicy hiddenPolicy;
+    bool outputVisible;
+    bool resumeWhenVisible;      // 因不可见而暂停
+    bool restartWhenVisible;     // 不可见时播完，等可见时再重播
+    bool videoDetached;          // 只保留音频时已摘下视频输出
+
 public:
     explicit ThePlayer(QWidget* parent = nullptr);
 
@@ -38,20 +56,34 @@ public:
     int getCurrentIndex() const { return currentVideoIndex; }
     bool isAutoRepeat() const { return autoRepeat; }
     bool isShuffleEnabled() const { return shuffleEnabled; }
+    PlaybackRateController* getRateController() const { return rateController; }
 
     // 配置
     void setAutoRepeat(bool enable) { autoRepeat = enable; }
     void setShuffleEnabled(bool enable);
 
+    // 策略保存在 QSettings("Tomeo", "PlaybackSettings")
+    static HiddenPolicy loadHiddenPolicy();
+    static void saveHiddenPolicy(HiddenPolicy policy);
+    void setHiddenPolicy(HiddenPolicy policy) { hiddenPolicy = policy; }
+    HiddenPolicy getHiddenPolicy() const { return hiddenPolicy; }
+
+    // 由界面根据窗口/页面/控件状态调用
+    void setOutputVisible(bool visible);
+    bool isOutputVisible() const { return outputVisible; }
+
 private slots:
     void shuffle();
     void playStateChanged(QMediaPlayer::State ms);
     void onPositionChanged(qint64 position);
     void onDurationChanged(qint64 duration);
+    void onCurrentMediaChanged(const QMediaContent& media);
+    void onRateAdjusted(qreal requested, qreal effective);
     void onError(QMediaPlayer::Error error);
 
 public slots:
     // 播放控制
+    void playSource(const QUrl& source);
     void jumpTo(TheButtonInfo* button);
     void jumpToIndex(int index);
     void togglePlayPause();
@@ -72,6 +104,8 @@ public slots:
 signals:
     void videoChanged(int index);
     void playbackStateChanged(bool playing);
+    // AudioOnlyWhenHidden 下请求摘下（false）或恢复（true）视频输出
+    void videoOutputWanted(bool wanted);
 };
 
 #endif // THE_PLAYER_H
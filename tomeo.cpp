@@ -1,4 +1,5 @@
 #include <QApplication>
+#include <QDebug>
 #include <QDir>
 #include <QDirIterator>
 #include <QFileInfo>
@@ -8,9 +9,16 @@
 
 #include "main_container.h"
 #include "the_button.h"
+#include "mp4_parser.h"
 #include "theme_manager.h"
 #include "language_manager.h"
 #include "social_manager.h"
+#include "startup_profiler.h"
+#include "mock_social_service.h"
+#include "http_social_data_source.h"
+#include "mutation_queue.h"
+#include "color_filter.h"
+#include "search_index.h"
 
 // 辅助函数: 扫描目录获取视频
 std::vector<TheButtonInfo> getInfoIn(std::string loc) {
@@ -19,6 +27,10 @@ std::vector<TheButtonInfo> getInfoIn(std::string loc) {
 
     if (!dir.exists()) return out;
 
+    // 大桌面上缩略图最宽 220 像素（16:9），按屏幕像素密度放大
+    qreal dpr = qApp ? qApp->devicePixelRatio() : 1.0;
+    QSize maxIconSize = QSize(220, 124) * dpr;
+
     QDirIterator it(dir);
     while (it.hasNext()) {
         QString f = it.next();
@@ -32,12 +44,31 @@ std::vector<TheButtonInfo> getInfoIn(std::string loc) {
 
             QString thumb = f.left(f.length() - 4) + ".png";
             if (QFile(thumb).exists()) {
-                QImageReader* imageReader = new QImageReader(thumb);
-                QImage sprite = imageReader->read();
+                // 按网格最大显示尺寸解码，不在图标里保留原图
+                QImageReader imageReader(thumb);
+                QSize iconSize = imageReader.size();
+                if (iconSize.isValid() && (iconSize.width() > maxIconSize.width() ||
+                                           iconSize.height() > maxIconSize.height())) {
+                    imageReader.setScaledSize(iconSize.scaled(maxIconSize, Qt::KeepAspectRatio));
+                }
+                QImage sprite = imageReader.read();
                 if (!sprite.isNull()) {
                     QIcon* ico = new QIcon(QPixmap::fromImage(sprite));
                     QUrl* url = new QUrl(QUrl::fromLocalFile(f));
-                    out.push_back(TheButtonInfo(url, ico, fileInfo.baseName(), 0, fileInfo.size()));
+                    TheButtonInfo info(url, ico, fileInfo.baseName(), 0, fileInfo.size());
+
+                    // MP4/MOV 直接解析容器，无需打开 QMediaPlayer
+                    if (Mp4Parser::isCandidate(f)) {
+                        Mp4Info media = Mp4Parser::parseFile(f);
+                        info.duration = media.durationMs;
+                        info.keyframesMs = media.keyframesMs;
+                        if (media.status != Mp4Info::Ok) {
+                            info.problem = media.problem;
+                            qDebug() << "Scan found a damaged video:" << fileInfo.fileName()
+                                     << "-" << media.problem;
+                        }
+                    }
+                    out.push_back(info);
                 }
             }
         }
@@ -46,35 +77,108 @@ std::vector<TheButtonInfo> getInfoIn(std::string loc) {
 }
 
 int main(int argc, char* argv[]) {
+    // --mock-social-server[=port]: 只运行本地模拟社交服务，不启动界面
+    if (MockSocialServer::isServerMode(argc, argv)) {
+        return MockSocialServer::runStandalone(argc, argv);
+    }
+
+    // --benchmark-filters[=WxH]: 测量各调色滤镜每帧耗时后退出
+    if (ColorFilter::isBenchmarkMode(argc, argv)) {
+        return ColorFilter::runBenchmark(argc, argv);
+    }
+
+    // --check-media[=dir]: 解析目录中的 MP4/MOV 并打印结果后退出，默认 test_videos
+    if (Mp4Parser::isCheckMode(argc, argv)) {
+        return Mp4Parser::runCheck(argc, argv);
+    }
+
+    // --benchmark-search[=N]: 用 N 条合成帖子测量搜索索引的查询耗时后退出
+    if (SearchIndex::isBenchmarkMode(argc, argv)) {
+        return SearchIndex::runBenchmark(argc, argv);
+    }
+
+    // --profile-startup: 记录启动各阶段耗时，首帧绘制后写出 trace 并退出
+    StartupProfiler::enableFromArguments(argc, argv);
+
+    // OpenGL 视频输出需要与多媒体后端共享上下文才能零拷贝使用纹理
+    QCoreApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
+
+    StartupPhase appPhase("QApplication init");
     QApplication app(argc, argv);
     app.setApplicationName("Tomeo");
+    appPhase.finish();
 
     // 1. 初始化管理器
-    ThemeManager::getInstance();
-    SocialManager::getInstance();
+    {
+        StartupPhase phase("ThemeManager init");
+        ThemeManager::getInstance();
+    }
+    {
+        StartupPhase phase("SocialManager init");
+        SocialManager::getInstance();
+    }
 
-    // 2. 加载视频
-    QString videoPath = (argc == 2) ? QString::fromLocal8Bit(argv[1]) : QDir::currentPath() + "/videos";
+    // 2. 加载视频（忽略 -- 开头的选项，取第一个位置参数作为视频目录）
+    QString videoPath = QDir::currentPath() + "/videos";
+    bool videoPathGiven = false;
+    bool useMockSocial = false;
+    for (int i = 1; i < argc; i++) {
+        QString argument = QString::fromLocal8Bit(argv[i]);
+        if (argument == "--mock-social") {
+            useMockSocial = true;
+        } else if (!argument.startsWith("--") && !videoPathGiven) {
+            videoPath = argument;
+            videoPathGiven = true;
+        }
+    }
     if (videoPath.startsWith('"')) videoPath = videoPath.mid(1, videoPath.length() - 2);
 
+    StartupPhase scanPhase("getInfoIn");
     std::vector<TheButtonInfo> videos = getInfoIn(videoPath.toStdString());
+    scanPhase.finish();
+
+    // --mock-social: 使用带延迟/失败注入的进程内模拟服务代替内置数据
+    // --feed-url=<url>: 从 HTTP 服务分页加载（可指向 --mock-social-server）
+    QUrl feedUrl = HttpSocialDataSource::baseUrlFromArguments(argc, argv);
+    if (feedUrl.isValid() && !feedUrl.isEmpty()) {
+        SocialManager::getInstance()->setDataSource(new HttpSocialDataSource(feedUrl));
+    } else if (useMockSocial) {
+        SocialManager::getInstance()->setDataSource(
+            new MockSocialDataSource(MockSocialConfig::load()));
+    }
 
-    // 加载真实缩略图
-    SocialManager::getInstance()->loadRealThumbnails(videoPath);
+    // 离线队列在数据源就绪后创建：上次未上传的点赞/评论立即开始补传
+    {
+        StartupPhase phase("MutationQueue init");
+        MutationQueue::getInstance();
+    }
+
+    // 加载真实缩略图（后台解码，首页显示期间完成）
+    {
+        StartupPhase phase("loadRealThumbnails dispatch");
+        SocialManager::getInstance()->loadRealThumbnailsAsync(videoPath);
+    }
 
     // 3. 创建主窗口
+    StartupPhase windowPhase("MainContainer construction");
     MainContainer window(videos);
     window.setWindowTitle("Tomeo - Social Video Platform");
     window.setMinimumSize(375, 667);
     window.resize(450, 800);
+    window.setLibraryDirectory(videoPath);
+    windowPhase.finish();
 
     // 应用主题
-    window.setStyleSheet(ThemeManager::getInstance()->getApplicationStyleSheet());
+    {
+        StartupPhase phase("Application stylesheet");
+        window.setStyleSheet(ThemeManager::getInstance()->getApplicationStyleSheet());
+    }
 
     // 连接主题变更信号
     QObject::connect(ThemeManager::getInstance(), &ThemeManager::themeChanged,
                      &window, &MainContainer::updateTheme);
 
+    StartupProfiler::finishAfterFirstPaint(&window);
     window.show();
 
     return app.exec();
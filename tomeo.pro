@@ -1,4 +1,4 @@
-QT += core gui widgets multimedia multimediawidgets
+QT += core gui widgets multimedia multimediawidgets concurrent network
 
 CONFIG += c++11
 DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000
@@ -23,7 +23,37 @@ SOURCES += \
     share_dialog.cpp \
     bottom_navigation_bar.cpp \
     record_dialog.cpp \
-    main_container.cpp
+    main_container.cpp \
+    frame_grabber.cpp \
+    trickplay_manager.cpp \
+    playback_rate_controller.cpp \
+    gl_video_widget.cpp \
+    video_diagnostics_dialog.cpp \
+    startup_profiler.cpp \
+    search_index.cpp \
+    ranking_engine.cpp \
+    social_worker.cpp \
+    social_json.cpp \
+    mock_social_service.cpp \
+    http_social_data_source.cpp \
+    mutation_queue.cpp \
+    image_decode_pool.cpp \
+    inline_playback_pool.cpp \
+    hover_preview_manager.cpp \
+    proxy_transcoder.cpp \
+    mp4_parser.cpp \
+    media_session_pool.cpp \
+    memory_budget.cpp \
+    window_visibility_watcher.cpp \
+    frame_source.cpp \
+    test_pattern_source.cpp \
+    camera_frame_source.cpp \
+    frame_encoder.cpp \
+    recording_pipeline.cpp \
+    viewfinder_widget.cpp \
+    pip_compositor.cpp \
+    dual_camera_source.cpp \
+    color_filter.cpp
 
 HEADERS += \
     the_player.h \
@@ -44,10 +74,46 @@ HEADERS += \
     share_dialog.h \
     bottom_navigation_bar.h \
     record_dialog.h \
-    main_container.h
+    main_container.h \
+    frame_grabber.h \
+    trickplay_manager.h \
+    playback_rate_controller.h \
+    gl_video_widget.h \
+    video_diagnostics_dialog.h \
+    startup_profiler.h \
+    search_index.h \
+    ranking_engine.h \
+    social_worker.h \
+    social_json.h \
+    social_data_source.h \
+    mock_social_service.h \
+    http_social_data_source.h \
+    mutation_queue.h \
+    image_decode_pool.h \
+    inline_playback_pool.h \
+    hover_preview_manager.h \
+    proxy_transcoder.h \
+    mp4_parser.h \
+    media_session_pool.h \
+    memory_budget.h \
+    window_visibility_watcher.h \
+    frame_source.h \
+    test_pattern_source.h \
+    camera_frame_source.h \
+    frame_encoder.h \
+    recording_pipeline.h \
+    viewfinder_widget.h \
+    pip_compositor.h \
+    dual_camera_source.h \
+    color_filter.h \
+    color_filter_kernels.h
 
 INCLUDEPATH += .
 
+# 调色滤镜的 AVX2 内核单独以 AVX2 编译，运行时检测 CPU 后才会调用
+CONFIG += simd
+AVX2_SOURCES += color_filter_avx2.cpp
+
 TRANSLATIONS += \
     translations/tomeo_zh_CN.ts \
     translations/tomeo_es_ES.ts
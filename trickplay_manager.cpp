@@ -0,0 +1,239 @@
+//
+// TrickplayManager - 实现
+//
+
+#include "trickplay_manager.h"
+#include "frame_grabber.h"
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QPainter>
+#include <QStandardPaths>
+#include <QVector>
+#include <algorithm>
+
+TrickplayManager* TrickplayManager::instance = nullptr;
+
+QImage TrickplaySheet::tileAt(qint64 positionMs) const {
+    if (!isValid()) return QImage();
+
+    int index = static_cast<int>(positionMs / intervalMs);
+    index = qBound(0, index, tileCount - 1);
+
+    int row = index / columns;
+    int col = index % columns;
+    return sprite.copy(col * tileSize.width(), row * tileSize.height(),
+                       tileSize.width(), tileSize.height());
+}
+
+TrickplayManager::TrickplayManager(QObject* parent)
+    : QObject(parent),
+    useClock(0) {
+
+    cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/trickplay";
+    QDir().mkpath(cacheDir);
+
+    grabber = new FrameGrabber(this);
+    connect(grabber, &FrameGrabber::started,
+            this, &TrickplayManager::onGrabStarted);
+    connect(grabber, &FrameGrabber::frameReady,
+            this, &TrickplayManager::onFrameReady);
+    connect(grabber, &FrameGrabber::finished,
+            this, &TrickplayManager::onGrabFinished);
+
+    qDebug() << "TrickplayManager initialized, cache:" << cacheDir;
+
+    MemoryBudget::getInstance()->registerConsumer(this);
+}
+
+TrickplayManager* TrickplayManager::getInstance() {
+    if (instance == nullptr) {
+        instance = new TrickplayManager();
+    }
+    return instance;
+}
+
+// 缓存键包含路径、大小和修改时间，文件被替换后自动失效
+QString TrickplayManager::cacheKey(const QUrl& url) const {
+    QFileInfo info(url.toLocalFile());
+    QString source = QString("%1|%2|%3")
+                         .arg(info.absoluteFilePath())
+                         .arg(info.size())
+                         .arg(info.lastModified().toMSecsSinceEpoch());
+    return QString::fromLatin1(
+        QCryptographicHash::hash(source.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+QString TrickplayManager::cachePath(const QString& key) const {
+    return cacheDir + "/" + key + ".png";
+}
+
+// 元数据保存在 PNG 的文本块中，一个文件即可完整描述雪碧图
+bool TrickplayManager::loadFromDisk(const QString& key) {
+    QString path = cachePath(key);
+    if (!QFile::exists(path)) return false;
+
+    QImageReader reader(path);
+    QImage image = reader.read();
+    if (image.isNull()) return false;
+
+    TrickplaySheet sheet;
+    sheet.sprite = image;
+    sheet.tileSize = QSize(image.text("tileWidth").toInt(), image.text("tileHeight").toInt());
+    sheet.columns = image.text("columns").toInt();
+    sheet.tileCount = image.text("tileCount").toInt();
+    sheet.intervalMs = image.text("intervalMs").toLongLong();
+
+    if (!sheet.isValid() || sheet.tileSize.isEmpty()) {
+        qDebug() << "Discarding invalid trickplay cache:" << path;
+        QFile::remove(path);
+        return false;
+    }
+
+    storeSheet(key, sheet);
+    return true;
+}
+
+void TrickplayManager::saveToDisk(const QString& key, const TrickplaySheet& sheet) {
+    QImage image = sheet.sprite;
+    image.setText("tileWidth", QString::number(sheet.tileSize.width()));
+    image.setText("tileHeight", QString::number(sheet.tileSize.height()));
+    image.setText("columns", QString::number(sheet.columns));
+    image.setText("tileCount", QString::number(sheet.tileCount));
+    image.setText("intervalMs", QString::number(sheet.intervalMs));
+
+    if (!image.save(cachePath(key), "PNG")) {
+        qDebug() << "Failed to save trickplay sheet:" << cachePath(key);
+    }
+}
+
+void TrickplayManager::storeSheet(const QString& key, const TrickplaySheet& sheet) {
+    sheets.insert(key, sheet);
+    lastUsed.insert(key, ++useClock);
+    MemoryBudget::getInstance()->notifyGrowth();
+}
+
+// 磁盘上已有的雪碧图不在这里读入，第一次拖动时才加载
+void TrickplayManager::requestSheet(const QUrl& url, bool urgent) {
+    if (!url.isLocalFile() || hasSheet(url)) return;
+
+    if (url == activeUrl) return;
+
+    pending.removeAll(url);
+    if (urgent) {
+        pending.prepend(url);
+    } else {
+        pending.append(url);
+    }
+
+    startNext();
+}
+
+bool TrickplayManager::hasSheet(const QUrl& url) const {
+    if (!url.isLocalFile()) return false;
+
+    QString key = cacheKey(url);
+    return sheets.contains(key) || QFile::exists(cachePath(key));
+}
+
+TrickplaySheet TrickplayManager::getSheet(const QUrl& url) {
+    if (!url.isLocalFile()) return TrickplaySheet();
+
+    QString key = cacheKey(url);
+    auto it = sheets.constFind(key);
+    if (it != sheets.constEnd()) {
+        lastUsed.insert(key, ++useClock);
+        return it.value();
+    }
+
+    // 被内存预算淘汰过或尚未读入
+    if (loadFromDisk(key)) {
+        return sheets.value(key);
+    }
+    return TrickplaySheet();
+}
+
+qint64 TrickplayManager::memoryUsage() const {
+    qint64 total = 0;
+    for (const TrickplaySheet& sheet : sheets) {
+        total += sheet.sprite.sizeInBytes();
+    }
+    return total;
+}
+
+qint64 TrickplayManager::releaseMemory(qint64 bytes, EvictionPass pass) {
+    // 最久未用的在前
+    QVector<QPair<quint64, QString>> order;
+    order.reserve(sheets.size());
+    for (auto it = sheets.constBegin(); it != sheets.constEnd(); ++it) {
+        order.append(qMakePair(lastUsed.value(it.key()), it.key()));
+    }
+    std::sort(order.begin(), order.end());
+
+    // 控制栏每次拖动都重新取雪碧图，只有最近用过的那一张算在屏幕上
+    if (pass == Invisible && !order.isEmpty()) {
+        order.removeLast();
+    }
+
+    qint64 released = 0;
+    for (const auto& entry : order) {
+        if (released >= bytes) break;
+        released += sheets.take(entry.second).sprite.sizeInBytes();
+        lastUsed.remove(entry.second);
+    }
+    return released;
+}
+
+void TrickplayManager::startNext() {
+    if (grabber->isBusy() || pending.isEmpty()) return;
+
+    activeUrl = pending.takeFirst();
+    activeSheet = TrickplaySheet();
+
+    grabber->start(activeUrl, QSize(TileWidth, TileHeight), DefaultIntervalMs, MaxTiles);
+}
+
+void TrickplayManager::onGrabStarted(qint64 duration, qint64 intervalMs, int frameCount) {
+    Q_UNUSED(duration);
+
+    int rows = (frameCount + Columns - 1) / Columns;
+    activeSheet.tileSize = QSize(TileWidth, TileHeight);
+    activeSheet.columns = Columns;
+    activeSheet.tileCount = frameCount;
+    activeSheet.intervalMs = intervalMs;
+    activeSheet.sprite = QImage(Columns * TileWidth, rows * TileHeight, QImage::Format_RGB32);
+    activeSheet.sprite.fill(Qt::black);
+}
+
+void TrickplayManager::onFrameReady(int index, const QImage& frame) {
+    if (activeSheet.sprite.isNull()) return;
+
+    // 居中绘制，保留原始宽高比
+    int row = index / Columns;
+    int col = index % Columns;
+    QPoint origin(col * TileWidth + (TileWidth - frame.width()) / 2,
+                  row * TileHeight + (TileHeight - frame.height()) / 2);
+
+    QPainter painter(&activeSheet.sprite);
+    painter.drawImage(origin, frame);
+}
+
+void TrickplayManager::onGrabFinished(bool ok) {
+    if (ok && activeSheet.isValid()) {
+        QString key = cacheKey(activeUrl);
+        storeSheet(key, activeSheet);
+        saveToDisk(key, activeSheet);
+
+        qDebug() << "Trickplay sheet ready:" << activeUrl.fileName()
+                 << activeSheet.tileCount << "tiles";
+        emit sheetReady(activeUrl);
+    }
+
+    activeUrl = QUrl();
+    activeSheet = TrickplaySheet();
+    startNext();
+}
@@ -0,0 +1,93 @@
+//
+// TrickplayManager - 拖动预览缩略图（雪碧图）管理器
+// Iteration 4: 后台按固定间隔抽帧，按视频持久化到磁盘缓存，拖动时才读入内存
+//
+
+#ifndef TRICKPLAY_MANAGER_H
+#define TRICKPLAY_MANAGER_H
+
+#include <QObject>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QUrl>
+#include "memory_budget.h"
+
+class FrameGrabber;
+
+// 一段视频的预览雪碧图
+struct TrickplaySheet {
+    QImage sprite;       // 按行排列的所有预览帧
+    QSize tileSize;      // 单帧尺寸
+    int columns;         // 每行帧数
+    int tileCount;       // 总帧数
+    qint64 intervalMs;   // 帧间隔（毫秒）
+
+    TrickplaySheet()
+        : columns(0), tileCount(0), intervalMs(0) {}
+
+    bool isValid() const {
+        return !sprite.isNull() && tileCount > 0 && columns > 0 && intervalMs > 0;
+    }
+
+    // 返回覆盖该时间点的预览帧
+    QImage tileAt(qint64 positionMs) const;
+};
+
+class TrickplayManager : public QObject, public MemoryConsumer {
+    Q_OBJECT
+
+private:
+    static TrickplayManager* instance;
+
+    FrameGrabber* grabber;
+    QHash<QString, TrickplaySheet> sheets;   // 缓存键 -> 雪碧图（按需从磁盘读入）
+    QHash<QString, quint64> lastUsed;        // 缓存键 -> 最近使用的序号
+    quint64 useClock;
+    QList<QUrl> pending;                     // 等待生成的视频
+    QString cacheDir;
+
+    // 正在生成的雪碧图
+    QUrl activeUrl;
+    TrickplaySheet activeSheet;
+
+    explicit TrickplayManager(QObject* parent = nullptr);
+
+    QString cacheKey(const QUrl& url) const;
+    QString cachePath(const QString& key) const;
+    bool loadFromDisk(const QString& key);
+    void saveToDisk(const QString& key, const TrickplaySheet& sheet);
+    void storeSheet(const QString& key, const TrickplaySheet& sheet);
+    void startNext();
+
+public:
+    // 单例模式
+    static TrickplayManager* getInstance();
+
+    // 预览帧参数
+    static const int TileWidth = 160;
+    static const int TileHeight = 90;
+    static const int Columns = 10;
+    static const int DefaultIntervalMs = 2000;
+    static const int MaxTiles = 120;
+
+    // 请求生成；urgent 为 true 时插队到队首
+    void requestSheet(const QUrl& url, bool urgent = false);
+    bool hasSheet(const QUrl& url) const;
+    TrickplaySheet getSheet(const QUrl& url);
+
+    // MemoryConsumer：磁盘上都有缓存，只保留最近拖动过的视频的雪碧图
+    QString memoryName() const override { return "trickplay sheets"; }
+    qint64 memoryUsage() const override;
+    qint64 releaseMemory(qint64 bytes, EvictionPass pass) override;
+
+private slots:
+    void onGrabStarted(qint64 duration, qint64 intervalMs, int frameCount);
+    void onFrameReady(int index, const QImage& frame);
+    void onGrabFinished(bool ok);
+
+signals:
+    void sheetReady(const QUrl& url);
+};
+
+#endif // TRICKPLAY_MANAGER_H
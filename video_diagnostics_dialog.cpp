@@ -0,0 +1,238 @@
+//
+// VideoDiagnosticsDialog - 实现
+//
+
+#include "video_diagnostics_dialog.h"
+#include "the_player.h"
+#include "playback_rate_controller.h"
+#include "media_session_pool.h"
+#include "memory_budget.h"
+#include "design_system.h"
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+
+VideoDiagnosticsDialog::VideoDiagnosticsDialog(ThePlayer* p, GLVideoWidget* gl,
+                                               VideoOutput::Mode mode, QWidget* parent)
+    : QDialog(parent),
+    player(p),
+    glOutput(gl),
+    outputMode(mode) {
+
+    setWindowTitle(tr("Video Diagnostics"));
+    setMinimumWidth(360);
+
+    setupUI();
+    connectSignals();
+    applyStyles();
+
+    // 非模态面板，定时刷新计数
+    refreshTimer = new QTimer(this);
+    refreshTimer->setInterval(500);
+    connect(refreshTimer, &QTimer::timeout, this, &VideoDiagnosticsDialog::refresh);
+    refreshTimer->start();
+
+    refresh();
+}
+
+void VideoDiagnosticsDialog::setupUI() {
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setSpacing(DesignSystem::Dimensions::SpacingMedium);
+    mainLayout->setContentsMargins(
+        DesignSystem::Dimensions::SpacingLarge,
+        DesignSystem::Dimensions::SpacingLarge,
+        DesignSystem::Dimensions::SpacingLarge,
+        DesignSystem::Dimensions::SpacingLarge
+        );
+
+    // === 输出帧统计 ===
+    QGroupBox* outputGroup = new QGroupBox(tr("Video Output"), this);
+    QFormLayout* outputLayout = new QFormLayout(outputGroup);
+
+    outputLabel = new QLabel(outputGroup);
+    decodedLabel = new QLabel(outputGroup);
+    presentedLabel = new QLabel(outputGroup);
+    droppedLabel = new QLabel(outputGroup);
+    zeroCopyLabel = new QLabel(outputGroup);
+
+    outputLayout->addRow(tr("Output:"), outputLabel);
+    outputLayout->addRow(tr("Decoded frames:"), decodedLabel);
+    outputLayout->addRow(tr("Presented frames:"), presentedLabel);
+    outputLayout->addRow(tr("Dropped frames:"), droppedLabel);
+    outputLayout->addRow(tr("Zero-copy frames:"), zeroCopyLabel);
+
+    mainLayout->addWidget(outputGroup);
+
+    // === 倍速统计 ===
+    QGroupBox* rateGroup = new QGroupBox(tr("Playback Rate"), this);
+    QVBoxLayout* rateLayout = new QVBoxLayout(rateGroup);
+
+    rateLabel = new QLabel(rateGroup);
+    rateLayout->addWidget(rateLabel);
+
+    rateStatsLabel = new QLabel(rateGroup);
+    rateStatsLabel->setFont(DesignSystem::Typography::getCaption());
+    rateStatsLabel->setTextFormat(Qt::PlainText);
+    rateLayout->addWidget(rateStatsLabel);
+
+    mainLayout->addWidget(rateGroup);
+
+    // === 媒体会话 ===
+    QGroupBox* sessionGroup = new QGroupBox(tr("Media Sessions"), this);
+    QVBoxLayout* sessionLayout = new QVBoxLayout(sessionGroup);
+
+    sessionLabel = new QLabel(sessionGroup);
+    sessionLayout->addWidget(sessionLabel);
+
+    sessionStatsLabel = new QLabel(sessionGroup);
+    sessionStatsLabel->setFont(DesignSystem::Typography::getCaption());
+    sessionStatsLabel->setTextFormat(Qt::PlainText);
+    sessionLayout->addWidget(sessionStatsLabel);
+
+    mainLayout->addWidget(sessionGroup);
+
+    // === 缓存内存 ===
+    QGroupBox* memoryGroup = new QGroupBox(tr("Cache Memory"), this);
+    QVBoxLayout* memoryLayout = new QVBoxLayout(memoryGroup);
+
+    memoryLabel = new QLabel(memoryGroup);
+    memoryLabel->setFont(DesignSystem::Typography::getCaption());
+    memoryLabel->setTextFormat(Qt::PlainText);
+    memoryLayout->addWidget(memoryLabel);
+
+    mainLayout->addWidget(memoryGroup);
+    mainLayout->addStretch();
+
+    // === 底部按钮 ===
+    QWidget* buttonWidget = new QWidget(this);
+    QHBoxLayout* buttonLayout = new QHBoxLayout(buttonWidget);
+    buttonLayout->setContentsMargins(0, 0, 0, 0);
+    buttonLayout->addStretch();
+
+    resetButton = new QPushButton(tr("Reset"), buttonWidget);
+    resetButton->setMinimumWidth(DesignSystem::Dimensions::ButtonMinWidth);
+    buttonLayout->addWidget(resetButton);
+
+    closeButton = new QPushButton(tr("Close"), buttonWidget);
+    closeButton->setMinimumWidth(DesignSystem::Dimensions::ButtonMinWidth);
+    buttonLayout->addWidget(closeButton);
+
+    mainLayout->addWidget(buttonWidget);
+}
+
+void VideoDiagnosticsDialog::connectSignals() {
+    connect(resetButton, &QPushButton::clicked,
+            this, &VideoDiagnosticsDialog::onResetClicked);
+    connect(closeButton, &QPushButton::clicked,
+            this, &QDialog::close);
+}
+
+void VideoDiagnosticsDialog::applyStyles() {
+    setStyleSheet(QString(R"(
+        QDialog {
+            background-color: %1;
+        }
+        QGroupBox {
+            background-color: %2;
+            border: 1px solid %3;
+            border-radius: %4px;
+            margin-top: 12px;
+            padding-top: 12px;
+            font-weight: bold;
+            color: %5;
+        }
+        QLabel {
+            color: %5;
+        }
+    )").arg(DesignSystem::Colors::getBackground().name())
+                      .arg(DesignSystem::Colors::getSurface().name())
+                      .arg(DesignSystem::Colors::getBorder().name())
+                      .arg(DesignSystem::Dimensions::BorderRadius)
+                      .arg(DesignSystem::Colors::getTextPrimary().name()));
+}
+
+void VideoDiagnosticsDialog::setOutputMode(VideoOutput::Mode mode) {
+    outputMode = mode;
+    refresh();
+}
+
+void VideoDiagnosticsDialog::refresh() {
+    if (outputMode == VideoOutput::OpenGL && glOutput) {
+        VideoOutputStats stats = glOutput->getStats();
+        outputLabel->setText(tr("OpenGL"));
+        decodedLabel->setText(QString::number(stats.framesDecoded));
+        presentedLabel->setText(QString::number(stats.framesPresented));
+        droppedLabel->setText(QString::number(stats.framesDropped));
+        zeroCopyLabel->setText(QString::number(stats.zeroCopyFrames));
+    } else {
+        // QVideoWidget 不暴露帧计数
+        outputLabel->setText(tr("Standard (QVideoWidget)"));
+        decodedLabel->setText(tr("n/a"));
+        presentedLabel->setText(tr("n/a"));
+        droppedLabel->setText(tr("n/a"));
+        zeroCopyLabel->setText(tr("n/a"));
+    }
+
+    refreshSessions();
+    memoryLabel->setText(MemoryBudget::getInstance()->report());
+
+    PlaybackRateController* rates = player ? player->getRateController() : nullptr;
+    if (!rates) return;
+
+    rateLabel->setText(tr("Requested %1x, effective %2x")
+                           .arg(rates->getRequestedRate())
+                           .arg(rates->getEffectiveRate()));
+
+    if (!rates->isMeasuring()) {
+        rateStatsLabel->setText(tr("Frame probe not supported by this backend"));
+        return;
+    }
+
+    QStringList lines;
+    QMap<qreal, RateStats> stats = rates->getStats();
+    for (auto it = stats.constBegin(); it != stats.constEnd(); ++it) {
+        lines << tr("%1x: %2 presented, %3 dropped (%4%)")
+                     .arg(it.key())
+                     .arg(it.value().framesPresented)
+                     .arg(it.value().framesDropped)
+                     .arg(it.value().dropRatio() * 100.0, 0, 'f', 1);
+    }
+    rateStatsLabel->setText(lines.isEmpty() ? tr("No frames measured yet") : lines.join("\n"));
+}
+
+void VideoDiagnosticsDialog::refreshSessions() {
+    MediaSessionPool* sessions = MediaSessionPool::getInstance();
+    SessionStats total = sessions->totals();
+
+    sessionLabel->setText(tr("%1 created, %2 reused, %3 idle, ~%4 ms saved; "
+                             "main player: %5 reloads on its own pipeline, avg %6 ms")
+                              .arg(total.created)
+                              .arg(total.reused)
+                              .arg(sessions->idleCount())
+                              .arg(sessions->totalSavedMs())
+                              .arg(total.residentLoads)
+                              .arg(total.averageResidentMs()));
+
+    QStringList lines;
+    QMap<QString, SessionStats> stats = sessions->getStats();
+    for (auto it = stats.constBegin(); it != stats.constEnd(); ++it) {
+        lines << tr("%1: load %2 ms fresh / %3 ms reused / %4 ms main player (%5 / %6 / %7 loads)")
+                     .arg(it.key())
+                     .arg(it.value().averageFreshMs())
+                     .arg(it.value().averageReusedMs())
+                     .arg(it.value().averageResidentMs())
+                     .arg(it.value().freshLoads)
+                     .arg(it.value().reusedLoads)
+                     .arg(it.value().residentLoads);
+    }
+    sessionStatsLabel->setText(lines.isEmpty() ? tr("No media loaded yet") : lines.join("\n"));
+}
+
+void VideoDiagnosticsDialog::onResetClicked() {
+    if (glOutput) {
+        glOutput->resetStats();
+    }
+    MediaSessionPool::getInstance()->resetStats();
+    refresh();
+}
@@ -0,0 +1,57 @@
+//
+// VideoDiagnosticsDialog - 视频诊断面板
+// Iteration 4: 显示当前视频输出方式、解码/显示/丢帧计数、各倍速的丢帧统计、媒体会话复用情况和缓存内存占用
+//
+
+#ifndef VIDEO_DIAGNOSTICS_DIALOG_H
+#define VIDEO_DIAGNOSTICS_DIALOG_H
+
+#include <QDialog>
+#include <QLabel>
+#include <QPushButton>
+#include <QTimer>
+#include "gl_video_widget.h"
+
+class ThePlayer;
+
+class VideoDiagnosticsDialog : public QDialog {
+    Q_OBJECT
+
+private:
+    ThePlayer* player;
+    GLVideoWidget* glOutput;
+    VideoOutput::Mode outputMode;
+
+    // UI组件
+    QLabel* outputLabel;
+    QLabel* decodedLabel;
+    QLabel* presentedLabel;
+    QLabel* droppedLabel;
+    QLabel* zeroCopyLabel;
+    QLabel* rateLabel;
+    QLabel* rateStatsLabel;
+    QLabel* sessionLabel;
+    QLabel* sessionStatsLabel;
+    QLabel* memoryLabel;
+    QPushButton* resetButton;
+    QPushButton* closeButton;
+
+    QTimer* refreshTimer;
+
+    void setupUI();
+    void connectSignals();
+    void applyStyles();
+    void refreshSessions();
+
+public:
+    VideoDiagnosticsDialog(ThePlayer* player, GLVideoWidget* glOutput,
+                           VideoOutput::Mode mode, QWidget* parent = nullptr);
+
+    void setOutputMode(VideoOutput::Mode mode);
+
+private slots:
+    void refresh();
+    void onResetClicked();
+};
+
+#endif // VIDEO_DIAGNOSTICS_DIALOG_H
@@ -5,6 +5,8 @@
 #include "video_post_card.h"
 #include "design_system.h"
 #include "social_manager.h"
+#include "mutation_queue.h"
+#include "image_decode_pool.h"
 #include <QDebug>
 
 VideoPostCard::VideoPostCard(const VideoPost& postData, QWidget* parent)
@@ -69,7 +71,6 @@ void VideoPostCard::setupUI() {
 
     videoThumbnail = new QLabel(videoWidget);
     videoThumbnail->setFixedHeight(300);
-    videoThumbnail->setScaledContents(true);
     videoThumbnail->setAlignment(Qt::AlignCenter);
     videoThumbnail->setStyleSheet("background-color: #424242; border-radius: 8px;");
 
@@ -161,6 +162,8 @@ void VideoPostCard::connectSignals() {
     connect(commentBtn, &QPushButton::clicked, this, &VideoPostCard::onCommentClicked);
     connect(shareBtn, &QPushButton::clicked, this, &VideoPostCard::onShareClicked);
     connect(moreBtn, &QPushButton::clicked, this, &VideoPostCard::onMoreClicked);
+    connect(ImageDecodePool::getInstance(), &ImageDecodePool::imageDecoded,
+            this, &VideoPostCard::onThumbnailDecoded);
 }
 
 void VideoPostCard::applyStyles() {
@@ -252,22 +255,7 @@ void VideoPostCard::updateUI() {
     updateLikeButton();
 
     // 🔥 显示视频缩略图
-    if (!post.thumbnail.isNull()) {
-        videoThumbnail->setPixmap(post.thumbnail);
-        qDebug() << "Set thumbnail for post:" << post.postId;
-    } else {
-        // 如果没有缩略图，显示默认图标
-        videoThumbnail->setText("📹");
-        videoThumbnail->setAlignment(Qt::AlignCenter);
-        videoThumbnail->setStyleSheet(QString(R"(
-            background-color: %1;
-            border-radius: 8px;
-            font-size: 48px;
-            color: %2;
-        )").arg(DesignSystem::Colors::getCardBackground().name())
-                                          .arg(DesignSystem::Colors::getTextSecondary().name()));
-        qDebug() << "No thumbnail for post:" << post.postId;
-    }
+    updateThumbnail();
 
     // 显示BeReal标记
     if (post.isBeRealMoment) {
@@ -277,6 +265,65 @@ void VideoPostCard::updateUI() {
     }
 }
 
+// 缩略图按显示尺寸（乘以设备像素比）解码，绘制时不再缩放
+QSize VideoPostCard::thumbnailDisplaySize() const {
+    QMargins margins = layout()->contentsMargins();
+    return QSize(width() - margins.left() - margins.right(), videoThumbnail->height());
+}
+
+void VideoPostCard::updateThumbnail() {
+    pendingThumbnailKey.clear();
+    QSize displaySize = thumbnailDisplaySize();
+    qreal dpr = devicePixelRatioF();
+    QPixmap pixmap;
+
+    if (!post.thumbnailPath.isEmpty()) {
+        ImageDecodePool* pool = ImageDecodePool::getInstance();
+        if (!pool->fetch(post.thumbnailPath, displaySize, dpr, &pixmap)) {
+            // 解码完成前显示占位，完成后在 onThumbnailDecoded 中替换
+            pendingThumbnailKey = ImageDecodePool::cacheKey(post.thumbnailPath, displaySize, dpr);
+            showThumbnailPlaceholder("📹");
+            return;
+        }
+    }
+
+    if (pixmap.isNull()) {
+        // 如果没有缩略图，显示默认图标
+        showThumbnailPlaceholder("📹");
+        qDebug() << "No thumbnail for post:" << post.postId;
+        return;
+    }
+
+    videoThumbnail->setStyleSheet("background-color: #424242; border-radius: 8px;");
+    videoThumbnail->setPixmap(pixmap);
+    qDebug() << "Set thumbnail for post:" << post.postId;
+}
+
+void VideoPostCard::showThumbnailPlaceholder(const QString& text) {
+    videoThumbnail->setText(text);
+    videoThumbnail->setAlignment(Qt::AlignCenter);
+    videoThumbnail->setStyleSheet(QString(R"(
+        background-color: %1;
+        border-radius: 8px;
+        font-size: 48px;
+        color: %2;
+    )").arg(DesignSystem::Colors::getCardBackground().name())
+                                      .arg(DesignSystem::Colors::getTextSecondary().name()));
+}
+
+void VideoPostCard::onThumbnailDecoded(const QString& key, const QPixmap& pixmap) {
+    if (key != pendingThumbnailKey) return;
+    pendingThumbnailKey.clear();
+
+    if (pixmap.isNull()) {
+        qDebug() << "No thumbnail for post:" << post.postId;
+        return;
+    }
+
+    videoThumbnail->setStyleSheet("background-color: #424242; border-radius: 8px;");
+    videoThumbnail->setPixmap(pixmap);
+}
+
 void VideoPostCard::updateLikeButton() {
     if (post.isLiked) {
         likeBtn->setText("❤️");
@@ -319,10 +366,10 @@ void VideoPostCard::onLikeClicked() {
 
     if (post.isLiked) {
         post.likesCount++;
-        SocialManager::getInstance()->likePost(post.postId);
+        MutationQueue::getInstance()->likePost(post.postId);
     } else {
         post.likesCount--;
-        SocialManager::getInstance()->unlikePost(post.postId);
+        MutationQueue::getInstance()->unlikePost(post.postId);
     }
 
     updateLikeButton();
@@ -0,0 +1,84 @@
+//
+// VideoPostCard - 视频帖子卡片
+// Iteration 3: 显示作者、缩略图、互动按钮和标题
+// Iteration 4: 缩略图在后台按显示尺寸解码，完成前显示占位
+//
+
+#ifndef VIDEO_POST_CARD_H
+#define VIDEO_POST_CARD_H
+
+#include <QFrame>
+#include <QLabel>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include "social_types.h"
+
+class VideoPostCard : public QFrame {
+    Q_OBJECT
+
+private:
+    VideoPost post;
+
+    // 顶部：用户信息
+    QLabel* avatarLabel;
+    QLabel* usernameLabel;
+    QLabel* timeLabel;
+    QPushButton* moreBtn;
+
+    // 中间：视频缩略图
+    QLabel* videoThumbnail;
+    QPushButton* playBtn;
+    QLabel* beRealBadge;
+    QString pendingThumbnailKey;   // 等待解码完成的缓存 key
+
+    // 互动按钮栏
+    QPushButton* likeBtn;
+    QLabel* likesLabel;
+    QPushButton* commentBtn;
+    QLabel* commentsLabel;
+    QPushButton* shareBtn;
+    QLabel* viewsLabel;
+
+    // 底部：标题
+    QLabel* captionLabel;
+
+    void setupUI();
+    void connectSignals();
+    void applyStyles();
+    void updateUI();
+    void updateLikeButton();
+    void updateThumbnail();
+    void showThumbnailPlaceholder(const QString& text);
+    QSize thumbnailDisplaySize() const;
+
+protected:
+    void enterEvent(QEvent* event) override;
+    void leaveEvent(QEvent* event) override;
+
+public:
+    explicit VideoPostCard(const VideoPost& post, QWidget* parent = nullptr);
+
+    void setPost(const VideoPost& post);
+    const VideoPost& getPost() const { return post; }
+
+    // 内联预览的视频输出挂在缩略图区域上
+    QWidget* inlineVideoHost() const { return videoThumbnail; }
+    void updateTheme();
+
+private slots:
+    void onPlayClicked();
+    void onLikeClicked();
+    void onCommentClicked();
+    void onShareClicked();
+    void onMoreClicked();
+    void onThumbnailDecoded(const QString& key, const QPixmap& pixmap);
+
+signals:
+    void playRequested(const VideoPost& post);
+    void likeToggled(const QString& postId, bool isLiked);
+    void commentRequested(const QString& postId);
+    void shareRequested(const QString& postId);
+};
+
+#endif // VIDEO_POST_CARD_H
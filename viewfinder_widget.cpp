@@ -0,0 +1,41 @@
+//
+// ViewfinderWidget - 实现
+//
+
+#include "viewfinder_widget.h"
+#include <QPainter>
+
+ViewfinderWidget::ViewfinderWidget(QWidget* parent)
+    : QLabel(parent) {
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+void ViewfinderWidget::setFrame(const QImage& image) {
+    frame = image;
+    update();
+}
+
+void ViewfinderWidget::clearFrame() {
+    frame = QImage();
+    update();
+}
+
+void ViewfinderWidget::paintEvent(QPaintEvent* event) {
+    if (frame.isNull()) {
+        // 不透明绘制：先自己铺黑底，再让 QLabel 画提示文字
+        QPainter painter(this);
+        painter.fillRect(rect(), Qt::black);
+        painter.end();
+        QLabel::paintEvent(event);
+        return;
+    }
+
+    // 按比例居中，两侧留黑
+    QSize target = frame.size().scaled(size(), Qt::KeepAspectRatio);
+    QRect area(QPoint((width() - target.width()) / 2, (height() - target.height()) / 2), target);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::black);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter.drawImage(area, frame);
+}
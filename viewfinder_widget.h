@@ -0,0 +1,32 @@
+//
+// ViewfinderWidget - 录制取景器
+// Iteration 4: 直接用 QPainter 绘制管线送来的 QImage（与编码器共享同一份像素），
+//              不转换为 QPixmap；没有画面时显示 QLabel 文字
+//
+
+#ifndef VIEWFINDER_WIDGET_H
+#define VIEWFINDER_WIDGET_H
+
+#include <QLabel>
+#include <QImage>
+
+class ViewfinderWidget : public QLabel {
+    Q_OBJECT
+
+private:
+    QImage frame;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+public:
+    explicit ViewfinderWidget(QWidget* parent = nullptr);
+
+    bool hasFrame() const { return !frame.isNull(); }
+
+public slots:
+    void setFrame(const QImage& frame);
+    void clearFrame();
+};
+
+#endif // VIEWFINDER_WIDGET_H
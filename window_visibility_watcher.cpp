@@ -0,0 +1,53 @@
+//
+// WindowVisibilityWatcher - 实现
+//
+
+#include "window_visibility_watcher.h"
+#include <QDebug>
+#include <QEvent>
+
+WindowVisibilityWatcher::WindowVisibilityWatcher(QWidget* widget)
+    : QObject(widget),
+    topLevel(widget->window()),
+    presented(false) {
+
+    topLevel->installEventFilter(this);
+    watchHandle();
+    update();
+}
+
+void WindowVisibilityWatcher::watchHandle() {
+    if (handle || !topLevel) return;
+
+    handle = topLevel->windowHandle();
+    if (handle) {
+        handle->installEventFilter(this);
+    }
+}
+
+void WindowVisibilityWatcher::update() {
+    bool now = topLevel && topLevel->isVisible() && !topLevel->isMinimized() &&
+               (!handle || handle->isExposed());
+    if (now == presented) return;
+
+    presented = now;
+    qDebug() << "Window" << (presented ? "presented" : "not visible");
+    emit presentedChanged(presented);
+}
+
+bool WindowVisibilityWatcher::eventFilter(QObject* watched, QEvent* event) {
+    switch (event->type()) {
+    case QEvent::Show:
+        if (watched == topLevel) watchHandle();
+        update();
+        break;
+    case QEvent::Hide:
+    case QEvent::WindowStateChange:
+    case QEvent::Expose:
+        update();
+        break;
+    default:
+        break;
+    }
+    return QObject::eventFilter(watched, event);
+}
@@ -0,0 +1,40 @@
+//
+// WindowVisibilityWatcher - 顶层窗口可见性监视
+// Iteration 4: 合并最小化、隐藏和窗口暴露（被完全遮挡时平台会取消暴露）事件，
+//              画面真正不可见时通知播放组件暂停解码
+//
+
+#ifndef WINDOW_VISIBILITY_WATCHER_H
+#define WINDOW_VISIBILITY_WATCHER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QWidget>
+#include <QWindow>
+
+class WindowVisibilityWatcher : public QObject {
+    Q_OBJECT
+
+private:
+    QPointer<QWidget> topLevel;
+    QPointer<QWindow> handle;   // 第一次显示后才有原生窗口
+    bool presented;
+
+    void watchHandle();
+    void update();
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+public:
+    // 监视 widget 所在的顶层窗口
+    explicit WindowVisibilityWatcher(QWidget* widget);
+
+    // 窗口已显示、未最小化且有区域暴露在屏幕上
+    bool isPresented() const { return presented; }
+
+signals:
+    void presentedChanged(bool presented);
+};
+
+#endif // WINDOW_VISIBILITY_WATCHER_H